@@ -610,5 +610,15 @@ int32_t CellularDataClient::GetActiveApnName(std::string &apnName)
     }
     return proxy->GetActiveApnName(apnName);
 }
+
+int32_t CellularDataClient::GetConnectionTrafficInfo(int32_t slotId, std::vector<ConnectionTrafficInfo> &infoList)
+{
+    sptr<ICellularDataManager> proxy = GetProxy();
+    if (proxy == nullptr) {
+        TELEPHONY_LOGE("proxy is null");
+        return TELEPHONY_ERR_IPC_CONNECT_STUB_FAIL;
+    }
+    return proxy->GetConnectionTrafficInfo(slotId, infoList);
+}
 } // namespace Telephony
 } // namespace OHOS
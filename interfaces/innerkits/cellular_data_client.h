@@ -335,6 +335,15 @@ public:
      */
     int32_t GetActiveApnName(std::string &apnName);
 
+    /**
+     * @brief Get the packet and byte counters of every active data connection
+     *
+     * @param slotId Card slot identification.
+     * @param infoList Counters of each connection, with its apn type and interface.
+     * @return 0 get success, others get fail
+     */
+    int32_t GetConnectionTrafficInfo(int32_t slotId, std::vector<ConnectionTrafficInfo> &infoList);
+
 private:
     class CellularDataDeathRecipient : public IRemoteObject::DeathRecipient {
     public:
@@ -169,6 +169,77 @@ struct ApnInfo : public Parcelable {
         return true;
     };
 };
+
+struct ConnectionTrafficInfo : public Parcelable {
+    std::string apnType = "";
+    std::string ifaceName = "";
+    int32_t cid = 0;
+    int64_t txPackets = 0;
+    int64_t rxPackets = 0;
+    int64_t txBytes = 0;
+    int64_t rxBytes = 0;
+
+    bool Marshalling(Parcel &parcel) const
+    {
+        if (!parcel.WriteString(apnType)) {
+            return false;
+        }
+        if (!parcel.WriteString(ifaceName)) {
+            return false;
+        }
+        if (!parcel.WriteInt32(cid)) {
+            return false;
+        }
+        if (!parcel.WriteInt64(txPackets)) {
+            return false;
+        }
+        if (!parcel.WriteInt64(rxPackets)) {
+            return false;
+        }
+        if (!parcel.WriteInt64(txBytes)) {
+            return false;
+        }
+        if (!parcel.WriteInt64(rxBytes)) {
+            return false;
+        }
+        return true;
+    };
+
+    static ConnectionTrafficInfo* Unmarshalling(Parcel &parcel)
+    {
+        std::unique_ptr<ConnectionTrafficInfo> param = std::make_unique<ConnectionTrafficInfo>();
+        if (!param->ReadFromParcel(parcel)) {
+            return nullptr;
+        }
+        return param.release();
+    };
+
+    bool ReadFromParcel(Parcel &parcel)
+    {
+        if (!parcel.ReadString(apnType)) {
+            return false;
+        }
+        if (!parcel.ReadString(ifaceName)) {
+            return false;
+        }
+        if (!parcel.ReadInt32(cid)) {
+            return false;
+        }
+        if (!parcel.ReadInt64(txPackets)) {
+            return false;
+        }
+        if (!parcel.ReadInt64(rxPackets)) {
+            return false;
+        }
+        if (!parcel.ReadInt64(txBytes)) {
+            return false;
+        }
+        if (!parcel.ReadInt64(rxBytes)) {
+            return false;
+        }
+        return true;
+    };
+};
 } // namespace Telephony
 } // namespace OHOS
 #endif // CELLULAR_DATA_TYPES_H
\ No newline at end of file
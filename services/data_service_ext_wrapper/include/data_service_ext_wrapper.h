@@ -18,6 +18,8 @@
 
 #include "singleton.h"
 
+#include "lazy_symbol.h"
+
 namespace OHOS {
 namespace Telephony {
 class DataServiceExtWrapper final {
@@ -26,13 +28,15 @@ DECLARE_DELAYED_REF_SINGLETON(DataServiceExtWrapper);
 public:
     DISALLOW_COPY_AND_MOVE(DataServiceExtWrapper);
     void InitDataServiceExtWrapper();
+    void DumpSymbolStats(std::string &result) const;
 
     typedef void (*REQUEST_TCP_AND_DNS_PACKETS)();
 
-    REQUEST_TCP_AND_DNS_PACKETS requestTcpAndDnsPackets_ = nullptr;
+    LazySymbol<REQUEST_TCP_AND_DNS_PACKETS> requestTcpAndDnsPackets_;
 
 private:
     void* DataServiceExtWrapperHandle_ = nullptr;
+    LazySymbolStats symbolStats_;
 };
 
 #define DATA_SERVICE_EXT_WRAPPER ::OHOS::DelayedRefSingleton<DataServiceExtWrapper>::GetInstance()
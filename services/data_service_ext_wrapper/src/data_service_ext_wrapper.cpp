@@ -44,14 +44,14 @@ void DataServiceExtWrapper::InitDataServiceExtWrapper()
         return;
     }
 
-    requestTcpAndDnsPackets_ = (REQUEST_TCP_AND_DNS_PACKETS)dlsym(DataServiceExtWrapperHandle_,
-        "SendTcpPktCollecToKernel");
-    // Check whether all function pointers are empty.
-    if (requestTcpAndDnsPackets_ == nullptr) {
-        TELEPHONY_LOGE("data service ext wrapper symbol failed, error: %{public}s", dlerror());
-        return;
-    }
+    // Resolved on first use, the packet collection is only requested by the stall detection.
+    requestTcpAndDnsPackets_.Bind(DataServiceExtWrapperHandle_, "SendTcpPktCollecToKernel", &symbolStats_);
     TELEPHONY_LOGI("data service ext wrapper init success");
 }
+
+void DataServiceExtWrapper::DumpSymbolStats(std::string &result) const
+{
+    symbolStats_.Dump("DataServiceExtWrapper", result);
+}
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APN_ACTIVATE_STATS_H
+#define APN_ACTIVATE_STATS_H
+
+#include <array>
+#include <cstdint>
+
+#include "apn_item.h"
+
+namespace OHOS {
+namespace Telephony {
+const uint32_t KEEP_APN_ACTIVATE_PERIOD = 30 * 1000;
+static constexpr size_t APN_ACTIVATE_BUCKET_NUM = 30;
+static constexpr size_t APN_ACTIVATE_CAUSE_NUM = 8;
+static constexpr uint32_t APN_ACTIVATE_STATS_APN_NUM = DATA_CONTEXT_ROLE_SNSSAI6_ID + 1;
+
+/**
+ * Sliding window statistics of apn activations
+ *
+ * The window is split into APN_ACTIVATE_BUCKET_NUM time buckets per apn id, running sums of the live buckets are
+ * kept so that recording and reporting never scan the history nor allocate. Failure causes are tracked in a fixed
+ * size table, when more than APN_ACTIVATE_CAUSE_NUM distinct causes are seen the least frequent one is replaced.
+ */
+class ApnActivateStats {
+public:
+    ApnActivateStats();
+    ~ApnActivateStats() = default;
+    void SetKeepPeriod(uint32_t keepPeriodMs);
+    uint32_t GetKeepPeriod() const;
+    void Record(const ApnActivateInfo &info);
+    ApnActivateReportInfo GetReportInfo(uint32_t apnId, int64_t nowMs);
+    void Clear();
+
+private:
+    struct CauseCount {
+        uint32_t reason = 0;
+        uint32_t count = 0;
+    };
+
+    struct ActivateBucket {
+        int64_t epoch = -1;
+        uint32_t actTimes = 0;
+        uint32_t actSuccTimes = 0;
+        uint64_t totalDuration = 0;
+        std::array<CauseCount, APN_ACTIVATE_CAUSE_NUM> causes {};
+    };
+
+    struct ApnWindow {
+        std::array<ActivateBucket, APN_ACTIVATE_BUCKET_NUM> buckets {};
+        uint32_t actTimes = 0;
+        uint32_t actSuccTimes = 0;
+        uint64_t totalDuration = 0;
+        std::array<CauseCount, APN_ACTIVATE_CAUSE_NUM> causes {};
+    };
+
+    void Expire(ApnWindow &window, int64_t nowMs);
+    static void AddCause(std::array<CauseCount, APN_ACTIVATE_CAUSE_NUM> &causes, uint32_t reason, uint32_t count);
+    static void RemoveCause(std::array<CauseCount, APN_ACTIVATE_CAUSE_NUM> &causes, uint32_t reason, uint32_t count);
+
+private:
+    uint32_t keepPeriodMs_ = KEEP_APN_ACTIVATE_PERIOD;
+    int64_t bucketWidthMs_ = 1;
+    std::array<ApnWindow, APN_ACTIVATE_STATS_APN_NUM> apnWindows_ {};
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // APN_ACTIVATE_STATS_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APN_CATALOG_H
+#define APN_CATALOG_H
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "apn_item.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr size_t APN_TYPE_BIT_NUM = 20;
+static constexpr size_t APN_TYPE_BUCKET_ALL = APN_TYPE_BIT_NUM;
+static constexpr size_t APN_TYPE_BUCKET_NUM = APN_TYPE_BIT_NUM + 1;
+
+/**
+ * Immutable index over the apn items of one database load
+ *
+ * Built once per load, items keep the database order (prefer apn first) inside every bucket. Each item is put in
+ * the bucket of every ApnTypes bit it can deal with, so a lookup by a known apn type returns the bucket as is.
+ */
+class ApnCatalog {
+public:
+    ApnCatalog() = default;
+    explicit ApnCatalog(std::vector<sptr<ApnItem>> apnItems);
+    ~ApnCatalog() = default;
+    const std::vector<sptr<ApnItem>> &GetAllApnItem() const;
+    sptr<ApnItem> GetApnItemById(int32_t profileId) const;
+    std::vector<sptr<ApnItem>> GetApnItemsByType(const std::string &apnType) const;
+    sptr<ApnItem> GetFirstApnItemByType(const std::string &apnType) const;
+    sptr<ApnItem> GetAttachApnItem() const;
+    bool IsEmpty() const;
+
+private:
+    static bool GetTypeBucketIndex(const std::string &apnType, size_t &index);
+
+private:
+    std::vector<sptr<ApnItem>> apnItems_;
+    std::unordered_map<int32_t, sptr<ApnItem>> profileIdIndex_;
+    std::array<std::vector<sptr<ApnItem>>, APN_TYPE_BUCKET_NUM> typeBuckets_ {};
+    sptr<ApnItem> attachApnItem_ = nullptr;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // APN_CATALOG_H
@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "apn_string_pool.h"
 #include "cellular_data_constant.h"
 
 namespace OHOS {
@@ -36,6 +37,14 @@ struct ApnActivateReportInfo {
     uint32_t topReason;
     uint32_t actSuccTimes;
 };
+enum class ApnProtocolType : uint8_t {
+    PROTOCOL_NONE = 0,
+    PROTOCOL_IPV4,
+    PROTOCOL_IPV6,
+    PROTOCOL_IPV4V6,
+    PROTOCOL_OTHER
+};
+
 class ApnItem : public RefBase {
 public:
     ApnItem();
@@ -51,9 +60,24 @@ public:
     {
         return (newProp == oldProp) || (newProp.empty()) || (oldProp.empty());
     }
+    static uint32_t FindApnTypeMask(const std::string &apnType);
+    static ApnProtocolType ParseProtocol(const std::string &protocol);
+    static void ParseProxyAddress(const std::string &proxyIpAddress, std::string &host, uint16_t &port);
+    void UpdateDerivedFields();
+    uint32_t GetTypesMask() const;
+    ApnProtocolType GetProtocolType(bool roamingState) const;
+    const std::string &GetProxyHost() const;
+    uint16_t GetProxyPort() const;
+    uint64_t GetFingerprint() const;
+    bool HasSameProtocol(const ApnItem &other, bool roamingState) const;
+    bool HasCompatibleAttr(const ApnItem &other) const;
+    bool HasSameAttr(const ApnItem &other) const;
 
 private:
     static sptr<ApnItem> BuildOtherApnAttributes(sptr<ApnItem> &apnItem, const PdpProfile &apnData);
+    void SetApnTypes(const std::string &apnTypes);
+    static bool SetAttrString(ApnString &attr, const std::string &value);
+    static bool SetCredentialString(ApnString &attr, const std::string &value);
     static bool IsSimilarProtocol(const std::string &newProtocol, const std::string &oldProtocol);
 
 public:
@@ -80,11 +104,49 @@ public:
         char dnn_[ALL_APN_ITEM_CHAR_LENGTH] = { 0 };
         int32_t PduSessionType_ = 0;
         uint8_t RouteBitmap_ = 0;
+    };
+
+    /**
+     * In-memory form of Attribute, the string fields are handles into ApnStringPool
+     */
+    struct CompactAttribute {
+        ApnString types_;
+        ApnString numeric_;
+        int32_t profileId_ = 0;
+        ApnString protocol_;
+        ApnString roamingProtocol_;
+        int32_t authType_ = 0;
+        ApnString apn_;
+        ApnString apnName_;
+        ApnString user_;
+        ApnString password_;
+        bool isRoamingApn_ = false;
+        ApnString homeUrl_;
+        ApnString proxyIpAddress_;
+        ApnString mmsIpAddress_;
+        bool isEdited_ = false;
+        /* For networkslice*/
+        ApnString snssai_;
+        uint8_t sscMode_ = 0;
+        ApnString dnn_;
+        int32_t PduSessionType_ = 0;
+        uint8_t RouteBitmap_ = 0;
+
+        void ToAttribute(Attribute &attr) const;
     } attr_;
 
 private:
     std::vector<std::string> apnTypes_;
     bool badApn_ = false;
+    /* Derived from attr_ by UpdateDerivedFields */
+    uint32_t typesMask_ = 0;
+    bool isAllType_ = false;
+    ApnProtocolType protocolType_ = ApnProtocolType::PROTOCOL_NONE;
+    ApnProtocolType roamingProtocolType_ = ApnProtocolType::PROTOCOL_NONE;
+    std::string proxyHost_;
+    uint16_t proxyPort_ = 0;
+    uint64_t compatibleFingerprint_ = 0;
+    uint64_t fingerprint_ = 0;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -16,7 +16,9 @@
 #ifndef APN_MANAGER_H
 #define APN_MANAGER_H
 
+#include "apn_catalog.h"
 #include "apn_holder.h"
+#include "apn_snapshot_cache.h"
 #include "cellular_data_rdb_helper.h"
 
 namespace OHOS {
@@ -37,6 +39,11 @@ public:
     static NetManagerStandard::NetCap FindBestCapability(const uint64_t capabilities);
     bool IsDataConnectionNotUsed(const std::shared_ptr<CellularDataStateMachine> &stateMachine) const;
     int32_t CreateAllApnItemByDatabase(int32_t slotId, std::string &errMsg);
+    bool CreateExtApnItem(int32_t slotId, int32_t &count);
+    static bool LoadApnSnapshot(int32_t slotId, ApnSnapshot &snapshot, std::string &errMsg);
+    int32_t CreateAllApnItemBySnapshot(int32_t slotId, ApnSnapshot &snapshot);
+    void ClearApnItems();
+    void ResetPreferId();
     bool HasAnyConnectedState() const;
     ApnProfileState GetOverallApnState() const;
     ApnProfileState GetOverallDefaultApnState() const;
@@ -55,17 +62,26 @@ private:
     void AddApnHolder(const std::string &apnType, const int32_t priority);
     int32_t CreateMvnoApnItems(int32_t slotId, const std::string &mcc, const std::string &mnc);
     int32_t MakeSpecificApnItem(std::vector<PdpProfile> &apnVec, int32_t slotId);
-    void GetCTOperator(int32_t slotId, std::string &numeric);
+    static void GetCTOperator(int32_t slotId, std::string &numeric);
     void TryMergeSimilarPdpProfile(std::vector<PdpProfile> &apnVec);
     void MergePdpProfile(PdpProfile &newProfile, PdpProfile &oldProfile);
     bool GetPreferId(int32_t slotId, std::string &errMsg);
+    static bool QueryPreferId(int32_t slotId, int32_t &preferId, std::string &errMsg);
+    static bool GetApnQueryParam(int32_t slotId, const std::string &numeric, ApnQueryParam &param,
+        std::string &errMsg);
+    static void GetMvnoQueryParam(int32_t slotId, ApnQueryParam &param);
+    static bool QueryMvnoApnProfiles(int32_t slotId, const ApnQueryParam &param, std::vector<PdpProfile> &mvnoApnVec);
+    static bool QueryApnProfiles(int32_t slotId, const ApnQueryParam &param, ApnSnapshot &snapshot,
+        std::string &errMsg);
+    static void ValidateApnSnapshot(int32_t slotId, const ApnQueryParam &param, const ApnSnapshot &snapshot);
     int32_t PushApnItem(int32_t count, int32_t slotId, sptr<ApnItem> extraApnItem);
+    std::shared_ptr<const ApnCatalog> GetApnCatalog();
+    void UpdateApnCatalog(std::vector<sptr<ApnItem>> apnItems);
 
 private:
     static const std::map<std::string, int32_t> apnIdApnNameMap_;
-    static const std::map<std::string, ApnTypes> apnNameApnTypeMap_;
     static const std::vector<ApnProfileState> apnStateArr_;
-    std::vector<sptr<ApnItem>> allApnItem_;
+    std::shared_ptr<const ApnCatalog> apnCatalog_ = std::make_shared<const ApnCatalog>();
     std::vector<sptr<ApnHolder>> apnHolders_;
     std::map<int32_t, sptr<ApnHolder>> apnIdApnHolderMap_;
     std::vector<sptr<ApnHolder>> sortedApnHolders_;
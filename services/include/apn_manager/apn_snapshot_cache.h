@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APN_SNAPSHOT_CACHE_H
+#define APN_SNAPSHOT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cellular_data_constant.h"
+#include "event_handler.h"
+#include "pdp_profile_data.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int32_t APN_SNAPSHOT_SLOT_NUM = CELLDATA_SLOT_ID_3 + 1;
+
+/**
+ * Everything the resolved apn list of a slot depends on
+ */
+struct ApnQueryParam {
+    int32_t simId = -1;
+    std::string mcc;
+    std::string mnc;
+    std::string opkey;
+    std::string spn;
+    std::string imsi;
+    std::string gid1;
+    std::string iccId;
+};
+
+/**
+ * Resolved apn profiles of a slot, as they are fed to ApnManager::MakeSpecificApnItem
+ */
+struct ApnSnapshot {
+    int32_t preferId = -1;
+    std::vector<PdpProfile> profiles;
+};
+
+/**
+ * Persistent binary cache of the resolved apn profiles per slot
+ *
+ * Resolving the apn list takes up to six DataShare queries, which are slow on boot while the data ability is still
+ * starting. The last result is kept in a versioned file keyed by a hash of ApnQueryParam, so that the raw sim
+ * identifiers never reach the disk. Apn credentials are not stored either, a profile set with credentials is
+ * always read from the database. A snapshot is only a hint: it is validated against the database in the
+ * background and dropped whenever the apn tables change.
+ */
+class ApnSnapshotCache {
+public:
+    using StaleCallback = std::function<void()>;
+
+    static ApnSnapshotCache &GetInstance();
+    static uint64_t MakeKey(const ApnQueryParam &param);
+    static bool IsSameSnapshot(const ApnSnapshot &left, const ApnSnapshot &right);
+    static bool HasCredential(const ApnSnapshot &snapshot);
+    static void Serialize(uint64_t key, const ApnSnapshot &snapshot, std::string &buffer);
+    static bool Deserialize(const uint8_t *data, size_t size, uint64_t key, ApnSnapshot &snapshot);
+
+    bool Load(int32_t slotId, const ApnQueryParam &param, ApnSnapshot &snapshot);
+    bool Store(int32_t slotId, const ApnQueryParam &param, const ApnSnapshot &snapshot, uint64_t generation);
+    void Invalidate(int32_t slotId);
+    void InvalidateAll();
+    uint64_t GetGeneration(int32_t slotId) const;
+    bool PostValidateTask(const std::function<void()> &task);
+    void SetStaleCallback(int32_t slotId, const StaleCallback &callback);
+    void NotifyStale(int32_t slotId);
+    void SetSnapshotDir(const std::string &dir);
+
+private:
+    ApnSnapshotCache() = default;
+    ~ApnSnapshotCache() = default;
+    std::string GetSnapshotPath(int32_t slotId);
+    static bool IsValidSlotId(int32_t slotId);
+
+private:
+    std::mutex mutex_;
+    std::string snapshotDir_;
+    std::atomic<uint64_t> generation_[APN_SNAPSHOT_SLOT_NUM] {};
+    std::map<int32_t, StaleCallback> staleCallbacks_;
+    std::shared_ptr<AppExecFwk::EventHandler> validateHandler_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // APN_SNAPSHOT_CACHE_H
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APN_STRING_POOL_H
+#define APN_STRING_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace OHOS {
+namespace Telephony {
+static constexpr size_t APN_STRING_POOL_SWEEP_SIZE = 256;
+static constexpr size_t APN_STRING_POOL_MAX_SIZE = 4096;
+
+/**
+ * Handle of a string stored in ApnStringPool
+ *
+ * Apn attributes repeat the same few values (numeric, protocol, types...) across hundreds of profiles, so every
+ * distinct value is stored once and an ApnString only keeps a reference to it. It converts to const char * so that it
+ * can be used wherever the former char array attribute was.
+ */
+class ApnString {
+public:
+    ApnString() = default;
+    ApnString(const std::string &str);
+    ApnString(const char *str);
+    // Credentials are kept out of the pool, the value lives only as long as the items holding it.
+    static ApnString MakeUnpooled(const std::string &str);
+    operator const char *() const
+    {
+        return c_str();
+    }
+    const char *c_str() const
+    {
+        return str_ == nullptr ? "" : str_->c_str();
+    }
+    size_t length() const
+    {
+        return str_ == nullptr ? 0 : str_->length();
+    }
+    bool empty() const
+    {
+        return str_ == nullptr || str_->empty();
+    }
+    // Equal pooled values share one pool entry, so comparing the handles is comparing the strings.
+    bool IsSame(const ApnString &other) const
+    {
+        if (str_ == other.str_) {
+            return true;
+        }
+        if (str_ == nullptr || other.str_ == nullptr || (pooled_ && other.pooled_)) {
+            return false;
+        }
+        return *str_ == *other.str_;
+    }
+
+private:
+    std::shared_ptr<const std::string> str_ = nullptr;
+    bool pooled_ = true;
+};
+
+/**
+ * Intern table of apn attribute strings
+ *
+ * An entry is dropped by the next sweep once no ApnString refers to it any more. Sweeps run when the table has grown
+ * to twice its size after the last one or is full, a value which finds the table full of live entries is not pooled.
+ */
+class ApnStringPool {
+public:
+    static ApnStringPool &GetInstance();
+    std::shared_ptr<const std::string> Intern(const std::string &str, bool &pooled);
+    size_t GetStringCount();
+    size_t GetStringBytes();
+
+private:
+    ApnStringPool() = default;
+    ~ApnStringPool() = default;
+    void SweepLocked();
+    static size_t GetEntryBytes(const std::string &str);
+
+private:
+    std::mutex mutex_;
+    // The key views the string owned by the value, which lives as long as the entry.
+    std::unordered_map<std::string_view, std::shared_ptr<const std::string>> strings_;
+    size_t stringBytes_ = 0;
+    size_t sweepSize_ = APN_STRING_POOL_SWEEP_SIZE;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // APN_STRING_POOL_H
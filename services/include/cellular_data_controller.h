@@ -36,8 +36,10 @@ public:
     ApnProfileState GetCellularDataState(const std::string &apnType) const;
     int32_t IsCellularDataRoamingEnabled(bool &dataRoamingEnabled) const;
     void AsynchronousRegister();
+    void SetRegisteredCallback(const std::function<void(int32_t)> &callback);
     bool HandleApnChanged();
     int32_t GetCellularDataFlowType();
+    bool GetConnectionTrafficInfo(std::vector<ConnectionTrafficInfo> &infoList);
     void ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event);
     int32_t SetPolicyDataOn(bool enable);
     bool IsRestrictedMode() const;
@@ -59,11 +61,14 @@ public:
 private:
     void RegisterEvents();
     void UnRegisterEvents();
+    void NotifyRegistered();
 
 private:
     std::shared_ptr<CellularDataHandler> cellularDataHandler_;
     sptr<ISystemAbilityStatusChange> systemAbilityListener_ = nullptr;
     const int32_t slotId_;
+    std::mutex registeredCallbackMutex_;
+    std::function<void(int32_t)> registeredCallback_;
 
 private:
     class SystemAbilityStatusChangeListener : public OHOS::SystemAbilityStatusChangeStub {
@@ -28,6 +28,7 @@ public:
 private:
     void ShowHelp(std::string &result) const;
     void ShowCellularDataInfo(std::string &result) const;
+    void ShowPerfInfo(std::string &result) const;
     bool HasSimCard(const int32_t slotId) const;
 };
 } // namespace Telephony
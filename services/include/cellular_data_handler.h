@@ -16,12 +16,15 @@
 #ifndef CELLULAR_DATA_HANDLER_H
 #define CELLULAR_DATA_HANDLER_H
 
+#include "apn_activate_stats.h"
+#include "apn_snapshot_cache.h"
 #include "cellular_data_incall_observer.h"
 #include "cellular_data_rdb_observer.h"
 #include "cellular_data_roaming_observer.h"
 #include "cellular_data_setting_observer.h"
 #include "cellular_data_airplane_observer.h"
 #include "cellular_data_state_machine.h"
+#include "cellular_data_state_machine_pool.h"
 #include "data_switch_settings.h"
 #include "incall_data_state_machine.h"
 #include "radio_event.h"
@@ -31,10 +34,32 @@
 
 namespace OHOS {
 namespace Telephony {
-const uint32_t KEEP_APN_ACTIVATE_PERIOD = 30 * 1000;
 #ifdef BASE_POWER_IMPROVEMENT
 class CellularDataPowerSaveModeSubscriber;
 #endif
+static constexpr uint32_t APN_LOAD_FOR_SIM_ACCOUNT_LOADED = 1 << 0;
+static constexpr uint32_t APN_LOAD_FOR_RECORDS_CHANGED = 1 << 1;
+static constexpr uint32_t APN_LOAD_FOR_APN_CHANGED = 1 << 2;
+
+/**
+ * Apn profiles read by the io worker, handed back to the handler thread with MSG_APN_LOADED
+ */
+struct ApnLoadResult {
+    uint64_t generation = 0;
+    uint64_t apnIdGeneration = 0;
+    bool loaded = false;
+    ApnSnapshot snapshot;
+    std::string errMsg;
+};
+
+/**
+ * Prefer apn id read by the io worker after the prefer apn table changed
+ */
+struct CurrentApnIdResult {
+    uint64_t apnIdGeneration = 0;
+    int32_t apnId = 0;
+};
+
 class CellularDataHandler : public TelEventHandler, public CoreServiceCommonEventCallback {
 public:
     explicit CellularDataHandler(int32_t slotId);
@@ -65,6 +90,7 @@ public:
     bool HandleApnChanged();
     void HandleApnChanged(const AppExecFwk::InnerEvent::Pointer &event);
     int32_t GetCellularDataFlowType();
+    void GetConnectionTrafficInfo(std::vector<ConnectionTrafficInfo> &infoList);
     void SetPolicyDataOn(bool enable);
     bool IsRestrictedMode() const;
     DisConnectionReason GetDisConnectionReason();
@@ -98,6 +124,10 @@ public:
 private:
     std::shared_ptr<CellularDataStateMachine> CreateCellularDataConnect();
     std::shared_ptr<CellularDataStateMachine> FindIdleCellularDataConnection() const;
+    std::shared_ptr<CellularDataStateMachine> CreateInitializedCellularDataConnect();
+    std::shared_ptr<CellularDataStateMachine> AcquireCellularDataConnection();
+    void ReleaseCellularDataConnection(const std::shared_ptr<CellularDataStateMachine> &stateMachine);
+    void HandlePreWarmStateMachinePool(const AppExecFwk::InnerEvent::Pointer &event);
     bool CheckCellularDataSlotId(sptr<ApnHolder> &apnHolder);
     bool CheckAttachAndSimState(sptr<ApnHolder> &apnHolder);
     bool CheckRoamingState(sptr<ApnHolder> &apnHolder);
@@ -159,10 +189,11 @@ private:
     bool IsSingleConnectionEnabled(int32_t radioTech);
     void OnRilAdapterHostDied(const AppExecFwk::InnerEvent::Pointer &event);
     void HandleFactoryReset(const AppExecFwk::InnerEvent::Pointer &event);
+    void SendDataSwitchChangeInfo(bool userDataOn);
     void OnCleanAllDataConnectionsDone(const AppExecFwk::InnerEvent::Pointer &event);
     void ResumeDataPermittedTimerOut(const AppExecFwk::InnerEvent::Pointer &event);
     void HandleResidentNetworkChanged(const AppExecFwk::InnerEvent::Pointer &event);
-    void CreateApnItem();
+    void CreateApnItem(uint32_t reasons = 0);
     void UpdatePhysicalConnectionState(bool noActiveConnection);
     bool IsVSimSlotId(int32_t slotId);
     std::shared_ptr<CellularDataStateMachine> CheckForCompatibleDataConnection(sptr<ApnHolder> &apnHolder);
@@ -184,10 +215,13 @@ private:
     void RetryToSetupDatacall(const AppExecFwk::InnerEvent::Pointer &event);
     void RetryOrClearConnection(const sptr<ApnHolder> &apnHolder, DisConnectionReason reason,
         const std::shared_ptr<SetupDataCallResultInfo> &netInfo);
-    std::shared_ptr<DataShare::DataShareHelper> CreatorDataShareHelper();
-    bool GetCurrentDataShareApnInfo(std::shared_ptr<DataShare::DataShareHelper> dataShareHelper,
+    static std::shared_ptr<DataShare::DataShareHelper> CreatorDataShareHelper();
+    static bool GetCurrentDataShareApnInfo(std::shared_ptr<DataShare::DataShareHelper> dataShareHelper,
         const int32_t simId, int32_t &profileIdValue);
+    static void WriteApnInfo(const int32_t simId, const int32_t profileId);
     void UpdateApnInfo(const int32_t profileId);
+    void RefreshCurrentApnId();
+    void HandleCurrentApnIdLoaded(const AppExecFwk::InnerEvent::Pointer &event);
     int32_t GetCurrentApnId();
     bool WriteEventCellularRequest(NetRequest request, int32_t state);
     void DataConnCompleteUpdateState(const sptr<ApnHolder> &apnHolder,
@@ -197,14 +231,18 @@ private:
     int64_t GetCurTime();
     void SetApnActivateStart(const std::string &apnType);
     void SetApnActivateEnd(const std::shared_ptr<SetupDataCallResultInfo> &resultInfo);
-    void EraseApnActivateList();
     ApnActivateReportInfo GetApnActReportInfo(uint32_t apnId);
+    void InitApnActivateStats();
     bool IsBlockSetRilAttachApn();
+    void HandleApnLoaded(const AppExecFwk::InnerEvent::Pointer &event);
+    void FinishApnLoad(int32_t count, const std::string &errMsg);
+    void ContinueAfterApnLoad(uint32_t reasons);
 
 private:
     sptr<ApnManager> apnManager_;
     std::unique_ptr<DataSwitchSettings> dataSwitchSettings_;
     std::shared_ptr<DataConnectionManager> connectionManager_ = nullptr;
+    std::shared_ptr<CellularDataStateMachinePool> stateMachinePool_ = nullptr;
     std::u16string lastIccId_;
     std::string lastNumeric_;
     std::string lastMcc_;
@@ -228,7 +266,7 @@ private:
     bool isHandoverOccurred_ = false;
     bool isMccChanged_ = false;
     std::mutex mtx_;
-    std::mutex apnActivateListMutex_;
+    std::mutex apnActivateStatsMutex_;
     std::mutex initMutex_;
     std::vector<std::string> upLinkThresholds_;
     std::vector<std::string> downLinkThresholds_;
@@ -239,90 +277,22 @@ private:
     sptr<CellularDataAirplaneObserver> airplaneObserver_;
     std::shared_ptr<IncallDataStateMachine> incallDataStateMachine_;
     sptr<ApnItem> lastApnItem_ = nullptr;
-    std::vector<ApnActivateInfo> apnActivateChrList_;
+    ApnActivateStats apnActivateStats_;
     uint64_t defaultApnActTime_ = 0;
     uint64_t internalApnActTime_ = 0;
     int32_t retryCreateApnTimes_ = 0;
+    // Database results arrive asynchronously, a result whose generation is outdated is dropped.
+    uint64_t apnLoadGeneration_ = 0;
+    uint32_t pendingApnLoadReasons_ = 0;
+    int32_t currentApnId_ = 0;
+    uint64_t currentApnIdGeneration_ = 0;
 
-    using Fun = std::function<void(const AppExecFwk::InnerEvent::Pointer &event)>;
-    std::map<uint32_t, Fun> eventIdMap_ {
-        { RadioEvent::RADIO_PS_CONNECTION_ATTACHED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { RadioPsConnectionAttached(event); } },
-        { RadioEvent::RADIO_PS_ROAMING_OPEN,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { RoamingStateOn(event); } },
-        { RadioEvent::RADIO_PS_ROAMING_CLOSE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { RoamingStateOff(event); } },
-        { RadioEvent::RADIO_EMERGENCY_STATE_OPEN,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { PsRadioEmergencyStateOpen(event); } },
-        { RadioEvent::RADIO_EMERGENCY_STATE_CLOSE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { PsRadioEmergencyStateClose(event); } },
-        { CellularDataEventCode::MSG_ESTABLISH_DATA_CONNECTION_COMPLETE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { EstablishDataConnectionComplete(event); } },
-        { CellularDataEventCode::MSG_DISCONNECT_DATA_COMPLETE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { DisconnectDataComplete(event); } },
-        { CellularDataEventCode::MSG_ESTABLISH_DATA_CONNECTION,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { MsgEstablishDataConnection(event); } },
-        { CellularDataEventCode::MSG_SETTING_SWITCH,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleSettingSwitchChanged(event); } },
-        { CellularDataEventCode::MSG_REQUEST_NETWORK,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { MsgRequestNetwork(event); } },
-        { RadioEvent::RADIO_STATE_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleRadioStateChanged(event); } },
-        { RadioEvent::RADIO_DSDS_MODE_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleDsdsModeChanged(event); } },
-        { RadioEvent::RADIO_SIM_STATE_CHANGE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleSimEvent(event); } },
-        { RadioEvent::RADIO_SIM_RECORDS_LOADED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleSimEvent(event); } },
-        { RadioEvent::RADIO_SIM_ACCOUNT_LOADED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleSimEvent(event); } },
-        { RadioEvent::RADIO_PS_RAT_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { PsDataRatChanged(event); } },
-        { CellularDataEventCode::MSG_APN_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleApnChanged(event); } },
-        { CellularDataEventCode::MSG_SET_RIL_ATTACH_APN,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { SetRilAttachApnResponse(event); } },
-        { RadioEvent::RADIO_NR_STATE_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleRadioNrStateChanged(event); } },
-        { RadioEvent::RADIO_NR_FREQUENCY_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleRadioNrFrequencyChanged(event); } },
-        { CellularDataEventCode::MSG_DB_SETTING_ENABLE_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleDBSettingEnableChanged(event); } },
-        { CellularDataEventCode::MSG_DB_SETTING_ROAMING_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleDBSettingRoamingChanged(event); } },
-        { CellularDataEventCode::MSG_DB_SETTING_INCALL_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleDBSettingIncallChanged(event); } },
-        { CellularDataEventCode::MSG_INCALL_DATA_COMPLETE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { IncallDataComplete(event); } },
-        { RadioEvent::RADIO_RIL_ADAPTER_HOST_DIED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { OnRilAdapterHostDied(event); } },
-        { RadioEvent::RADIO_FACTORY_RESET,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleFactoryReset(event); } },
-        { RadioEvent::RADIO_CLEAN_ALL_DATA_CONNECTIONS,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { OnCleanAllDataConnectionsDone(event); } },
-        { CellularDataEventCode::MSG_DATA_CALL_LIST_CHANGED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleUpdateNetInfo(event); } },
-        { RadioEvent::RADIO_NV_REFRESH_FINISHED,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleSimEvent(event); } },
-        { CellularDataEventCode::MSG_RETRY_TO_SETUP_DATACALL,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { RetryToSetupDatacall(event); } },
-        { CellularDataEventCode::MSG_ESTABLISH_ALL_APNS_IF_CONNECTABLE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleEstablishAllApnsIfConnectable(event); } },
-        { CellularDataEventCode::MSG_RESUME_DATA_PERMITTED_TIMEOUT,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { ResumeDataPermittedTimerOut(event); } },
-        { CellularDataEventCode::MSG_RETRY_TO_CREATE_APN,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleApnChanged(event); } },
-        { CellularDataEventCode::MSG_RETRY_TO_LOAD_SIM_ACCOUNT,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleRetryLoadSimAccount(event); } },
-        { RadioEvent::RADIO_RESIDENT_NETWORK_CHANGE,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleResidentNetworkChanged(event); } },
-        { CellularDataEventCode::MSG_MCC_CHANGE_ACTIVATE_DELAY,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleMccChangeDelay(event); } },
-#ifdef BASE_POWER_IMPROVEMENT
-        { CellularDataEventCode::MSG_TIMEOUT_TO_REPLY_COMMON_EVENT,
-            [this](const AppExecFwk::InnerEvent::Pointer &event) { HandleReplyCommonEvent(event); } },
-#endif
+    using EventFun = void (CellularDataHandler::*)(const AppExecFwk::InnerEvent::Pointer &event);
+    struct EventFunEntry {
+        uint32_t eventId;
+        EventFun fun;
     };
+    static EventFun FindEventFun(uint32_t eventId);
 #ifdef BASE_POWER_IMPROVEMENT
     std::shared_ptr<CellularDataPowerSaveModeSubscriber> CreateCommonSubscriber(
         const std::string &event, int32_t priority);
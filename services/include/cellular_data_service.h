@@ -45,9 +45,12 @@ public:
     int32_t Dump(std::int32_t fd, const std::vector<std::u16string>& args) override;
     std::string GetBeginTime();
     std::string GetEndTime();
+    std::string GetBeginTime(int32_t slotId);
+    std::string GetEndTime(int32_t slotId);
     std::string GetCellularDataSlotIdDump();
     std::string GetStateMachineCurrentStatusDump();
     std::string GetFlowDataInfoDump();
+    std::string GetConnectionTrafficDump(int32_t slotId);
     int32_t IsCellularDataEnabled(bool &dataEnabled) override;
     int32_t EnableCellularData(bool enable) override;
     int32_t GetCellularDataState(int32_t &state) override;
@@ -67,6 +70,8 @@ public:
     int32_t ReleaseNet(const NetRequest &request);
     int32_t GetServiceRunningState();
     int64_t GetSpendTime();
+    int64_t GetSpendTime(int32_t slotId);
+    std::string GetInitPhaseTime();
     int32_t GetApnState(int32_t slotId, const std::string &apnType, int &state) override;
     int32_t GetDataRecoveryState(int32_t &state) override;
     int32_t RegisterSimAccountCallback(const sptr<SimAccountCallback> &callback) override;
@@ -93,10 +98,13 @@ public:
     int32_t GetNetworkSliceAllowedNssai(int32_t slotId, const std::vector<uint8_t>& buffer) override;
     int32_t GetNetworkSliceEhplmn(int32_t slotId) override;
     int32_t GetActiveApnName(std::string &apnName) override;
+    int32_t GetConnectionTrafficInfo(int32_t slotId, std::vector<ConnectionTrafficInfo> &infoList) override;
 
 private:
     bool Init();
     void InitModule();
+    void RegisterControllers();
+    void RecordSlotInitTime(int32_t slotId, bool isEnd);
     void UnRegisterAllNetSpecifier();
     void AddNetSupplier(int32_t slotId, CellularDataNetAgent &netAgent, std::vector<uint64_t> &netCapabilities);
     void ClearCellularDataControllers();
@@ -105,10 +113,17 @@ private:
     void SendSlotChangeInfoToChr(int32_t slotId);
 
 private:
+    struct SlotInitTime {
+        int64_t beginTime = 0L;
+        int64_t endTime = 0L;
+    };
+
     std::map<int32_t, std::shared_ptr<CellularDataController>> cellularDataControllers_;
     bool registerToService_;
     int64_t beginTime_ = 0L;
     int64_t endTime_ = 0L;
+    std::map<int32_t, SlotInitTime> slotInitTime_;
+    std::mutex slotInitTimeLock_;
     ServiceRunningState state_;
     std::mutex mapLock_;
     bool isInitSuccess_ = false;
@@ -267,8 +267,14 @@ static constexpr const char *CELLULAR_DATA_SETTING_INTELLIGENCE_NETWORK_URI =
 static constexpr const char *CELLULAR_DATA_AIRPLANE_MODE_URI =
     "datashare:///com.ohos.settingsdata/entry/settingsdata/SETTINGSDATA?Proxy=true&key=airplane_mode";
 static const int32_t DEFAULT_NET_STATISTICS_PERIOD = 3 * 1000;
+static const int32_t NET_STATISTICS_SCREEN_ON_PERIOD = 1 * 1000;
+static const int32_t DATA_FLOW_TYPE_HYSTERESIS_SAMPLES = 2;
+static const int32_t DATA_FLOW_TYPE_MIN_DWELL_MS = 3 * 1000;
+static const int32_t STATE_NOTIFICATION_DEBOUNCE_MS = 500;
 static const int32_t DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT = 1000 * 60 * 10;
 static const int32_t DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT = 1000 * 10;
+static const int32_t DATA_STALL_ALARM_MIN_DELAY_IN_MS = 2500;
+static const int32_t DATA_STALL_ALARM_IDLE_MAX_DELAY_IN_MS = 1000 * 80;
 static const int32_t ESTABLISH_DATA_CONNECTION_DELAY = 1 * 1000;
 static const int32_t CONNECTION_TIMEOUT = 180 * 1000;
 static const int32_t DISCONNECTION_TIMEOUT = 90 * 1000;
@@ -83,6 +83,9 @@ public:
 #endif
     static const uint32_t MSG_RETRY_TO_LOAD_SIM_ACCOUNT = BASE + 55;
     static const uint32_t MSG_MCC_CHANGE_ACTIVATE_DELAY = BASE + 56;
+    static const uint32_t MSG_APN_LOADED = BASE + 57;
+    static const uint32_t MSG_PREWARM_STATE_MACHINE_POOL = BASE + 58;
+    static const uint32_t MSG_CURRENT_APN_ID_LOADED = BASE + 59;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -45,6 +45,7 @@ public:
     void EndNetStatistics();
     int32_t GetDataFlowType();
     void SetDataFlowType(CellDataFlowType dataFlowType);
+    void GetConnectionTraffic(std::vector<ConnectionTrafficInfo> &infoList);
     int32_t GetSlotId() const;
     std::vector<std::shared_ptr<CellularDataStateMachine>> GetAllConnectionMachine();
     void GetDefaultBandWidthsConfig();
@@ -16,12 +16,17 @@
 #ifndef DATA_CONNECTION_MONITOR_H
 #define DATA_CONNECTION_MONITOR_H
 
+#include <mutex>
+
 #include "apn_holder.h"
+#include "data_flow_type_filter.h"
+#include "stall_detection_scheduler.h"
 #include "tel_event_handler.h"
 #include "traffic_management.h"
 
 namespace OHOS {
 namespace Telephony {
+class CellularDataStateMachine;
 class DataConnectionMonitor : public TelEventHandler {
 public:
     explicit DataConnectionMonitor(int32_t slotId);
@@ -47,6 +52,25 @@ public:
      */
     void UpdateFlowInfo();
 
+    /**
+     * Set the connections whose traffic is sampled
+     *
+     * @param connections all connection state machines of the slot
+     */
+    void SetConnections(const std::vector<std::shared_ptr<CellularDataStateMachine>> &connections);
+
+    /**
+     * Sample the counters of every active connection of the slot
+     */
+    void UpdateConnectionTraffic();
+
+    /**
+     * Get the counters of the last sample
+     *
+     * @return counters of each active connection
+     */
+    std::vector<ConnectionTrafficInfo> GetConnectionTraffic();
+
     /**
      * Data recovery processing
      */
@@ -112,17 +136,24 @@ public:
 private:
     bool IsAggressiveRecovery();
     int32_t GetStallDetectionPeriod();
+    void ScheduleStallDetection(int32_t delayMs);
     bool IsScreenOn();
+    static int64_t GetSteadyTimeMs();
     bool IsVsimEnabled();
 
     std::unique_ptr<TrafficManagement> trafficManager_;
     std::unique_ptr<TrafficManagement> stallDetectionTrafficManager_;
+    std::mutex connectionsMutex_;
+    std::vector<std::weak_ptr<CellularDataStateMachine>> connections_;
     bool updateNetStat_ = false;
     bool stallDetectionEnabled_ = false;
     bool isScreenOn_ = false;
     int64_t noRecvPackets_ = 0;
+    int64_t stallSentPackets_ = 0;
+    int64_t stallRecvPackets_ = 0;
+    StallDetectionPolicy stallDetectionPolicy_;
     RecoveryState dataRecoveryState_ = RecoveryState::STATE_REQUEST_CONTEXT_LIST;
-    CellDataFlowType dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_NONE;
+    DataFlowTypeFilter dataFlowTypeFilter_;
     const int32_t slotId_;
     int32_t callState_ = static_cast<int32_t>(TelCallStatus::CALL_STATUS_IDLE);
 };
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATA_FLOW_TYPE_FILTER_H
+#define DATA_FLOW_TYPE_FILTER_H
+
+#include <cstdint>
+
+#include "cellular_data_constant.h"
+
+namespace OHOS {
+namespace Telephony {
+struct DataFlowTypeConfig {
+    int32_t hysteresisSamples = DATA_FLOW_TYPE_HYSTERESIS_SAMPLES;
+    int64_t minDwellMs = DATA_FLOW_TYPE_MIN_DWELL_MS;
+};
+
+/**
+ * Turns per-sample flow types into a stable published flow type
+ *
+ * A new type is published only after it has been seen for hysteresisSamples samples in a row and the current
+ * type has been published for at least minDwellMs, so bursty traffic does not flip subscribers back and forth.
+ */
+class DataFlowTypeFilter {
+public:
+    explicit DataFlowTypeFilter(const DataFlowTypeConfig &config = DataFlowTypeConfig());
+
+    /**
+     * Classify one sample from the packet deltas
+     *
+     * @param sentPackets sent packets since the previous sample
+     * @param recvPackets received packets since the previous sample
+     * @return flow type of the sample
+     */
+    static CellDataFlowType Classify(int64_t sentPackets, int64_t recvPackets);
+
+    /**
+     * Feed one sample
+     *
+     * @param sampleType flow type of the sample
+     * @param nowMs steady time of the sample
+     * @return true if the published flow type changed, false if it is kept or the change is held back
+     */
+    bool Update(CellDataFlowType sampleType, int64_t nowMs);
+
+    /**
+     * Publish a flow type right away, such as when the statistics stop
+     *
+     * @param flowType flow type to publish
+     * @param nowMs steady time of the change
+     * @return true if the published flow type changed
+     */
+    bool Force(CellDataFlowType flowType, int64_t nowMs);
+
+    CellDataFlowType GetFlowType() const;
+
+private:
+    DataFlowTypeConfig config_;
+    CellDataFlowType flowType_ = CellDataFlowType::DATA_FLOW_TYPE_NONE;
+    CellDataFlowType candidateType_ = CellDataFlowType::DATA_FLOW_TYPE_NONE;
+    int32_t candidateSamples_ = 0;
+    int64_t lastChangeMs_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // DATA_FLOW_TYPE_FILTER_H
@@ -16,6 +16,7 @@
 #ifndef DATA_SWITCH_SETTINGS_H
 #define DATA_SWITCH_SETTINGS_H
 
+#include <atomic>
 #include <stdint.h>
 
 namespace OHOS {
@@ -37,18 +38,29 @@ public:
     void UpdateUserDataRoamingOn(bool dataRoaming);
     int32_t SetUserDataOn(bool userDataOn);
     int32_t SetAnySimDetected(int32_t simDetected);
+    int32_t SetUserDataOnAndSimDetected(bool userDataOn, int32_t simDetected);
     int32_t SetIntelliSwitchOn(bool userSwitchOn);
     int32_t SetUserDataRoamingOn(bool dataRoamingEnabled);
+    int32_t ResetUserDataSwitches(bool dataRoamingEnabled);
     int32_t QueryIntelligenceSwitchStatus(bool &switchEnabled);
     int32_t QueryUserDataStatus(bool &dataEnabled);
     int32_t QueryAnySimDetectedStatus(int32_t simDetected);
     int32_t QueryUserDataRoamingStatus(bool &dataRoamingEnabled);
     int32_t GetLastQryRet();
+    void InvalidateUserDataStatus();
+    void InvalidateUserDataRoamingStatus();
 
 private:
+    // The switch values are cached after a successful query and kept up to date by local writes. A change made by
+    // another process is only seen after the observer triggered invalidation, the generation keeps a query that raced
+    // with it from caching the value it read before.
     bool internalDataOn_ = true;
-    bool userDataOn_ = true;
-    bool userDataRoaming_ = false;
+    std::atomic<bool> userDataOn_ { true };
+    std::atomic<bool> userDataOnCached_ { false };
+    std::atomic<uint32_t> userDataOnGeneration_ { 0 };
+    std::atomic<bool> userDataRoaming_ { false };
+    std::atomic<int32_t> userDataRoamingSimId_;
+    std::atomic<uint32_t> userDataRoamingGeneration_ { 0 };
     bool policyDataOn_ = true;
     bool carrierDataOn_ = false;
     bool intelliSwitchOn_ = false;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STALL_DETECTION_SCHEDULER_H
+#define STALL_DETECTION_SCHEDULER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cellular_data_constant.h"
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Packets seen by one stall detection tick and the state the period depends on
+ */
+struct StallDetectionSample {
+    int64_t sentPackets = 0;
+    int64_t recvPackets = 0;
+    bool screenOn = false;
+    bool aggressiveRecovery = false;
+};
+
+/**
+ * Picks the period of the next stall detection tick of a slot
+ *
+ * The period halves down to DATA_STALL_ALARM_MIN_DELAY_IN_MS while packets are sent and the rx/tx ratio falls behind
+ * its smoothed value, goes back to the aggressive period once traffic is healthy, and doubles while the link is idle,
+ * up to DATA_STALL_ALARM_IDLE_MAX_DELAY_IN_MS with the screen on and the non-aggressive period with the screen off.
+ * A recovery in progress always ticks at the aggressive period.
+ */
+class StallDetectionPolicy {
+public:
+    int32_t Reset(int32_t basePeriodMs);
+    int32_t NextPeriod(const StallDetectionSample &sample);
+    int32_t GetPeriod() const;
+
+private:
+    bool IsDegrading(const StallDetectionSample &sample) const;
+
+private:
+    int32_t periodMs_ = DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+    double recvRatio_ = -1.0;
+};
+
+/**
+ * Deadlines of the stall detection ticks of all slots, without any clock of its own
+ *
+ * A tick may run up to a quarter of its period early, so a wakeup for one slot also serves every other slot whose
+ * tick is nearly due and the slots settle on a common beat.
+ */
+class StallDetectionTimerQueue {
+public:
+    void Schedule(int32_t slotId, int64_t nowMs, int64_t delayMs);
+    void Cancel(int32_t slotId);
+    bool IsScheduled(int32_t slotId) const;
+    int64_t GetNextFireTime() const;
+    std::vector<int32_t> PopDue(int64_t nowMs);
+
+private:
+    struct Entry {
+        int64_t earliestMs = 0;
+        int64_t deadlineMs = 0;
+    };
+    std::map<int32_t, Entry> entries_;
+};
+
+/**
+ * One timer shared by the stall detection of all slots
+ */
+class StallDetectionTimer {
+public:
+    using Tick = std::function<void()>;
+
+    static StallDetectionTimer &GetInstance();
+    void Schedule(int32_t slotId, int64_t delayMs, const Tick &tick);
+    void Cancel(int32_t slotId);
+    bool IsScheduled(int32_t slotId);
+    void Dump(std::string &result);
+
+private:
+    StallDetectionTimer() = default;
+    ~StallDetectionTimer() = default;
+    void RearmLocked();
+    void OnFire();
+    static int64_t GetSteadyTimeMs();
+
+private:
+    std::mutex mutex_;
+    StallDetectionTimerQueue queue_;
+    std::map<int32_t, Tick> ticks_;
+    int64_t armedFireMs_ = -1;
+    uint64_t wakeupCount_ = 0;
+    uint64_t tickCount_ = 0;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // STALL_DETECTION_SCHEDULER_H
@@ -28,8 +28,6 @@
 namespace OHOS {
 namespace Telephony {
 static const uint16_t DEFAULT_PORT = 0;
-static const size_t HOST_SIZE = 1;
-static const size_t HOST_PORT_SIZE = 2;
 static const int32_t DEFAULT_INTERNET_CONNECTION_SCORE = 60;
 static const int32_t OTHER_CONNECTION_SCORE = 55;
 
@@ -46,6 +44,13 @@ public:
     private:
         std::weak_ptr<CellularDataStateMachine> cellularDataStateMachine_;
     };
+    struct TrafficSnapshot {
+        bool isActive = false;
+        std::string ifName;
+        int32_t cid = 0;
+        uint64_t capability = 0;
+    };
+
     CellularDataStateMachine(std::shared_ptr<DataConnectionManager> &cdConnectionManager,
         std::shared_ptr<TelEventHandler> &&cellularDataHandler)
         : StateMachine("CellularDataStateMachine"), cdConnectionManager_(cdConnectionManager),
@@ -66,8 +71,10 @@ public:
     int32_t GetSlotId() const;
     std::string GetIpType();
     sptr<ApnItem> GetApnItem() const;
+    std::string GetIfName();
+    TrafficSnapshot GetTrafficSnapshot();
     void Init();
-    void UpdateHttpProxy(const std::string &proxyIpAddress);
+    void UpdateHttpProxy(const std::string &host, uint16_t port);
     void UpdateNetworkInfo(const SetupDataCallResultInfo &dataCallInfo);
     void UpdateNetworkInfo();
     void SetConnectionBandwidth(const uint32_t upBandwidth, const uint32_t downBandwidth);
@@ -106,8 +113,8 @@ private:
     std::string GetIpType(std::vector<AddressInfo> ipInfoArray);
     bool HasMatchedIpTypeAddrs(uint8_t ipType, uint8_t ipInfoArraySize, std::vector<AddressInfo> ipInfoArray);
     int32_t GetNetScoreBySlotId(int32_t slotId);
-    void GetNetworkSlicePara(const DataConnectionParams& connectionParams, sptr<ApnItem> apn);
-    void FillRSDFromNetCap(std::map<std::string, std::string> networkSliceParas, sptr<ApnItem> apn);
+    void GetNetworkSlicePara(const DataConnectionParams& connectionParams, DataProfile &dataProfile);
+    void FillRSDFromNetCap(std::map<std::string, std::string> networkSliceParas, DataProfile &dataProfile);
 
 private:
     friend class Active;
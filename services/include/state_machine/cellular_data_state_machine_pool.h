@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_DATA_STATE_MACHINE_POOL_H
+#define CELLULAR_DATA_STATE_MACHINE_POOL_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace Telephony {
+class CellularDataStateMachine;
+
+static constexpr size_t STATE_MACHINE_POOL_WARM_COUNT = 2;
+static constexpr size_t STATE_MACHINE_POOL_MAX_IDLE_COUNT = 4;
+
+struct StateMachinePoolStats {
+    uint64_t acquireCount = 0;
+    uint64_t hitCount = 0;
+    uint64_t createCount = 0;
+    uint64_t retireCount = 0;
+};
+
+/**
+ * Per-slot free list of initialized CellularDataStateMachine instances resting in Inactive
+ *
+ * Setting up a data connection used to scan every machine of the slot for an idle one and otherwise build and
+ * initialize a new machine on the spot. The pool is pre-warmed with a few machines off the setup path, a setup pops
+ * one and a torn down connection pushes its machine back. The list is capped, a machine released to a full pool is
+ * retired by the caller.
+ */
+class CellularDataStateMachinePool {
+public:
+    // Builds, initializes and registers a machine with the connection manager.
+    using Creator = std::function<std::shared_ptr<CellularDataStateMachine>()>;
+    // Whether a machine taken from the list may carry a new connection.
+    using IdleChecker = std::function<bool(const std::shared_ptr<CellularDataStateMachine> &)>;
+
+    CellularDataStateMachinePool(int32_t slotId, const Creator &creator,
+        size_t warmCount = STATE_MACHINE_POOL_WARM_COUNT, size_t maxIdleCount = STATE_MACHINE_POOL_MAX_IDLE_COUNT);
+    ~CellularDataStateMachinePool() = default;
+    size_t PreWarm();
+    bool NeedPreWarm();
+    std::shared_ptr<CellularDataStateMachine> Acquire(const IdleChecker &isIdle);
+    std::shared_ptr<CellularDataStateMachine> Create();
+    bool Release(const std::shared_ptr<CellularDataStateMachine> &stateMachine);
+    size_t GetIdleCount();
+    StateMachinePoolStats GetStats();
+
+private:
+    std::mutex mutex_;
+    int32_t slotId_;
+    Creator creator_;
+    size_t warmCount_;
+    size_t maxIdleCount_;
+    std::vector<std::shared_ptr<CellularDataStateMachine>> freeList_;
+    StateMachinePoolStats stats_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // CELLULAR_DATA_STATE_MACHINE_POOL_H
@@ -16,11 +16,40 @@
 #ifndef STATE_MACHINE_H
 #define STATE_MACHINE_H
 
+#include <array>
+#include <atomic>
+#include <optional>
+#include <vector>
+
 #include "cellular_data_event_code.h"
+#include "shared_event_executor.h"
 #include "tel_event_handler.h"
 
 namespace OHOS {
 namespace Telephony {
+static constexpr size_t STATE_MACHINE_DEFER_EVENT_CAPACITY = 32;
+
+struct StateMachineDeferStats {
+    uint64_t deferredCount = 0;
+    uint64_t replayedCount = 0;
+    uint64_t overflowCount = 0;
+};
+
+struct StateMachineDeferCounters {
+    std::atomic<uint64_t> deferredCount { 0 };
+    std::atomic<uint64_t> replayedCount { 0 };
+    std::atomic<uint64_t> overflowCount { 0 };
+
+    StateMachineDeferStats Snapshot() const
+    {
+        StateMachineDeferStats stats;
+        stats.deferredCount = deferredCount.load(std::memory_order_relaxed);
+        stats.replayedCount = replayedCount.load(std::memory_order_relaxed);
+        stats.overflowCount = overflowCount.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
 class State : public std::enable_shared_from_this<State> {
 #define PROCESSED true
 #define NOT_PROCESSED false
@@ -34,6 +63,7 @@ public:
     void SetParentState(std::shared_ptr<State> &parent)
     {
         parent_ = parent;
+        parentState_ = parent.get();
     }
 
     std::string GetStateMachineName() const
@@ -45,13 +75,128 @@ protected:
     friend class StateMachineEventHandler;
     std::string name_;
     std::shared_ptr<State> parent_ = nullptr;
+    // Borrowed from parent_, walked for every event without touching the reference count
+    State *parentState_ = nullptr;
     bool isActive_ = false;
 };
 
+/**
+ * Event dispatch table of a state
+ *
+ * The entries are a static array of the state class holding plain member function pointers, every instance only
+ * keeps a view on it. Building a state therefore allocates nothing and dispatching an event is a short linear scan
+ * without copying a std::function.
+ */
+template<typename T>
+class StateEventTable {
+public:
+    using Handler = bool (T::*)(const AppExecFwk::InnerEvent::Pointer &event);
+    struct Entry {
+        uint32_t eventId;
+        Handler handler;
+    };
+
+    template<size_t N>
+    constexpr explicit StateEventTable(const Entry (&entries)[N]) : entries_(entries), size_(N)
+    {}
+
+    const Entry *find(uint32_t eventId) const
+    {
+        for (size_t i = 0; i < size_; ++i) {
+            if (entries_[i].eventId == eventId) {
+                return &entries_[i];
+            }
+        }
+        return end();
+    }
+
+    const Entry *end() const
+    {
+        return entries_ + size_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool Dispatch(T &state, const AppExecFwk::InnerEvent::Pointer &event) const
+    {
+        const Entry *entry = find(event->GetInnerEventId());
+        if (entry == end() || entry->handler == nullptr) {
+            return NOT_PROCESSED;
+        }
+        return (state.*(entry->handler))(event);
+    }
+
+private:
+    const Entry *entries_;
+    size_t size_;
+};
+
+/**
+ * Bounded queue of deferred events
+ *
+ * Events are deferred by the state handling them and replayed by the same handler thread after the next transition,
+ * so a single producer and a single consumer share a fixed ring without a lock or any allocation.
+ */
+class DeferEventQueue {
+public:
+    bool Push(AppExecFwk::InnerEvent::Pointer &&event)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= STATE_MACHINE_DEFER_EVENT_CAPACITY) {
+            return false;
+        }
+        events_[tail % STATE_MACHINE_DEFER_EVENT_CAPACITY].emplace(std::move(event));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<AppExecFwk::InnerEvent::Pointer> Pop()
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<AppExecFwk::InnerEvent::Pointer> &slot = events_[head % STATE_MACHINE_DEFER_EVENT_CAPACITY];
+        std::optional<AppExecFwk::InnerEvent::Pointer> event = std::move(slot);
+        slot.reset();
+        head_.store(head + 1, std::memory_order_release);
+        return event;
+    }
+
+    size_t Size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<std::optional<AppExecFwk::InnerEvent::Pointer>, STATE_MACHINE_DEFER_EVENT_CAPACITY> events_;
+    std::atomic<size_t> head_ { 0 };
+    std::atomic<size_t> tail_ { 0 };
+};
+
 class StateMachineEventHandler : public TelEventHandler {
 public:
-    explicit StateMachineEventHandler(const std::string &name) : TelEventHandler(name) {}
-    ~StateMachineEventHandler() = default;
+    // Only with the shared executor enabled the handler moves to a shared runner, before any event is posted to it.
+    explicit StateMachineEventHandler(const std::string &name) : TelEventHandler(name)
+    {
+        SharedEventExecutor &executor = SharedEventExecutor::GetInstance();
+        if (executor.IsEnabled()) {
+            sharedRunner_ = executor.AcquireRunner();
+        }
+        if (sharedRunner_ != nullptr) {
+            SetEventRunner(sharedRunner_);
+        }
+    }
+
+    ~StateMachineEventHandler()
+    {
+        if (sharedRunner_ != nullptr) {
+            SharedEventExecutor::GetInstance().ReleaseRunner(sharedRunner_);
+        }
+    }
 
     virtual void SetOriginalState(std::shared_ptr<State> &originalState)
     {
@@ -66,44 +211,56 @@ public:
 
     virtual void Quit()
     {
-        std::shared_ptr<State> tmpState = curState_;
+        State *tmpState = curState_.get();
         while (tmpState != nullptr && tmpState->isActive_) {
             tmpState->StateEnd();
-            tmpState = tmpState->parent_;
+            tmpState = tmpState->parentState_;
             isQuit_ = true;
         }
     }
 
-    // Only two-layer StateMachines are supported
+    // States shared by the current and the destination state stay entered, only the branches below them change.
     virtual void ProcessTransitions(const AppExecFwk::InnerEvent::Pointer &event)
     {
         if (curState_ != destState_) {
             TELEPHONY_LOGD("Begin process transitions");
-            if (curState_ != nullptr) {
-                std::shared_ptr<State> tmpState = curState_->parent_;
-                while (tmpState != nullptr) {
-                    tmpState->StateEnd();
-                    tmpState = tmpState->parent_;
-                }
-                curState_->StateEnd();
-            }
-            if (destState_ != nullptr) {
-                std::shared_ptr<State> tmpState = destState_->parent_;
-                while (tmpState != nullptr) {
-                    tmpState->StateBegin();
-                    tmpState = tmpState->parent_;
-                }
-                destState_->StateBegin();
+            State *commonState = FindCommonAncestor(curState_.get(), destState_.get());
+            State *tmpState = curState_.get();
+            while (tmpState != nullptr && tmpState != commonState) {
+                tmpState->StateEnd();
+                tmpState = tmpState->parentState_;
             }
+            EnterStates(destState_.get(), commonState);
             curState_ = destState_;
-            SendDeferredEvent();
+            ReplayDeferredEvents();
         }
     }
 
     void DeferEvent(AppExecFwk::InnerEvent::Pointer &&event)
     {
-        std::lock_guard<std::mutex> guard(mtx_);
-        deferEvents_.push_back(std::move(event));
+        if (event == nullptr) {
+            return;
+        }
+        // Once the ring is full, later events queue behind the overflowed ones to keep their order.
+        if (!overflowEvents_.empty() || !deferEvents_.Push(std::move(event))) {
+            TELEPHONY_LOGI("Defer queue is full, re-post event %{public}u after transition", event->GetInnerEventId());
+            overflowEvents_.push_back(std::move(event));
+            deferCounters_.overflowCount.fetch_add(1, std::memory_order_relaxed);
+            totalDeferCounters_.overflowCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        deferCounters_.deferredCount.fetch_add(1, std::memory_order_relaxed);
+        totalDeferCounters_.deferredCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    StateMachineDeferStats GetDeferStats() const
+    {
+        return deferCounters_.Snapshot();
+    }
+
+    // Sum over every state machine of the process
+    static StateMachineDeferStats GetTotalDeferStats()
+    {
+        return totalDeferCounters_.Snapshot();
     }
 
     virtual void ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event)
@@ -112,6 +269,9 @@ public:
             TELEPHONY_LOGE("The event parameter is incorrect");
             return;
         }
+        if (sharedRunner_ != nullptr) {
+            SharedEventExecutor::GetInstance().RecordEvent(event);
+        }
         if (event->GetInnerEventId() == CellularDataEventCode::MSG_STATE_MACHINE_QUIT) {
             TELEPHONY_LOGI("State machine exit");
             Quit();
@@ -127,14 +287,51 @@ public:
 
     virtual void ProcessMsg(const AppExecFwk::InnerEvent::Pointer &event)
     {
-        std::shared_ptr<State> tmpState = curState_;
+        // The machine owns its states, so the chain is walked through borrowed pointers.
+        State *tmpState = curState_.get();
         TELEPHONY_LOGD("The event id: %{public}u", event->GetInnerEventId());
         while (tmpState != nullptr && !tmpState->StateProcess(event)) {
-            tmpState = tmpState->parent_;
+            tmpState = tmpState->parentState_;
         }
     }
 
 private:
+    static size_t GetStateDepth(const State *state)
+    {
+        size_t depth = 0;
+        for (; state != nullptr; state = state->parentState_) {
+            depth++;
+        }
+        return depth;
+    }
+
+    static State *FindCommonAncestor(State *first, State *second)
+    {
+        size_t firstDepth = GetStateDepth(first);
+        size_t secondDepth = GetStateDepth(second);
+        for (; firstDepth > secondDepth; firstDepth--) {
+            first = first->parentState_;
+        }
+        for (; secondDepth > firstDepth; secondDepth--) {
+            second = second->parentState_;
+        }
+        while (first != second) {
+            first = first->parentState_;
+            second = second->parentState_;
+        }
+        return first;
+    }
+
+    // Enters the states between ancestor (exclusive) and state (inclusive), outermost first.
+    static void EnterStates(State *state, const State *ancestor)
+    {
+        if (state == nullptr || state == ancestor) {
+            return;
+        }
+        EnterStates(state->parentState_, ancestor);
+        state->StateBegin();
+    }
+
     void InitCmdEnter(const std::shared_ptr<State> &state)
     {
         if (state == nullptr) {
@@ -149,25 +346,46 @@ private:
         curState_ = state;
     }
 
-    void SendDeferredEvent()
+    // Replays the events deferred before the transition against the new state within the current turn. A replayed
+    // event may transition again, the outer loop then picks up everything deferred up to that point.
+    void ReplayDeferredEvents()
     {
-        std::lock_guard<std::mutex> guard(mtx_);
-        if (deferEvents_.empty()) {
+        replayBudget_ = deferEvents_.Size();
+        if (isReplaying_) {
             return;
         }
-        for (size_t i = 0; i < deferEvents_.size(); ++i) {
-            AppExecFwk::InnerEvent::Pointer event = std::move(deferEvents_[i]);
+        isReplaying_ = true;
+        while (replayBudget_ > 0 && !isQuit_) {
+            replayBudget_--;
+            std::optional<AppExecFwk::InnerEvent::Pointer> event = deferEvents_.Pop();
+            if (!event.has_value() || *event == nullptr) {
+                continue;
+            }
+            deferCounters_.replayedCount.fetch_add(1, std::memory_order_relaxed);
+            totalDeferCounters_.replayedCount.fetch_add(1, std::memory_order_relaxed);
+            ProcessMsg(*event);
+            ProcessTransitions(*event);
+        }
+        // Events beyond the ring are re-posted, they run after the replayed ones.
+        std::vector<AppExecFwk::InnerEvent::Pointer> overflowEvents;
+        overflowEvents.swap(overflowEvents_);
+        for (AppExecFwk::InnerEvent::Pointer &event : overflowEvents) {
             SendImmediateEvent(event);
         }
-        deferEvents_.clear();
+        isReplaying_ = false;
     }
 
 private:
+    std::shared_ptr<AppExecFwk::EventRunner> sharedRunner_ = nullptr;
     std::shared_ptr<State> originalState_ = nullptr;
     std::shared_ptr<State> destState_ = nullptr;
     std::shared_ptr<State> curState_ = nullptr;
-    std::vector<AppExecFwk::InnerEvent::Pointer> deferEvents_;
-    std::mutex mtx_;
+    DeferEventQueue deferEvents_;
+    std::vector<AppExecFwk::InnerEvent::Pointer> overflowEvents_;
+    size_t replayBudget_ = 0;
+    bool isReplaying_ = false;
+    StateMachineDeferCounters deferCounters_;
+    inline static StateMachineDeferCounters totalDeferCounters_;
     bool isQuit_ = false;
 };
 
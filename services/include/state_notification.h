@@ -16,22 +16,73 @@
 #ifndef STATE_NOTIFICATION_H
 #define STATE_NOTIFICATION_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "cellular_data_constant.h"
+#include "event_handler.h"
 
 namespace OHOS {
 namespace Telephony {
+struct StateNotificationStats {
+    uint64_t publishedCount = 0;
+    uint64_t suppressedCount = 0;
+};
+
+/**
+ * Publishes the connect state and flow type of each slot to the state registry
+ *
+ * Every publish is an IPC fan-out, so updates are coalesced before they are dispatched: an update equal to the
+ * last published one is dropped, a CONNECTING state is held for the debounce window so that a CONNECTED right
+ * after it replaces it, and whatever is due for all slots is dispatched together by one task.
+ */
 class StateNotification {
 public:
     static StateNotification &GetInstance();
     void UpdateCellularDataConnectState(int32_t slotId, ApnProfileState dataState, int32_t networkType);
     void OnUpDataFlowtype(int32_t slotId, CellDataFlowType flowType);
+    void SetDebounceWindow(int64_t windowMs);
+    StateNotificationStats GetStats();
+    void Dump(std::string &result);
 
 private:
+    struct SlotState {
+        bool hasConnectState = false;
+        int32_t connectState = 0;
+        int32_t networkType = 0;
+        bool connectPending = false;
+        int32_t pendingConnectState = 0;
+        int32_t pendingNetworkType = 0;
+        int64_t connectDueMs = 0;
+        bool hasFlowType = false;
+        int32_t flowType = 0;
+        bool flowPending = false;
+        int32_t pendingFlowType = 0;
+    };
+
+    struct PendingPublish {
+        int32_t slotId = 0;
+        bool isConnectState = false;
+        int32_t state = 0;
+        int32_t networkType = 0;
+    };
+
     StateNotification() = default;
     ~StateNotification() = default;
+    bool ScheduleFlushLocked(int64_t dueMs, int64_t nowMs);
+    void Flush();
+    void Publish(const PendingPublish &publish);
+    static int64_t GetSteadyTimeMs();
 
 private:
     static StateNotification stateNotification_;
+    std::mutex mutex_;
+    std::map<int32_t, SlotState> slots_;
+    int64_t debounceWindowMs_ = STATE_NOTIFICATION_DEBOUNCE_MS;
+    int64_t flushDueMs_ = -1;
+    StateNotificationStats stats_;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -16,10 +16,18 @@
 #ifndef TELEPHONY_TRAFFIC_MANAGEMENT_H
 #define TELEPHONY_TRAFFIC_MANAGEMENT_H
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "cellular_data_constant.h"
+#include "link_stats_reader.h"
 
 namespace OHOS {
 namespace Telephony {
+class CellularDataStateMachine;
 class TrafficManagement {
 public:
     explicit TrafficManagement(int32_t slotId);
@@ -38,12 +46,44 @@ public:
      */
     void UpdatePacketData();
 
+    /**
+     * Read a packet counter of an interface from /sys/class/net/<iface>/statistics
+     *
+     * @param ifaceName interface name
+     * @param counter counter file name, such as tx_packets
+     * @param value counter value
+     * @return 0 on success, else the errno of the failed step
+     */
+    static int32_t ReadIfaceCounter(const std::string &ifaceName, const char *counter, int64_t &value);
+
+    /**
+     * Sample the counters of every active connection with one link stats dump
+     *
+     * @param connections all connection state machines of the slot
+     */
+    void UpdateConnectionTraffic(const std::vector<std::shared_ptr<CellularDataStateMachine>> &connections);
+
+    /**
+     * Get the counters of the last UpdateConnectionTraffic
+     *
+     * @return counters of each active connection
+     */
+    std::vector<ConnectionTrafficInfo> GetConnectionTraffic();
+
 private:
     std::string GetIfaceName();
+    bool ReadPacketsFromKernel(const std::string &ifaceName);
+    bool ReadLinkStats(std::map<int32_t, LinkStats> &linkStats);
+    static void ReadConnectionCounters(const std::map<int32_t, LinkStats> *linkStats, ConnectionTrafficInfo &info);
 
 private:
     int64_t sendPackets_ = 0;
     int64_t recvPackets_ = 0;
+    bool kernelCounterReadable_ = true;
+    // Sampled by the monitor timer and by traffic queries from other threads.
+    std::atomic<bool> linkStatsReadable_ { true };
+    std::mutex connectionTrafficMutex_;
+    std::vector<ConnectionTrafficInfo> connectionTraffic_;
     const int32_t slotId_;
 };
 } // namespace Telephony
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_DATA_IO_WORKER_H
+#define CELLULAR_DATA_IO_WORKER_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cellular_data_constant.h"
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int32_t IO_WORKER_NUM = 2;
+static constexpr int32_t IO_WORKER_SLOT_NUM = CELLDATA_SLOT_ID_3 + 1;
+
+struct IoWorkerStats {
+    uint64_t taskCount = 0;
+    int64_t totalWaitUs = 0;
+    int64_t maxWaitUs = 0;
+    int64_t totalCostUs = 0;
+    int64_t maxCostUs = 0;
+    // Posted but not finished yet, a growing value means the worker falls behind the handler
+    uint32_t pendingCount = 0;
+};
+
+/**
+ * Runs blocking database work of the cellular data handlers
+ *
+ * DataShare queries may block for seconds, running them inside ProcessEvent stalls every radio event of the slot.
+ * Tasks are posted here instead and report back to the handler with an inner event. The tasks of one slot always run
+ * on the same worker thread, so they keep their order.
+ */
+class CellularDataIoWorker {
+public:
+    static CellularDataIoWorker &GetInstance();
+    bool PostTask(int32_t slotId, const std::function<void()> &task);
+    void Dump(std::string &result);
+
+private:
+    CellularDataIoWorker() = default;
+    ~CellularDataIoWorker() = default;
+    std::shared_ptr<AppExecFwk::EventHandler> GetWorkerHandler(int32_t slotId);
+    void RecordTask(int32_t slotId, int64_t waitUs, int64_t costUs);
+    void UpdatePendingCount(int32_t slotId, bool isPosted);
+    static bool IsValidSlotId(int32_t slotId);
+
+private:
+    std::mutex mutex_;
+    std::array<std::shared_ptr<AppExecFwk::EventHandler>, IO_WORKER_NUM> workerHandlers_;
+    std::array<IoWorkerStats, IO_WORKER_SLOT_NUM> stats_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // CELLULAR_DATA_IO_WORKER_H
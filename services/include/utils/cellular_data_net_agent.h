@@ -16,7 +16,10 @@
 #ifndef CELLULAR_DATA_NET_AGENT_H
 #define CELLULAR_DATA_NET_AGENT_H
 
+#include <map>
+#include <mutex>
 #include <shared_mutex>
+#include <string>
 
 #include "i_net_conn_service.h"
 
@@ -111,13 +114,38 @@ public:
     int32_t GetCellNetId(int32_t slotId);
     void NetDetection(int32_t netId);
 
+    /**
+     * Get the interface of the cellular network of a slot remembered by CacheCellIface
+     *
+     * @param slotId card slot identification
+     * @param netId net id the interface belongs to
+     * @param ifaceName interface name
+     * @return true if an interface is cached for the slot
+     */
+    bool GetCachedCellIface(int32_t slotId, int32_t &netId, std::string &ifaceName);
+    void CacheCellIface(int32_t slotId, int32_t netId, const std::string &ifaceName);
+
+    /**
+     * Drop the cached interface of a slot, called whenever the link of a connection changes
+     *
+     * @param slotId card slot identification
+     */
+    void InvalidateCellIface(int32_t slotId);
+
 private:
+    struct CellIface {
+        int32_t netId = -1;
+        std::string ifaceName;
+    };
+
     std::shared_mutex netSupplierMutex_;
     std::shared_mutex slotIdSimIdMutex_;
     std::map <int32_t, int32_t> slotIdSimId_;
     std::vector<NetSupplier> netSuppliers_;
     sptr<NetManagerCallBack> callBack_;
     sptr<NetManagerTacticsCallBack> tacticsCallBack_;
+    std::mutex cellIfaceMutex_;
+    std::map<int32_t, CellIface> cellIfaces_;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_DATA_PERF_STATS_H
+#define CELLULAR_DATA_PERF_STATS_H
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cellular_data_constant.h"
+#include "inner_event.h"
+
+namespace OHOS {
+namespace Telephony {
+enum class PerfComponent : int32_t {
+    CELLULAR_DATA_HANDLER,
+    DATA_CONNECTION_MANAGER,
+    DATA_CONNECTION_MONITOR,
+    PERF_COMPONENT_BUTT
+};
+
+static constexpr int32_t MAX_PERF_SLOT_NUM = CELLDATA_SLOT_ID_3 + 1;
+static constexpr size_t PERF_LATENCY_BUCKET_NUM = 10;
+static constexpr size_t PERF_SETUP_SAMPLE_NUM = 128;
+static constexpr size_t PERF_RECOVERY_STATE_NUM = 4;
+
+struct PerfLatencyHistogram {
+    uint64_t count = 0;
+    int64_t totalCostUs = 0;
+    int64_t maxCostUs = 0;
+    int64_t totalWaitUs = 0;
+    int64_t maxWaitUs = 0;
+    std::array<uint32_t, PERF_LATENCY_BUCKET_NUM> buckets {};
+};
+
+class CellularDataPerfStats {
+public:
+    static CellularDataPerfStats &GetInstance();
+
+    /**
+     * Record one processed event of the given component
+     *
+     * @param slotId card slot identification
+     * @param component which event handler processed the event
+     * @param eventId inner event id
+     * @param waitUs time between the event being due and being dispatched
+     * @param costUs time spent in the handler
+     */
+    void RecordEvent(int32_t slotId, PerfComponent component, uint32_t eventId, int64_t waitUs, int64_t costUs);
+    void RecordSetupLatency(int32_t slotId, int64_t costMs);
+    void IncreaseRetryCount(int32_t slotId);
+    void IncreaseStallRecoveryCount(int32_t slotId, RecoveryState state);
+    void IncreaseFlowTypeSuppressedCount(int32_t slotId);
+    void RecordStateMachinePoolAcquire(int32_t slotId, bool hit);
+    void Dump(int32_t slotId, std::string &result);
+    void Reset(int32_t slotId);
+    static int64_t GetSteadyTimeUs();
+
+private:
+    struct SlotPerfStats {
+        std::array<std::map<uint32_t, PerfLatencyHistogram>,
+            static_cast<size_t>(PerfComponent::PERF_COMPONENT_BUTT)> eventStats;
+        std::array<int64_t, PERF_SETUP_SAMPLE_NUM> setupSamplesMs {};
+        size_t setupSampleIndex = 0;
+        uint64_t setupCount = 0;
+        int64_t setupMaxMs = 0;
+        uint64_t retryCount = 0;
+        std::array<uint64_t, PERF_RECOVERY_STATE_NUM> recoveryCount {};
+        uint64_t flowTypeSuppressedCount = 0;
+        uint64_t poolAcquireCount = 0;
+        uint64_t poolHitCount = 0;
+    };
+
+    CellularDataPerfStats() = default;
+    ~CellularDataPerfStats() = default;
+    static bool IsValidSlotId(int32_t slotId);
+    static size_t GetBucketIndex(int64_t costUs);
+    static int64_t GetPercentile(std::vector<int64_t> &samples, uint32_t percent);
+    void DumpEventStats(const SlotPerfStats &stats, std::string &result) const;
+    void DumpSetupStats(const SlotPerfStats &stats, std::string &result) const;
+
+private:
+    std::array<SlotPerfStats, MAX_PERF_SLOT_NUM> slotStats_;
+    std::array<std::mutex, MAX_PERF_SLOT_NUM> slotMutex_;
+};
+
+class PerfEventScope {
+public:
+    PerfEventScope(int32_t slotId, PerfComponent component, const AppExecFwk::InnerEvent::Pointer &event);
+    ~PerfEventScope();
+
+private:
+    int32_t slotId_;
+    PerfComponent component_;
+    uint32_t eventId_ = 0;
+    int64_t waitUs_ = 0;
+    int64_t beginUs_ = 0;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // CELLULAR_DATA_PERF_STATS_H
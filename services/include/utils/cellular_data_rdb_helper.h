@@ -21,6 +21,7 @@
 
 #include "cellular_data_types.h"
 #include "datashare_helper.h"
+#include "datashare_helper_pool.h"
 #include "iservice_registry.h"
 #include "string_ex.h"
 #include "system_ability_definition.h"
@@ -46,6 +47,7 @@ public:
     void QueryApnIds(const ApnInfo &apnInfo, std::vector<uint32_t> &apnIdList);
     int32_t SetPreferApn(int32_t apnId);
     void QueryAllApnInfo(std::vector<ApnInfo> &apnInfoList);
+    void DumpHelperPool(std::string &result);
 
 private:
     std::shared_ptr<DataShare::DataShareHelper> CreateDataAbilityHelper(const int waitTime = 2);
@@ -62,6 +64,7 @@ private:
 
 private:
     Uri cellularDataUri_;
+    std::shared_ptr<DataShareHelperPool> helperPool_;
 };
 } // namespace Telephony
 } // namespace OHOS
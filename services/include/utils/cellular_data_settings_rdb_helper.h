@@ -17,13 +17,22 @@
 #define CELLULAR_DATA_SETTINGS_RDB_HELPER_H
 
 #include <singleton.h>
+#include <string>
+#include <vector>
 
 #include "datashare_helper.h"
+#include "datashare_helper_pool.h"
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
 
 namespace OHOS {
 namespace Telephony {
+struct SettingsValueEntry {
+    std::string uri;
+    std::string column;
+    int value = 0;
+};
+
 class CellularDataSettingsRdbHelper : public DelayedSingleton<CellularDataSettingsRdbHelper> {
     DECLARE_DELAYED_SINGLETON(CellularDataSettingsRdbHelper);
 public:
@@ -51,7 +60,34 @@ public:
     void NotifyChange(const Uri &uri);
     int32_t GetValue(Uri &uri, const std::string &column, int32_t &value);
     int32_t PutValue(Uri &uri, const std::string &column, int value);
+
+    /**
+     * Upserts several settings keys in one batch and notifies the uri of every key which has been written.
+     *
+     * The write is not atomic. Keys the batch did not write are retried one by one, so on failure some keys may hold
+     * the new value while others kept the old one. A caller caching the values re-reads them instead of restoring
+     * what it had before.
+     *
+     * @param entries, Indicates the keys to write, a key listed twice keeps its last value.
+     * @return TELEPHONY_ERR_SUCCESS only if every key has been written.
+     */
+    int32_t PutValues(const std::vector<SettingsValueEntry> &entries);
     std::shared_ptr<DataShare::DataShareHelper> CreateDataShareHelper();
+    void DumpHelperPool(std::string &result);
+
+private:
+    int32_t QueryValue(const std::shared_ptr<DataShare::DataShareHelper> &settingHelper, Uri &uri,
+        const std::string &column, int32_t &value);
+    int32_t QueryExistKeys(const std::shared_ptr<DataShare::DataShareHelper> &settingHelper,
+        const std::vector<std::string> &keys, std::vector<std::string> &existKeys);
+    int32_t WriteValuesOneByOne(const std::shared_ptr<DataShare::DataShareHelper> &settingHelper,
+        const std::vector<SettingsValueEntry> &entries, const std::vector<std::string> &existKeys,
+        std::vector<SettingsValueEntry> &writtenEntries);
+    static bool IsStatementWritten(const DataShare::ExecResult &result);
+    static void WritePutValueFaultEvent(const Uri &uri, int value);
+
+private:
+    std::shared_ptr<DataShareHelperPool> helperPool_;
 };
 } // namespace Telephony
 } // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_DATA_SETUP_TRACER_H
+#define CELLULAR_DATA_SETUP_TRACER_H
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "cellular_data_constant.h"
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Stages of one data call setup, in the order they are expected to happen
+ */
+enum class SetupTraceStage : int32_t {
+    REQUEST_NET,
+    MSG_REQUEST_NETWORK,
+    ATTEMPT_ESTABLISH,
+    SM_CONNECT,
+    RIL_ACTIVATE_DONE,
+    ESTABLISH_COMPLETE,
+    UPDATE_NETWORK_INFO,
+    SETUP_TRACE_STAGE_BUTT
+};
+
+static constexpr size_t SETUP_TRACE_STAGE_NUM = static_cast<size_t>(SetupTraceStage::SETUP_TRACE_STAGE_BUTT);
+static constexpr size_t SETUP_TRACE_SPAN_NUM = 64;
+static constexpr int32_t SETUP_TRACE_SLOT_NUM = CELLDATA_SLOT_ID_3 + 1;
+static constexpr int32_t SETUP_TRACE_APN_ID_NUM = DATA_CONTEXT_ROLE_SNSSAI6_ID + 1;
+
+class CellularDataSetupTracer {
+public:
+    static CellularDataSetupTracer &GetInstance();
+
+    /**
+     * Record that a data call of the given apn reached a setup stage
+     *
+     * The stages up to SM_CONNECT open a span if none is in flight, later stages are only recorded on an open
+     * span. UPDATE_NETWORK_INFO closes the span and stores it in the per-slot ring buffer.
+     *
+     * @param slotId card slot identification
+     * @param apnId apn type id, see DataContextRolesId
+     * @param stage the stage that has been reached
+     */
+    void Mark(int32_t slotId, int32_t apnId, SetupTraceStage stage);
+    void Dump(int32_t slotId, std::string &result);
+    void Reset(int32_t slotId);
+
+private:
+    struct SetupSpan {
+        std::atomic<int32_t> apnId { DATA_CONTEXT_ROLE_INVALID_ID };
+        std::array<std::atomic<int64_t>, SETUP_TRACE_STAGE_NUM> stageCostUs;
+        std::atomic<int64_t> totalCostUs { 0 };
+    };
+
+    struct SlotSetupTrace {
+        std::array<std::array<std::atomic<int64_t>, SETUP_TRACE_STAGE_NUM>, SETUP_TRACE_APN_ID_NUM> inflightUs;
+        std::array<SetupSpan, SETUP_TRACE_SPAN_NUM> spans;
+        std::atomic<uint64_t> spanCount { 0 };
+    };
+
+    CellularDataSetupTracer();
+    ~CellularDataSetupTracer() = default;
+    void CommitSpan(SlotSetupTrace &trace, int32_t apnId);
+    void DumpApnStats(const SlotSetupTrace &trace, int32_t apnId, std::string &result) const;
+    static int64_t GetPercentile(std::vector<int64_t> &samples, uint32_t percent);
+    static void AppendPercentiles(std::vector<int64_t> &samples, std::string &result);
+
+private:
+    std::array<SlotSetupTrace, SETUP_TRACE_SLOT_NUM> slotTrace_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // CELLULAR_DATA_SETUP_TRACER_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_DATA_STARTUP_H
+#define CELLULAR_DATA_STARTUP_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int64_t STARTUP_DEFERRED_IDLE_TIMEOUT_MS = 30 * 1000;
+
+enum class StartupPhaseType {
+    CRITICAL,
+    DEFERRED,
+};
+
+struct StartupPhaseRecord {
+    std::string name;
+    StartupPhaseType type = StartupPhaseType::CRITICAL;
+    int64_t startMs = 0;
+    int64_t costMs = 0;
+};
+
+/**
+ * Splits the service start into timed phases
+ *
+ * Critical phases are what the first data call needs and run in place during OnStart. Deferrable phases are queued
+ * and run on the startup runner once the first default apn is connected, or after an idle timeout when no data call
+ * comes up. A deferred phase added after that point runs right away.
+ */
+class CellularDataStartup {
+public:
+    static CellularDataStartup &GetInstance();
+    void Begin();
+    void RunCriticalPhase(const std::string &name, const std::function<void()> &phase);
+    void AddDeferredPhase(const std::string &name, const std::function<void()> &phase);
+    void OnDefaultApnConnected();
+    void ReleaseDeferredPhases(const std::string &trigger);
+    std::string GetCriticalPhaseTime();
+    void Dump(std::string &result);
+
+private:
+    CellularDataStartup() = default;
+    ~CellularDataStartup() = default;
+    std::shared_ptr<AppExecFwk::EventHandler> GetStartupHandler();
+    void RunDeferredPhase(const std::string &name, const std::function<void()> &phase);
+    void Record(const std::string &name, StartupPhaseType type, int64_t startMs, int64_t costMs);
+    static int64_t GetSteadyTimeMs();
+
+private:
+    std::mutex mutex_;
+    int64_t beginMs_ = 0;
+    bool released_ = false;
+    std::string releaseTrigger_;
+    int64_t releaseMs_ = 0;
+    std::vector<std::pair<std::string, std::function<void()>>> pendingPhases_;
+    std::vector<StartupPhaseRecord> records_;
+    std::shared_ptr<AppExecFwk::EventHandler> startupHandler_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // CELLULAR_DATA_STARTUP_H
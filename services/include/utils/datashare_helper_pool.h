@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASHARE_HELPER_POOL_H
+#define DATASHARE_HELPER_POOL_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "datashare_helper.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int64_t DATASHARE_HELPER_IDLE_TIMEOUT_MS = 30 * 1000;
+static constexpr int DATASHARE_HELPER_DEFAULT_WAIT_TIME = 2;
+
+struct DataShareHelperPoolStats {
+    uint64_t createCount = 0;
+    uint64_t createFailCount = 0;
+    uint64_t reuseCount = 0;
+    uint64_t discardCount = 0;
+    uint64_t idleCloseCount = 0;
+};
+
+/**
+ * Keeps one long-lived DataShareHelper and leases it to callers
+ *
+ * Creating a helper looks up the system ability and connects to the data provider, which used to be done for every
+ * single statement. A lease is a shared_ptr to the pooled helper, dropping it returns the helper to the pool, so
+ * callers must not Release() it. The helper is released once it has not been leased for the idle timeout. A caller
+ * which sees a failure that may come from a dead provider discards its lease, the next Acquire() reconnects.
+ */
+class DataShareHelperPool : public std::enable_shared_from_this<DataShareHelperPool> {
+public:
+    using Creator = std::function<std::shared_ptr<DataShare::DataShareHelper>(int waitTime)>;
+
+    DataShareHelperPool(const std::string &name, const Creator &creator,
+        int64_t idleTimeoutMs = DATASHARE_HELPER_IDLE_TIMEOUT_MS);
+    ~DataShareHelperPool();
+    std::shared_ptr<DataShare::DataShareHelper> Acquire(int waitTime = DATASHARE_HELPER_DEFAULT_WAIT_TIME);
+    void Discard(const std::shared_ptr<DataShare::DataShareHelper> &lease);
+    void Clear();
+    DataShareHelperPoolStats GetStats();
+    void Dump(std::string &result);
+
+private:
+    void ReturnLease(const std::shared_ptr<DataShare::DataShareHelper> &helper);
+    bool DropLeaseLocked(const std::shared_ptr<DataShare::DataShareHelper> &helper);
+    void ScheduleIdleCheckLocked(int64_t delayMs);
+    void CheckIdle();
+    static int64_t GetSteadyTimeMs();
+
+private:
+    std::mutex mutex_;
+    std::string name_;
+    Creator creator_;
+    int64_t idleTimeoutMs_;
+    std::shared_ptr<DataShare::DataShareHelper> helper_;
+    std::unordered_map<DataShare::DataShareHelper *, uint32_t> leaseCounts_;
+    int64_t lastReturnMs_ = 0;
+    bool idleCheckPending_ = false;
+    DataShareHelperPoolStats stats_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // DATASHARE_HELPER_POOL_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LAZY_SYMBOL_H
+#define LAZY_SYMBOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Resolution statistics of the symbols bound to one extension library
+ */
+class LazySymbolStats {
+public:
+    void Record(bool found, int64_t costUs);
+    uint32_t GetResolvedCount() const;
+    uint32_t GetMissingCount() const;
+    int64_t GetResolveTimeUs() const;
+    void Dump(const std::string &name, std::string &result) const;
+
+private:
+    std::atomic<uint32_t> resolvedCount_ { 0 };
+    std::atomic<uint32_t> missingCount_ { 0 };
+    std::atomic<int64_t> resolveTimeUs_ { 0 };
+};
+
+void *ResolveLazySymbol(void *handle, const char *name, LazySymbolStats *stats);
+
+/**
+ * Function pointer of an extension library which is looked up on first use
+ *
+ * Bind() only remembers the library handle and the symbol name, the dlsym() runs the first time the pointer is
+ * read. A missing symbol is cached as nullptr, so it is looked up once. The object reads like the plain function
+ * pointer it replaces: it can be tested, called and compared with nullptr, and assigning a function pointer
+ * overrides the resolved value.
+ */
+template <typename Fn>
+class LazySymbol {
+public:
+    LazySymbol() = default;
+    ~LazySymbol() = default;
+
+    LazySymbol(const LazySymbol &other) : fn_(other.Get()), state_(State::RESOLVED) {}
+
+    LazySymbol &operator=(const LazySymbol &other)
+    {
+        if (this != &other) {
+            Set(other.Get());
+        }
+        return *this;
+    }
+
+    LazySymbol &operator=(Fn fn)
+    {
+        Set(fn);
+        return *this;
+    }
+
+    void Bind(void *handle, const char *name, LazySymbolStats *stats)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handle_ = handle;
+        name_ = name;
+        stats_ = stats;
+        fn_.store(nullptr, std::memory_order_relaxed);
+        state_.store(State::BOUND, std::memory_order_release);
+    }
+
+    Fn Get() const
+    {
+        if (state_.load(std::memory_order_acquire) != State::BOUND) {
+            return fn_.load(std::memory_order_acquire);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_.load(std::memory_order_relaxed) == State::BOUND) {
+            fn_.store(reinterpret_cast<Fn>(ResolveLazySymbol(handle_, name_, stats_)), std::memory_order_relaxed);
+            state_.store(State::RESOLVED, std::memory_order_release);
+        }
+        return fn_.load(std::memory_order_relaxed);
+    }
+
+    operator Fn() const
+    {
+        return Get();
+    }
+
+private:
+    enum class State : uint8_t {
+        UNBOUND,
+        BOUND,
+        RESOLVED,
+    };
+
+    void Set(Fn fn)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_.store(fn, std::memory_order_relaxed);
+        state_.store(State::RESOLVED, std::memory_order_release);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    mutable std::atomic<Fn> fn_ { nullptr };
+    mutable std::atomic<State> state_ { State::UNBOUND };
+    void *handle_ = nullptr;
+    const char *name_ = nullptr;
+    LazySymbolStats *stats_ = nullptr;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // LAZY_SYMBOL_H
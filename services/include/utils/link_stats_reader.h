@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LINK_STATS_READER_H
+#define LINK_STATS_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace OHOS {
+namespace Telephony {
+struct LinkStats {
+    int64_t txPackets = 0;
+    int64_t rxPackets = 0;
+    int64_t txBytes = 0;
+    int64_t rxBytes = 0;
+};
+
+/**
+ * Reads the 64-bit counters of all links with a single rtnetlink RTM_GETSTATS dump
+ *
+ * Reading sysfs costs a file open per counter and interface, one dump covers every pdp context at once.
+ */
+class LinkStatsReader {
+public:
+    /**
+     * Dump the counters of all links
+     *
+     * @param stats counters keyed by interface index
+     * @return 0 on success, else the errno of the failed step
+     */
+    static int32_t ReadAll(std::map<int32_t, LinkStats> &stats);
+
+    /**
+     * Parse one received chunk of a RTM_GETSTATS dump
+     *
+     * @param data received netlink messages
+     * @param size size of data
+     * @param seq sequence number of the request
+     * @param stats counters keyed by interface index
+     * @param done set when NLMSG_DONE has been seen
+     * @return 0 on success, else the errno of the failed step
+     */
+    static int32_t ParseDump(const uint8_t *data, size_t size, uint32_t seq,
+        std::map<int32_t, LinkStats> &stats, bool &done);
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // LINK_STATS_READER_H
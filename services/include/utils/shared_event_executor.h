@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SHARED_EVENT_EXECUTOR_H
+#define SHARED_EVENT_EXECUTOR_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int32_t SHARED_EXECUTOR_THREAD_NUM = 2;
+
+struct SharedExecutorStats {
+    uint32_t handlerCount = 0;
+    uint32_t sharedRunnerCount = 0;
+    uint64_t eventCount = 0;
+    int64_t totalWaitUs = 0;
+    int64_t maxWaitUs = 0;
+};
+
+/**
+ * Opt-in set of event runners shared by the state machines of all slots
+ *
+ * Every state machine handler owns a runner of its own by default, with a dozen apn types active on two slots that is
+ * a few dozen runners which mostly sleep. Once persist.telephony.cellular_data.shared_executor is set, a handler is
+ * moved onto the least loaded of a few shared runners instead. A handler stays on that runner for its whole life, so
+ * its events keep their order. The wait of the events handled on a shared runner is recorded for the dump, the
+ * default mode records nothing.
+ */
+class SharedEventExecutor {
+public:
+    static SharedEventExecutor &GetInstance();
+    bool IsEnabled() const;
+    std::shared_ptr<AppExecFwk::EventRunner> AcquireRunner();
+    void ReleaseRunner(const std::shared_ptr<AppExecFwk::EventRunner> &runner);
+    void RecordEvent(const AppExecFwk::InnerEvent::Pointer &event);
+    SharedExecutorStats GetStats();
+    void ResetStats();
+    void Dump(std::string &result);
+
+private:
+    SharedEventExecutor();
+    ~SharedEventExecutor() = default;
+    std::shared_ptr<AppExecFwk::EventRunner> AcquireRunnerLocked();
+
+private:
+    std::mutex mutex_;
+    bool enabled_ = false;
+    std::array<std::shared_ptr<AppExecFwk::EventRunner>, SHARED_EXECUTOR_THREAD_NUM> runners_;
+    std::array<uint32_t, SHARED_EXECUTOR_THREAD_NUM> runnerLoads_ {};
+    uint32_t handlerCount_ = 0;
+    std::atomic<uint64_t> eventCount_ { 0 };
+    std::atomic<int64_t> totalWaitUs_ { 0 };
+    std::atomic<int64_t> maxWaitUs_ { 0 };
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // SHARED_EVENT_EXECUTOR_H
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "apn_activate_stats.h"
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+ApnActivateStats::ApnActivateStats()
+{
+    SetKeepPeriod(KEEP_APN_ACTIVATE_PERIOD);
+}
+
+void ApnActivateStats::SetKeepPeriod(uint32_t keepPeriodMs)
+{
+    if (keepPeriodMs == 0) {
+        TELEPHONY_LOGE("invalid keep period, use default %{public}u", KEEP_APN_ACTIVATE_PERIOD);
+        keepPeriodMs = KEEP_APN_ACTIVATE_PERIOD;
+    }
+    keepPeriodMs_ = keepPeriodMs;
+    bucketWidthMs_ = static_cast<int64_t>((keepPeriodMs + APN_ACTIVATE_BUCKET_NUM - 1) / APN_ACTIVATE_BUCKET_NUM);
+    Clear();
+}
+
+uint32_t ApnActivateStats::GetKeepPeriod() const
+{
+    return keepPeriodMs_;
+}
+
+void ApnActivateStats::Clear()
+{
+    for (ApnWindow &window : apnWindows_) {
+        window = ApnWindow();
+    }
+}
+
+void ApnActivateStats::Record(const ApnActivateInfo &info)
+{
+    if (info.apnId >= APN_ACTIVATE_STATS_APN_NUM) {
+        return;
+    }
+    ApnWindow &window = apnWindows_[info.apnId];
+    int64_t nowMs = static_cast<int64_t>(info.actSuccTime);
+    Expire(window, nowMs);
+    int64_t epoch = nowMs / bucketWidthMs_;
+    ActivateBucket &bucket = window.buckets[static_cast<size_t>(epoch) % APN_ACTIVATE_BUCKET_NUM];
+    if (bucket.epoch != epoch) {
+        bucket = ActivateBucket();
+        bucket.epoch = epoch;
+    }
+    bucket.actTimes++;
+    bucket.totalDuration += info.duration;
+    window.actTimes++;
+    window.totalDuration += info.duration;
+    if (info.reason == 0) {
+        bucket.actSuccTimes++;
+        window.actSuccTimes++;
+        return;
+    }
+    AddCause(bucket.causes, info.reason, 1);
+    AddCause(window.causes, info.reason, 1);
+}
+
+ApnActivateReportInfo ApnActivateStats::GetReportInfo(uint32_t apnId, int64_t nowMs)
+{
+    ApnActivateReportInfo info = { 0, 0, 0, 0 };
+    if (apnId >= APN_ACTIVATE_STATS_APN_NUM) {
+        return info;
+    }
+    ApnWindow &window = apnWindows_[apnId];
+    Expire(window, nowMs);
+    info.actTimes = window.actTimes;
+    info.actSuccTimes = window.actSuccTimes;
+    info.averDuration = window.actSuccTimes == 0 ? 0 :
+        static_cast<uint32_t>(window.totalDuration / window.actSuccTimes);
+    uint32_t topReasonCnt = 0;
+    for (const CauseCount &cause : window.causes) {
+        if (cause.count > topReasonCnt || (cause.count == topReasonCnt && cause.count > 0 &&
+            cause.reason < info.topReason)) {
+            info.topReason = cause.reason;
+            topReasonCnt = cause.count;
+        }
+    }
+    return info;
+}
+
+void ApnActivateStats::Expire(ApnWindow &window, int64_t nowMs)
+{
+    int64_t currentEpoch = nowMs / bucketWidthMs_;
+    for (ActivateBucket &bucket : window.buckets) {
+        if (bucket.epoch < 0) {
+            continue;
+        }
+        // A bucket from the future means the wall clock has been set back, drop it as well.
+        if (currentEpoch - bucket.epoch < static_cast<int64_t>(APN_ACTIVATE_BUCKET_NUM) &&
+            bucket.epoch <= currentEpoch) {
+            continue;
+        }
+        window.actTimes -= bucket.actTimes;
+        window.actSuccTimes -= bucket.actSuccTimes;
+        window.totalDuration -= bucket.totalDuration;
+        for (const CauseCount &cause : bucket.causes) {
+            RemoveCause(window.causes, cause.reason, cause.count);
+        }
+        bucket = ActivateBucket();
+    }
+}
+
+void ApnActivateStats::AddCause(
+    std::array<CauseCount, APN_ACTIVATE_CAUSE_NUM> &causes, uint32_t reason, uint32_t count)
+{
+    CauseCount *minCause = &causes[0];
+    for (CauseCount &cause : causes) {
+        if (cause.count > 0 && cause.reason == reason) {
+            cause.count += count;
+            return;
+        }
+        if (cause.count < minCause->count) {
+            minCause = &cause;
+        }
+    }
+    minCause->reason = reason;
+    minCause->count += count;
+}
+
+void ApnActivateStats::RemoveCause(
+    std::array<CauseCount, APN_ACTIVATE_CAUSE_NUM> &causes, uint32_t reason, uint32_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    for (CauseCount &cause : causes) {
+        if (cause.count > 0 && cause.reason == reason) {
+            cause.count = cause.count > count ? cause.count - count : 0;
+            return;
+        }
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
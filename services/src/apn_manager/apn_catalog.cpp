@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "apn_catalog.h"
+
+namespace OHOS {
+namespace Telephony {
+ApnCatalog::ApnCatalog(std::vector<sptr<ApnItem>> apnItems) : apnItems_(std::move(apnItems))
+{
+    for (const sptr<ApnItem> &apnItem : apnItems_) {
+        if (apnItem == nullptr) {
+            continue;
+        }
+        // The first item of a profile id wins, as the linear lookups used to stop at it.
+        profileIdIndex_.emplace(apnItem->attr_.profileId_, apnItem);
+        uint32_t typesMask = apnItem->GetTypesMask();
+        for (size_t bit = 0; bit < APN_TYPE_BIT_NUM; bit++) {
+            if ((typesMask & (1u << bit)) != 0) {
+                typeBuckets_[bit].push_back(apnItem);
+            }
+        }
+        if (apnItem->CanDealWithType(DATA_CONTEXT_ROLE_ALL)) {
+            typeBuckets_[APN_TYPE_BUCKET_ALL].push_back(apnItem);
+        }
+    }
+    if (apnItems_.empty()) {
+        return;
+    }
+    attachApnItem_ = GetFirstApnItemByType(DATA_CONTEXT_ROLE_IA);
+    if (attachApnItem_ == nullptr) {
+        attachApnItem_ = GetFirstApnItemByType(DATA_CONTEXT_ROLE_DEFAULT);
+    }
+    if (attachApnItem_ == nullptr) {
+        attachApnItem_ = apnItems_[0];
+    }
+}
+
+const std::vector<sptr<ApnItem>> &ApnCatalog::GetAllApnItem() const
+{
+    return apnItems_;
+}
+
+bool ApnCatalog::IsEmpty() const
+{
+    return apnItems_.empty();
+}
+
+sptr<ApnItem> ApnCatalog::GetApnItemById(int32_t profileId) const
+{
+    auto it = profileIdIndex_.find(profileId);
+    if (it == profileIdIndex_.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+std::vector<sptr<ApnItem>> ApnCatalog::GetApnItemsByType(const std::string &apnType) const
+{
+    size_t index = 0;
+    if (GetTypeBucketIndex(apnType, index)) {
+        return typeBuckets_[index];
+    }
+    std::vector<sptr<ApnItem>> apnItems;
+    for (const sptr<ApnItem> &apnItem : apnItems_) {
+        if (apnItem != nullptr && apnItem->CanDealWithType(apnType)) {
+            apnItems.push_back(apnItem);
+        }
+    }
+    return apnItems;
+}
+
+sptr<ApnItem> ApnCatalog::GetFirstApnItemByType(const std::string &apnType) const
+{
+    size_t index = 0;
+    if (GetTypeBucketIndex(apnType, index)) {
+        return typeBuckets_[index].empty() ? nullptr : typeBuckets_[index][0];
+    }
+    for (const sptr<ApnItem> &apnItem : apnItems_) {
+        if (apnItem != nullptr && apnItem->CanDealWithType(apnType)) {
+            return apnItem;
+        }
+    }
+    return nullptr;
+}
+
+sptr<ApnItem> ApnCatalog::GetAttachApnItem() const
+{
+    return attachApnItem_;
+}
+
+bool ApnCatalog::GetTypeBucketIndex(const std::string &apnType, size_t &index)
+{
+    uint32_t typeMask = ApnItem::FindApnTypeMask(apnType);
+    if (typeMask == static_cast<uint32_t>(ApnTypes::NONETYPE)) {
+        return false;
+    }
+    if (typeMask == static_cast<uint32_t>(ApnTypes::ALL)) {
+        index = APN_TYPE_BUCKET_ALL;
+        return true;
+    }
+    index = 0;
+    while ((typeMask >>= 1) != 0) {
+        index++;
+    }
+    return true;
+}
+} // namespace Telephony
+} // namespace OHOS
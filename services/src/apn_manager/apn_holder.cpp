@@ -206,25 +206,7 @@ bool ApnHolder::IsSameApnItem(const sptr<ApnItem> &newApnItem,
         TELEPHONY_LOGE("newApnItem or oldApnItem is null");
         return false;
     }
-    bool isSameProtocol = false;
-    if (roamingState) {
-        isSameProtocol = std::strcmp(newApnItem->attr_.roamingProtocol_, oldApnItem->attr_.roamingProtocol_) == 0;
-    } else {
-        isSameProtocol = std::strcmp(newApnItem->attr_.protocol_, oldApnItem->attr_.protocol_) == 0;
-    }
-    return isSameProtocol && newApnItem->attr_.profileId_ == oldApnItem->attr_.profileId_ &&
-        newApnItem->attr_.authType_ == oldApnItem->attr_.authType_ &&
-        newApnItem->attr_.isRoamingApn_ == oldApnItem->attr_.isRoamingApn_ &&
-        newApnItem->attr_.isEdited_ == oldApnItem->attr_.isEdited_ &&
-        std::strcmp(newApnItem->attr_.types_, oldApnItem->attr_.types_) == 0 &&
-        std::strcmp(newApnItem->attr_.numeric_, oldApnItem->attr_.numeric_) == 0 &&
-        std::strcmp(newApnItem->attr_.apn_, oldApnItem->attr_.apn_) == 0 &&
-        std::strcmp(newApnItem->attr_.apnName_, oldApnItem->attr_.apnName_) == 0 &&
-        std::strcmp(newApnItem->attr_.user_, oldApnItem->attr_.user_) == 0 &&
-        std::strcmp(newApnItem->attr_.password_, oldApnItem->attr_.password_) == 0 &&
-        std::strcmp(newApnItem->attr_.homeUrl_, oldApnItem->attr_.homeUrl_) == 0 &&
-        std::strcmp(newApnItem->attr_.proxyIpAddress_, oldApnItem->attr_.proxyIpAddress_) == 0 &&
-        std::strcmp(newApnItem->attr_.mmsIpAddress_, oldApnItem->attr_.mmsIpAddress_) == 0;
+    return newApnItem->HasSameProtocol(*oldApnItem, roamingState) && newApnItem->HasSameAttr(*oldApnItem);
 }
 
 bool ApnHolder::IsCompatibleApnItem(const sptr<ApnItem> &newApnItem, const sptr<ApnItem> &oldApnItem,
@@ -234,22 +216,7 @@ bool ApnHolder::IsCompatibleApnItem(const sptr<ApnItem> &newApnItem, const sptr<
         TELEPHONY_LOGE("newApnItem or oldApnItem is null");
         return false;
     }
-    bool isSameProtocol = false;
-    if (roamingState) {
-        isSameProtocol = std::strcmp(newApnItem->attr_.roamingProtocol_, oldApnItem->attr_.roamingProtocol_) == 0;
-    } else {
-        isSameProtocol = std::strcmp(newApnItem->attr_.protocol_, oldApnItem->attr_.protocol_) == 0;
-    }
-    return isSameProtocol && newApnItem->attr_.profileId_ == oldApnItem->attr_.profileId_ &&
-        newApnItem->attr_.authType_ == oldApnItem->attr_.authType_ &&
-        std::strcmp(newApnItem->attr_.types_, oldApnItem->attr_.types_) == 0 &&
-        std::strcmp(newApnItem->attr_.numeric_, oldApnItem->attr_.numeric_) == 0 &&
-        std::strcmp(newApnItem->attr_.apn_, oldApnItem->attr_.apn_) == 0 &&
-        std::strcmp(newApnItem->attr_.apnName_, oldApnItem->attr_.apnName_) == 0 &&
-        std::strcmp(newApnItem->attr_.user_, oldApnItem->attr_.user_) == 0 &&
-        std::strcmp(newApnItem->attr_.password_, oldApnItem->attr_.password_) == 0 &&
-        std::strcmp(newApnItem->attr_.proxyIpAddress_, oldApnItem->attr_.proxyIpAddress_) == 0 &&
-        std::strcmp(newApnItem->attr_.mmsIpAddress_, oldApnItem->attr_.mmsIpAddress_) == 0;
+    return newApnItem->HasSameProtocol(*oldApnItem, roamingState) && newApnItem->HasCompatibleAttr(*oldApnItem);
 }
 
 void ApnHolder::SetApnBadState(bool isBad)
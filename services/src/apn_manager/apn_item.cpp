@@ -12,12 +12,43 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
 #include "cellular_data_utils.h"
 #include "pdp_profile_data.h"
+#include "telephony_common_utils.h"
 
 namespace OHOS {
 namespace Telephony {
-ApnItem::ApnItem() = default;
+static constexpr uint64_t FINGERPRINT_OFFSET_BASIS = 14695981039346656037ULL;
+static constexpr uint64_t FINGERPRINT_PRIME = 1099511628211ULL;
+static constexpr int32_t DEC_RADIX = 10;
+static const std::unordered_map<std::string, ApnTypes> APN_TYPE_MASK_MAP {
+    {DATA_CONTEXT_ROLE_ALL, ApnTypes::ALL},
+    {DATA_CONTEXT_ROLE_DEFAULT, ApnTypes::DEFAULT},
+    {DATA_CONTEXT_ROLE_MMS, ApnTypes::MMS},
+    {DATA_CONTEXT_ROLE_SUPL, ApnTypes::SUPL},
+    {DATA_CONTEXT_ROLE_DUN, ApnTypes::DUN},
+    {DATA_CONTEXT_ROLE_IMS, ApnTypes::IMS},
+    {DATA_CONTEXT_ROLE_IA, ApnTypes::IA},
+    {DATA_CONTEXT_ROLE_EMERGENCY, ApnTypes::EMERGENCY},
+    {DATA_CONTEXT_ROLE_XCAP, ApnTypes::XCAP},
+    {DATA_CONTEXT_ROLE_BIP, ApnTypes::BIP},
+    {DATA_CONTEXT_ROLE_INTERNAL_DEFAULT, ApnTypes::INTERNAL_DEFAULT},
+    {DATA_CONTEXT_ROLE_SNSSAI1, ApnTypes::SNSSAI1},
+    {DATA_CONTEXT_ROLE_SNSSAI2, ApnTypes::SNSSAI2},
+    {DATA_CONTEXT_ROLE_SNSSAI3, ApnTypes::SNSSAI3},
+    {DATA_CONTEXT_ROLE_SNSSAI4, ApnTypes::SNSSAI4},
+    {DATA_CONTEXT_ROLE_SNSSAI5, ApnTypes::SNSSAI5},
+    {DATA_CONTEXT_ROLE_SNSSAI6, ApnTypes::SNSSAI6}
+};
+
+ApnItem::ApnItem()
+{
+    UpdateDerivedFields();
+}
 
 ApnItem::~ApnItem() = default;
 
@@ -38,14 +69,18 @@ bool ApnItem::IsBadApn() const
 
 bool ApnItem::CanDealWithType(const std::string &type) const
 {
+    uint32_t typeMask = FindApnTypeMask(type);
+    if (typeMask == static_cast<uint32_t>(ApnTypes::ALL)) {
+        return isAllType_;
+    }
+    if (typeMask != static_cast<uint32_t>(ApnTypes::NONETYPE)) {
+        return (typesMask_ & typeMask) != 0;
+    }
     for (std::string apnType : apnTypes_) {
         transform(apnType.begin(), apnType.end(), apnType.begin(), ::tolower);
         if (type == apnType) {
             return true;
         }
-        if (type == DATA_CONTEXT_ROLE_INTERNAL_DEFAULT && apnType == DATA_CONTEXT_ROLE_DEFAULT) {
-            return true;
-        }
         if ((type != DATA_CONTEXT_ROLE_IA) && (apnType == DATA_CONTEXT_ROLE_ALL)) {
             return true;
         }
@@ -60,22 +95,27 @@ sptr<ApnItem> ApnItem::MakeDefaultApn(const std::string &apnType)
         TELEPHONY_LOGE("apn is null");
         return nullptr;
     }
-    Attribute attr = {"", "46002", DATA_PROFILE_DEFAULT, "IPV4V6", "IPV4V6",
-        DEFAULT_AUTH_TYPE, "cmnet", "CMNET", "", "", false, "", "", "", false, "", 0, "", 0, 0};
-    apnItem->apnTypes_ = CellularDataUtils::Split(apnType, ",");
-    apnItem->attr_ = attr;
-    if (strcpy_s(apnItem->attr_.types_, ALL_APN_ITEM_CHAR_LENGTH, apnType.c_str()) != EOK) {
+    apnItem->SetApnTypes(apnType);
+    apnItem->attr_.numeric_ = "46002";
+    apnItem->attr_.profileId_ = DATA_PROFILE_DEFAULT;
+    apnItem->attr_.protocol_ = "IPV4V6";
+    apnItem->attr_.roamingProtocol_ = "IPV4V6";
+    apnItem->attr_.authType_ = DEFAULT_AUTH_TYPE;
+    apnItem->attr_.apn_ = "cmnet";
+    apnItem->attr_.apnName_ = "CMNET";
+    if (!SetAttrString(apnItem->attr_.types_, apnType)) {
         TELEPHONY_LOGE("types_ copy fail");
         return nullptr;
     }
     if (apnType == "mms") {
         std::string apn = "cmwap";
-        if (strcpy_s(apnItem->attr_.apn_, ALL_APN_ITEM_CHAR_LENGTH, apn.c_str()) != EOK) {
+        if (!SetAttrString(apnItem->attr_.apn_, apn)) {
             TELEPHONY_LOGE("types_ copy fail");
             return nullptr;
         }
     }
-    TELEPHONY_LOGI("type = %{public}s", apnItem->attr_.types_);
+    apnItem->UpdateDerivedFields();
+    TELEPHONY_LOGI("type = %{public}s", apnItem->attr_.types_.c_str());
     return apnItem;
 }
 
@@ -86,43 +126,42 @@ sptr<ApnItem> ApnItem::MakeApn(const PdpProfile &apnData)
         TELEPHONY_LOGE("apn is null");
         return nullptr;
     }
-    apnItem->apnTypes_ = CellularDataUtils::Split(apnData.apnTypes, ",");
+    apnItem->SetApnTypes(apnData.apnTypes);
     TELEPHONY_LOGI("MakeApn apnTypes_ = %{public}s", apnData.apnTypes.c_str());
     apnItem->attr_.profileId_ = apnData.profileId;
     apnItem->attr_.authType_ = apnData.authType;
     apnItem->attr_.isRoamingApn_ = apnData.isRoamingApn;
     apnItem->attr_.isEdited_ = apnData.edited;
-    if (strcpy_s(apnItem->attr_.types_, ALL_APN_ITEM_CHAR_LENGTH, apnData.apnTypes.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.types_, apnData.apnTypes)) {
         TELEPHONY_LOGE("types_ copy fail");
         return nullptr;
     }
     std::string numeric = apnData.mcc + apnData.mnc;
-    if (strcpy_s(apnItem->attr_.numeric_, ALL_APN_ITEM_CHAR_LENGTH, numeric.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.numeric_, numeric)) {
         TELEPHONY_LOGE("numeric_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.protocol_, ALL_APN_ITEM_CHAR_LENGTH, apnData.pdpProtocol.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.protocol_, apnData.pdpProtocol)) {
         TELEPHONY_LOGE("protocol_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.roamingProtocol_, ALL_APN_ITEM_CHAR_LENGTH,
-        apnData.roamPdpProtocol.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.roamingProtocol_, apnData.roamPdpProtocol)) {
         TELEPHONY_LOGE("roamingProtocol_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.apn_, ALL_APN_ITEM_CHAR_LENGTH, apnData.apn.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.apn_, apnData.apn)) {
         TELEPHONY_LOGE("apn_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.apnName_, ALL_APN_ITEM_CHAR_LENGTH, apnData.profileName.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.apnName_, apnData.profileName)) {
         TELEPHONY_LOGE("apnName_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.user_, ALL_APN_ITEM_CHAR_LENGTH, apnData.authUser.c_str()) != EOK) {
+    if (!SetCredentialString(apnItem->attr_.user_, apnData.authUser)) {
         TELEPHONY_LOGE("user_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.password_, ALL_APN_ITEM_CHAR_LENGTH, apnData.authPwd.c_str()) != EOK) {
+    if (!SetCredentialString(apnItem->attr_.password_, apnData.authPwd)) {
         TELEPHONY_LOGE("password_ copy fail");
         return nullptr;
     }
@@ -131,22 +170,239 @@ sptr<ApnItem> ApnItem::MakeApn(const PdpProfile &apnData)
 
 sptr<ApnItem> ApnItem::BuildOtherApnAttributes(sptr<ApnItem> &apnItem, const PdpProfile &apnData)
 {
-    if (strcpy_s(apnItem->attr_.homeUrl_, ALL_APN_ITEM_CHAR_LENGTH, apnData.homeUrl.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.homeUrl_, apnData.homeUrl)) {
         TELEPHONY_LOGE("homeUrl_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.proxyIpAddress_, ALL_APN_ITEM_CHAR_LENGTH, apnData.proxyIpAddress.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.proxyIpAddress_, apnData.proxyIpAddress)) {
         TELEPHONY_LOGE("proxyIpAddress_ copy fail");
         return nullptr;
     }
-    if (strcpy_s(apnItem->attr_.mmsIpAddress_, ALL_APN_ITEM_CHAR_LENGTH, apnData.mmsIpAddress.c_str()) != EOK) {
+    if (!SetAttrString(apnItem->attr_.mmsIpAddress_, apnData.mmsIpAddress)) {
         TELEPHONY_LOGE("mmsIpAddress_ copy fail");
         return nullptr;
     }
-    TELEPHONY_LOGI("The APN name is:%{public}s", apnItem->attr_.apnName_);
+    apnItem->UpdateDerivedFields();
+    TELEPHONY_LOGI("The APN name is:%{public}s", apnItem->attr_.apnName_.c_str());
     return apnItem;
 }
 
+bool ApnItem::SetAttrString(ApnString &attr, const std::string &value)
+{
+    if (value.length() >= ALL_APN_ITEM_CHAR_LENGTH) {
+        return false;
+    }
+    attr = value;
+    return true;
+}
+
+bool ApnItem::SetCredentialString(ApnString &attr, const std::string &value)
+{
+    if (value.length() >= ALL_APN_ITEM_CHAR_LENGTH) {
+        return false;
+    }
+    attr = ApnString::MakeUnpooled(value);
+    return true;
+}
+
+static void CopyAttrString(char *dest, const ApnString &src)
+{
+    if (strncpy_s(dest, ApnItem::ALL_APN_ITEM_CHAR_LENGTH, src.c_str(), ApnItem::ALL_APN_ITEM_CHAR_LENGTH - 1) != EOK) {
+        dest[0] = '\0';
+    }
+}
+
+void ApnItem::CompactAttribute::ToAttribute(Attribute &attr) const
+{
+    CopyAttrString(attr.types_, types_);
+    CopyAttrString(attr.numeric_, numeric_);
+    attr.profileId_ = profileId_;
+    CopyAttrString(attr.protocol_, protocol_);
+    CopyAttrString(attr.roamingProtocol_, roamingProtocol_);
+    attr.authType_ = authType_;
+    CopyAttrString(attr.apn_, apn_);
+    CopyAttrString(attr.apnName_, apnName_);
+    CopyAttrString(attr.user_, user_);
+    CopyAttrString(attr.password_, password_);
+    attr.isRoamingApn_ = isRoamingApn_;
+    CopyAttrString(attr.homeUrl_, homeUrl_);
+    CopyAttrString(attr.proxyIpAddress_, proxyIpAddress_);
+    CopyAttrString(attr.mmsIpAddress_, mmsIpAddress_);
+    attr.isEdited_ = isEdited_;
+    CopyAttrString(attr.snssai_, snssai_);
+    attr.sscMode_ = sscMode_;
+    CopyAttrString(attr.dnn_, dnn_);
+    attr.PduSessionType_ = PduSessionType_;
+    attr.RouteBitmap_ = RouteBitmap_;
+}
+
+void ApnItem::SetApnTypes(const std::string &apnTypes)
+{
+    apnTypes_ = CellularDataUtils::Split(apnTypes, ",");
+    typesMask_ = static_cast<uint32_t>(ApnTypes::NONETYPE);
+    isAllType_ = false;
+    for (std::string apnType : apnTypes_) {
+        transform(apnType.begin(), apnType.end(), apnType.begin(), ::tolower);
+        if (apnType == DATA_CONTEXT_ROLE_ALL) {
+            // "*" deals with every type except ia, but only a request of "*" itself matches it literally.
+            isAllType_ = true;
+            typesMask_ |= static_cast<uint32_t>(ApnTypes::ALL) & ~static_cast<uint32_t>(ApnTypes::IA);
+            continue;
+        }
+        typesMask_ |= FindApnTypeMask(apnType);
+        if (apnType == DATA_CONTEXT_ROLE_DEFAULT) {
+            typesMask_ |= static_cast<uint32_t>(ApnTypes::INTERNAL_DEFAULT);
+        }
+    }
+}
+
+uint32_t ApnItem::FindApnTypeMask(const std::string &apnType)
+{
+    auto it = APN_TYPE_MASK_MAP.find(apnType);
+    if (it == APN_TYPE_MASK_MAP.end()) {
+        return static_cast<uint32_t>(ApnTypes::NONETYPE);
+    }
+    return static_cast<uint32_t>(it->second);
+}
+
+ApnProtocolType ApnItem::ParseProtocol(const std::string &protocol)
+{
+    if (protocol.empty()) {
+        return ApnProtocolType::PROTOCOL_NONE;
+    }
+    if (protocol == PROTOCOL_IPV4) {
+        return ApnProtocolType::PROTOCOL_IPV4;
+    }
+    if (protocol == PROTOCOL_IPV6) {
+        return ApnProtocolType::PROTOCOL_IPV6;
+    }
+    if (protocol == PROTOCOL_IPV4V6) {
+        return ApnProtocolType::PROTOCOL_IPV4V6;
+    }
+    return ApnProtocolType::PROTOCOL_OTHER;
+}
+
+void ApnItem::ParseProxyAddress(const std::string &proxyIpAddress, std::string &host, uint16_t &port)
+{
+    size_t found = proxyIpAddress.find(':');
+    if (found == std::string::npos) {
+        host = proxyIpAddress;
+        return;
+    }
+    // More than one colon, e.g. a bare ipv6 address, is not a host:port pair and leaves both untouched.
+    if (proxyIpAddress.find(':', found + 1) != std::string::npos) {
+        return;
+    }
+    host = proxyIpAddress.substr(0, found);
+    std::string portStr = proxyIpAddress.substr(found + 1);
+    if (!portStr.empty() && IsValidDecValue(portStr)) {
+        port = static_cast<uint16_t>(std::strtol(portStr.c_str(), nullptr, DEC_RADIX));
+    }
+}
+
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t length)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= FINGERPRINT_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t HashAttrString(uint64_t hash, const ApnString &str)
+{
+    // Hash the terminator as well so that ("ab", "c") and ("a", "bc") differ.
+    return HashBytes(hash, str.c_str(), str.length() + 1);
+}
+
+void ApnItem::UpdateDerivedFields()
+{
+    protocolType_ = ParseProtocol(attr_.protocol_.c_str());
+    roamingProtocolType_ = ParseProtocol(attr_.roamingProtocol_.c_str());
+    proxyHost_ = "";
+    proxyPort_ = DEFAULT_PORT;
+    ParseProxyAddress(attr_.proxyIpAddress_.c_str(), proxyHost_, proxyPort_);
+    uint64_t hash = FINGERPRINT_OFFSET_BASIS;
+    hash = HashBytes(hash, &attr_.profileId_, sizeof(attr_.profileId_));
+    hash = HashBytes(hash, &attr_.authType_, sizeof(attr_.authType_));
+    hash = HashAttrString(hash, attr_.types_);
+    hash = HashAttrString(hash, attr_.numeric_);
+    hash = HashAttrString(hash, attr_.apn_);
+    hash = HashAttrString(hash, attr_.apnName_);
+    hash = HashAttrString(hash, attr_.user_);
+    hash = HashAttrString(hash, attr_.password_);
+    hash = HashAttrString(hash, attr_.proxyIpAddress_);
+    hash = HashAttrString(hash, attr_.mmsIpAddress_);
+    compatibleFingerprint_ = hash;
+    hash = HashAttrString(hash, attr_.homeUrl_);
+    hash = HashBytes(hash, &attr_.isRoamingApn_, sizeof(attr_.isRoamingApn_));
+    hash = HashBytes(hash, &attr_.isEdited_, sizeof(attr_.isEdited_));
+    fingerprint_ = hash;
+}
+
+uint32_t ApnItem::GetTypesMask() const
+{
+    return typesMask_;
+}
+
+ApnProtocolType ApnItem::GetProtocolType(bool roamingState) const
+{
+    return roamingState ? roamingProtocolType_ : protocolType_;
+}
+
+const std::string &ApnItem::GetProxyHost() const
+{
+    return proxyHost_;
+}
+
+uint16_t ApnItem::GetProxyPort() const
+{
+    return proxyPort_;
+}
+
+uint64_t ApnItem::GetFingerprint() const
+{
+    return fingerprint_;
+}
+
+bool ApnItem::HasSameProtocol(const ApnItem &other, bool roamingState) const
+{
+    ApnProtocolType protocolType = GetProtocolType(roamingState);
+    if (protocolType != other.GetProtocolType(roamingState)) {
+        return false;
+    }
+    if (protocolType != ApnProtocolType::PROTOCOL_OTHER) {
+        return true;
+    }
+    return roamingState ? attr_.roamingProtocol_.IsSame(other.attr_.roamingProtocol_) :
+        attr_.protocol_.IsSame(other.attr_.protocol_);
+}
+
+bool ApnItem::HasCompatibleAttr(const ApnItem &other) const
+{
+    // The fingerprint rejects most differing items at once, equal ones are confirmed field by field.
+    return compatibleFingerprint_ == other.compatibleFingerprint_ &&
+        attr_.profileId_ == other.attr_.profileId_ &&
+        attr_.authType_ == other.attr_.authType_ &&
+        attr_.types_.IsSame(other.attr_.types_) &&
+        attr_.numeric_.IsSame(other.attr_.numeric_) &&
+        attr_.apn_.IsSame(other.attr_.apn_) &&
+        attr_.apnName_.IsSame(other.attr_.apnName_) &&
+        attr_.user_.IsSame(other.attr_.user_) &&
+        attr_.password_.IsSame(other.attr_.password_) &&
+        attr_.proxyIpAddress_.IsSame(other.attr_.proxyIpAddress_) &&
+        attr_.mmsIpAddress_.IsSame(other.attr_.mmsIpAddress_);
+}
+
+bool ApnItem::HasSameAttr(const ApnItem &other) const
+{
+    return fingerprint_ == other.fingerprint_ && HasCompatibleAttr(other) &&
+        attr_.isRoamingApn_ == other.attr_.isRoamingApn_ &&
+        attr_.isEdited_ == other.attr_.isEdited_ &&
+        attr_.homeUrl_.IsSame(other.attr_.homeUrl_);
+}
+
 bool ApnItem::IsSimilarPdpProfile(const PdpProfile &newPdpProfile, const PdpProfile &oldPdpProfile)
 {
     if ((newPdpProfile.apnTypes.find(DATA_CONTEXT_ROLE_DEFAULT) != std::string::npos) &&
@@ -15,6 +15,8 @@
 
 #include "apn_manager.h"
 
+#include <unordered_map>
+
 #include "cellular_data_hisysevent.h"
 #include "core_manager_inner.h"
 #include "telephony_ext_wrapper.h"
@@ -42,25 +44,6 @@ const std::map<std::string, int32_t> ApnManager::apnIdApnNameMap_ {
     {DATA_CONTEXT_ROLE_SNSSAI5, DATA_CONTEXT_ROLE_SNSSAI5_ID},
     {DATA_CONTEXT_ROLE_SNSSAI6, DATA_CONTEXT_ROLE_SNSSAI6_ID}
 };
-const std::map<std::string, ApnTypes> ApnManager::apnNameApnTypeMap_ {
-    {DATA_CONTEXT_ROLE_ALL, ApnTypes::ALL},
-    {DATA_CONTEXT_ROLE_DEFAULT, ApnTypes::DEFAULT},
-    {DATA_CONTEXT_ROLE_MMS, ApnTypes::MMS},
-    {DATA_CONTEXT_ROLE_SUPL, ApnTypes::SUPL},
-    {DATA_CONTEXT_ROLE_DUN, ApnTypes::DUN},
-    {DATA_CONTEXT_ROLE_IMS, ApnTypes::IMS},
-    {DATA_CONTEXT_ROLE_IA, ApnTypes::IA},
-    {DATA_CONTEXT_ROLE_EMERGENCY, ApnTypes::EMERGENCY},
-    {DATA_CONTEXT_ROLE_XCAP, ApnTypes::XCAP},
-    {DATA_CONTEXT_ROLE_BIP, ApnTypes::BIP},
-    {DATA_CONTEXT_ROLE_INTERNAL_DEFAULT, ApnTypes::INTERNAL_DEFAULT},
-    {DATA_CONTEXT_ROLE_SNSSAI1, ApnTypes::SNSSAI1},
-    {DATA_CONTEXT_ROLE_SNSSAI2, ApnTypes::SNSSAI2},
-    {DATA_CONTEXT_ROLE_SNSSAI3, ApnTypes::SNSSAI3},
-    {DATA_CONTEXT_ROLE_SNSSAI4, ApnTypes::SNSSAI4},
-    {DATA_CONTEXT_ROLE_SNSSAI5, ApnTypes::SNSSAI5},
-    {DATA_CONTEXT_ROLE_SNSSAI6, ApnTypes::SNSSAI6}
-};
 const std::vector<ApnProfileState> ApnManager::apnStateArr_ = {
     PROFILE_STATE_CONNECTED,
     PROFILE_STATE_DISCONNECTING,
@@ -141,9 +124,9 @@ std::string ApnManager::FindApnNameByApnId(const int32_t id)
 
 int32_t ApnManager::FindApnTypeByApnName(const std::string &apnName)
 {
-    auto iter = apnNameApnTypeMap_.find(apnName);
-    if (iter != apnNameApnTypeMap_.end()) {
-        return static_cast<uint64_t>(iter->second);
+    uint32_t apnType = ApnItem::FindApnTypeMask(apnName);
+    if (apnType != static_cast<uint32_t>(ApnTypes::NONETYPE)) {
+        return apnType;
     }
     TELEPHONY_LOGI("ApnName %{public}s is not exist!", apnName.c_str());
     return static_cast<uint64_t>(ApnTypes::NONETYPE);
@@ -295,9 +278,7 @@ int32_t ApnManager::PushApnItem(int32_t count, int32_t slotId, sptr<ApnItem> ext
         TELEPHONY_LOGE("extraApnItem is null");
         return count;
     }
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    allApnItem_.clear();
-    allApnItem_.push_back(extraApnItem);
+    UpdateApnCatalog({ extraApnItem });
     CellularDataHiSysEvent::WriteApnInfoBehaviorEvent(slotId, extraApnItem);
     return ++count;
 }
@@ -305,17 +286,37 @@ int32_t ApnManager::PushApnItem(int32_t count, int32_t slotId, sptr<ApnItem> ext
 int32_t ApnManager::CreateAllApnItemByDatabase(int32_t slotId, std::string &errMsg)
 {
     int32_t count = 0;
+    if (CreateExtApnItem(slotId, count)) {
+        return count;
+    }
+    ApnSnapshot snapshot;
+    if (!LoadApnSnapshot(slotId, snapshot, errMsg)) {
+        ResetPreferId();
+        return count;
+    }
+    return CreateAllApnItemBySnapshot(slotId, snapshot);
+}
+
+bool ApnManager::CreateExtApnItem(int32_t slotId, int32_t &count)
+{
     sptr<ApnItem> extraApnItem = ApnItem::MakeDefaultApn("default");
     if (TELEPHONY_EXT_WRAPPER.createAllApnItemExt_) {
         if (TELEPHONY_EXT_WRAPPER.createAllApnItemExt_(slotId, extraApnItem)) {
-            return PushApnItem(count, slotId, extraApnItem);
+            count = PushApnItem(count, slotId, extraApnItem);
+            return true;
         }
     }
     if (TELEPHONY_EXT_WRAPPER.createDcApnItemExt_ &&
         TELEPHONY_EXT_WRAPPER.createDcApnItemExt_(slotId, extraApnItem)) {
         TELEPHONY_LOGI("create extra apn item");
-        return PushApnItem(count, slotId, extraApnItem);
+        count = PushApnItem(count, slotId, extraApnItem);
+        return true;
     }
+    return false;
+}
+
+bool ApnManager::LoadApnSnapshot(int32_t slotId, ApnSnapshot &snapshot, std::string &errMsg)
+{
     std::u16string operatorNumeric;
     CoreManagerInner::GetInstance().GetSimOperatorNumeric(slotId, operatorNumeric);
     std::string numeric = Str16ToStr8(operatorNumeric);
@@ -324,36 +325,118 @@ int32_t ApnManager::CreateAllApnItemByDatabase(int32_t slotId, std::string &errM
     if (numeric.empty()) {
         TELEPHONY_LOGE("numeric is empty!!!");
         errMsg = "numeric is empty";
-        return count;
+        return false;
     }
     // LCOV_EXCL_STOP
     TELEPHONY_LOGI("current slotId = %{public}d, numeric = %{public}s", slotId, numeric.c_str());
+    ApnQueryParam param;
+    if (!GetApnQueryParam(slotId, numeric, param, errMsg)) {
+        return false;
+    }
+    if (ApnSnapshotCache::GetInstance().Load(slotId, param, snapshot)) {
+        TELEPHONY_LOGI("Slot%{public}d: load %{public}zu apn profiles from snapshot", slotId, snapshot.profiles.size());
+        ValidateApnSnapshot(slotId, param, snapshot);
+        return true;
+    }
+    uint64_t generation = ApnSnapshotCache::GetInstance().GetGeneration(slotId);
+    if (!QueryApnProfiles(slotId, param, snapshot, errMsg)) {
+        return false;
+    }
+    if (!snapshot.profiles.empty()) {
+        ApnSnapshotCache::GetInstance().Store(slotId, param, snapshot, generation);
+    }
+    return true;
+}
+
+int32_t ApnManager::CreateAllApnItemBySnapshot(int32_t slotId, ApnSnapshot &snapshot)
+{
+    preferId_ = snapshot.preferId;
+    return MakeSpecificApnItem(snapshot.profiles, slotId);
+}
+
+void ApnManager::ClearApnItems()
+{
+    UpdateApnCatalog({});
+    ResetPreferId();
+    std::vector<sptr<ApnItem>> emptyApns;
+    for (const sptr<ApnHolder> &apnHolder : apnHolders_) {
+        if (apnHolder != nullptr) {
+            apnHolder->SetAllMatchedApns(emptyApns);
+        }
+    }
+}
+
+void ApnManager::ResetPreferId()
+{
     preferId_ = INVALID_PROFILE_ID;
-    if (!GetPreferId(slotId, errMsg)) {
-        return count;
+}
+
+bool ApnManager::GetApnQueryParam(int32_t slotId, const std::string &numeric, ApnQueryParam &param,
+    std::string &errMsg)
+{
+    param.simId = CoreManagerInner::GetInstance().GetSimId(slotId);
+    if (param.simId <= INVALID_SIM_ID) {
+        TELEPHONY_LOGE("Slot%{public}d: failed due to invalid sim id %{public}d", slotId, param.simId);
+        errMsg = "GetPreferId create failed due to invalid sim id";
+        return false;
     }
+    param.mcc = numeric.substr(0, DEFAULT_MCC_SIZE);
+    param.mnc = numeric.substr(param.mcc.size(), numeric.size() - param.mcc.size());
+    std::u16string opkey;
+    CoreManagerInner::GetInstance().GetOpKey(slotId, opkey);
+    param.opkey = Str16ToStr8(opkey);
+    GetMvnoQueryParam(slotId, param);
+    return true;
+}
+
+bool ApnManager::QueryApnProfiles(int32_t slotId, const ApnQueryParam &param, ApnSnapshot &snapshot,
+    std::string &errMsg)
+{
+    snapshot.preferId = INVALID_PROFILE_ID;
+    snapshot.profiles.clear();
+    if (!QueryPreferId(slotId, snapshot.preferId, errMsg)) {
+        return false;
+    }
+    if (QueryMvnoApnProfiles(slotId, param, snapshot.profiles) && !snapshot.profiles.empty()) {
+        return true;
+    }
+    snapshot.profiles.clear();
     auto helper = CellularDataRdbHelper::GetInstance();
     // LCOV_EXCL_START
     if (helper == nullptr) {
         TELEPHONY_LOGE("get cellularDataRdbHelper failed");
         errMsg = "CreateAllApnItemByDatabase get cellularDataRdbHelper failed";
-        return count;
+        return false;
     }
     // LCOV_EXCL_STOP
-    std::string mcc = numeric.substr(0, DEFAULT_MCC_SIZE);
-    std::string mnc = numeric.substr(mcc.size(), numeric.size() - mcc.size());
-    int32_t mvnoCount = CreateMvnoApnItems(slotId, mcc, mnc);
-    if (mvnoCount > 0) {
-        return mvnoCount;
-    }
-    std::vector<PdpProfile> apnVec;
-    // LCOV_EXCL_START
-    bool queryResult = helper->QueryApns(mcc, mnc, apnVec, slotId, errMsg);
-    if (!queryResult) {
-        return count;
+    return helper->QueryApns(param.mcc, param.mnc, snapshot.profiles, slotId, errMsg);
+}
+
+void ApnManager::ValidateApnSnapshot(int32_t slotId, const ApnQueryParam &param, const ApnSnapshot &snapshot)
+{
+    uint64_t generation = ApnSnapshotCache::GetInstance().GetGeneration(slotId);
+    bool posted = ApnSnapshotCache::GetInstance().PostValidateTask([slotId, param, snapshot, generation]() {
+        ApnSnapshot liveSnapshot;
+        std::string errMsg;
+        if (!QueryApnProfiles(slotId, param, liveSnapshot, errMsg)) {
+            TELEPHONY_LOGE("Slot%{public}d: validate apn snapshot failed, %{public}s", slotId, errMsg.c_str());
+            return;
+        }
+        if (ApnSnapshotCache::IsSameSnapshot(snapshot, liveSnapshot)) {
+            return;
+        }
+        // An emptied apn set or profiles with credentials can not be stored, drop the file so the reload queries.
+        TELEPHONY_LOGI("Slot%{public}d: apn snapshot is stale, reload apns", slotId);
+        if (liveSnapshot.profiles.empty() ||
+            !ApnSnapshotCache::GetInstance().Store(slotId, param, liveSnapshot, generation)) {
+            ApnSnapshotCache::GetInstance().Invalidate(slotId);
+        }
+        ApnSnapshotCache::GetInstance().NotifyStale(slotId);
+    });
+    if (!posted) {
+        // Without validation a stale snapshot could stick, make the next load query the database.
+        ApnSnapshotCache::GetInstance().Invalidate(slotId);
     }
-    // LCOV_EXCL_STOP
-    return MakeSpecificApnItem(apnVec, slotId);
 }
 
 void ApnManager::GetCTOperator(int32_t slotId, std::string &numeric)
@@ -386,38 +469,57 @@ void ApnManager::GetCTOperator(int32_t slotId, std::string &numeric)
 
 int32_t ApnManager::CreateMvnoApnItems(int32_t slotId, const std::string &mcc, const std::string &mnc)
 {
-    int32_t count = 0;
+    ApnQueryParam param;
+    param.mcc = mcc;
+    param.mnc = mnc;
+    GetMvnoQueryParam(slotId, param);
+    std::vector<PdpProfile> mvnoApnVec;
+    if (!QueryMvnoApnProfiles(slotId, param, mvnoApnVec)) {
+        return 0;
+    }
+    return MakeSpecificApnItem(mvnoApnVec, slotId);
+}
+
+void ApnManager::GetMvnoQueryParam(int32_t slotId, ApnQueryParam &param)
+{
+    std::u16string value;
+    CoreManagerInner::GetInstance().GetSimSpn(slotId, value);
+    param.spn = Str16ToStr8(value);
+    value.clear();
+    CoreManagerInner::GetInstance().GetIMSI(slotId, value);
+    param.imsi = Str16ToStr8(value);
+    value.clear();
+    CoreManagerInner::GetInstance().GetSimGid1(slotId, value);
+    param.gid1 = Str16ToStr8(value);
+    value.clear();
+    CoreManagerInner::GetInstance().GetSimIccId(slotId, value);
+    param.iccId = Str16ToStr8(value);
+}
+
+bool ApnManager::QueryMvnoApnProfiles(int32_t slotId, const ApnQueryParam &param, std::vector<PdpProfile> &mvnoApnVec)
+{
     auto helper = CellularDataRdbHelper::GetInstance();
     if (helper == nullptr) {
         TELEPHONY_LOGE("get cellularDataRdbHelper failed");
-        return count;
+        return false;
     }
-    std::vector<PdpProfile> mvnoApnVec;
-    std::u16string spn;
-    CoreManagerInner::GetInstance().GetSimSpn(slotId, spn);
-    if (!helper->QueryMvnoApnsByType(mcc, mnc, MvnoType::SPN, Str16ToStr8(spn), mvnoApnVec, slotId)) {
+    if (!helper->QueryMvnoApnsByType(param.mcc, param.mnc, MvnoType::SPN, param.spn, mvnoApnVec, slotId)) {
         TELEPHONY_LOGE("query mvno apns by spn fail");
-        return count;
+        return false;
     }
-    std::u16string imsi;
-    CoreManagerInner::GetInstance().GetIMSI(slotId, imsi);
-    if (!helper->QueryMvnoApnsByType(mcc, mnc, MvnoType::IMSI, Str16ToStr8(imsi), mvnoApnVec, slotId)) {
+    if (!helper->QueryMvnoApnsByType(param.mcc, param.mnc, MvnoType::IMSI, param.imsi, mvnoApnVec, slotId)) {
         TELEPHONY_LOGE("query mvno apns by imsi fail");
-        return count;
+        return false;
     }
-    std::u16string gid1;
-    CoreManagerInner::GetInstance().GetSimGid1(slotId, gid1);
-    if (!helper->QueryMvnoApnsByType(mcc, mnc, MvnoType::GID1, Str16ToStr8(gid1), mvnoApnVec, slotId)) {
+    if (!helper->QueryMvnoApnsByType(param.mcc, param.mnc, MvnoType::GID1, param.gid1, mvnoApnVec, slotId)) {
         TELEPHONY_LOGE("query mvno apns by gid1 fail");
-        return count;
+        return false;
     }
-    std::u16string iccId;
-    CoreManagerInner::GetInstance().GetSimIccId(slotId, iccId);
-    if (!helper->QueryMvnoApnsByType(mcc, mnc, MvnoType::ICCID, Str16ToStr8(iccId), mvnoApnVec, slotId)) {
+    if (!helper->QueryMvnoApnsByType(param.mcc, param.mnc, MvnoType::ICCID, param.iccId, mvnoApnVec, slotId)) {
         TELEPHONY_LOGE("query mvno apns by iccId fail");
-        return count;
+        return false;
     }
-    return MakeSpecificApnItem(mvnoApnVec, slotId);
+    return true;
 }
 
 void ApnManager::ReportApnInfo(int32_t slotId, PdpProfile &apnData)
@@ -433,8 +535,7 @@ void ApnManager::ReportApnInfo(int32_t slotId, PdpProfile &apnData)
 
 int32_t ApnManager::MakeSpecificApnItem(std::vector<PdpProfile> &apnVec, int32_t slotId)
 {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    allApnItem_.clear();
+    std::vector<sptr<ApnItem>> allApnItem;
     TryMergeSimilarPdpProfile(apnVec);
     int32_t count = 0;
     for (PdpProfile &apnData : apnVec) {
@@ -446,21 +547,36 @@ int32_t ApnManager::MakeSpecificApnItem(std::vector<PdpProfile> &apnVec, int32_t
         ReportApnInfo(slotId, apnData);
         sptr<ApnItem> apnItem = ApnItem::MakeApn(apnData);
         if (apnItem != nullptr) {
-            allApnItem_.push_back(apnItem);
+            allApnItem.push_back(apnItem);
             count++;
         }
     }
     int32_t preferId = preferId_;
-    auto it = std::find_if(allApnItem_.begin(), allApnItem_.end(),
+    auto it = std::find_if(allApnItem.begin(), allApnItem.end(),
         [preferId](auto &apn) { return apn != nullptr && apn->attr_.profileId_ == preferId; });
-    if (it != allApnItem_.end()) {
+    if (it != allApnItem.end()) {
         sptr<ApnItem> apnItem = *it;
-        allApnItem_.erase(it);
-        allApnItem_.insert(allApnItem_.begin(), apnItem);
+        allApnItem.erase(it);
+        allApnItem.insert(allApnItem.begin(), apnItem);
     }
+    UpdateApnCatalog(std::move(allApnItem));
     return count;
 }
 
+std::shared_ptr<const ApnCatalog> ApnManager::GetApnCatalog()
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return apnCatalog_;
+}
+
+void ApnManager::UpdateApnCatalog(std::vector<sptr<ApnItem>> apnItems)
+{
+    // Build outside the lock, readers keep using the previous catalog until it is swapped.
+    auto apnCatalog = std::make_shared<const ApnCatalog>(std::move(apnItems));
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    apnCatalog_ = apnCatalog;
+}
+
 std::vector<sptr<ApnItem>> ApnManager::FilterMatchedApns(const std::string &requestApnType, const int32_t slotId)
 {
     std::vector<sptr<ApnItem>> matchApnItemList;
@@ -471,12 +587,7 @@ std::vector<sptr<ApnItem>> ApnManager::FilterMatchedApns(const std::string &requ
         FetchBipApns(matchApnItemList);
         return matchApnItemList;
     }
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    for (const sptr<ApnItem> &apnItem : allApnItem_) {
-        if (apnItem->CanDealWithType(requestApnType)) {
-            matchApnItemList.push_back(apnItem);
-        }
-    }
+    matchApnItemList = GetApnCatalog()->GetApnItemsByType(requestApnType);
     TELEPHONY_LOGD("apn size is :%{public}zu", matchApnItemList.size());
     return matchApnItemList;
 }
@@ -579,45 +690,26 @@ ApnProfileState ApnManager::GetOverallDefaultApnState() const
 
 sptr<ApnItem> ApnManager::GetRilAttachApn()
 {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    if (allApnItem_.empty()) {
+    std::shared_ptr<const ApnCatalog> apnCatalog = GetApnCatalog();
+    if (apnCatalog->IsEmpty()) {
         TELEPHONY_LOGE("apn item is null");
         return nullptr;
     }
     if (preferId_ != INVALID_PROFILE_ID) {
         TELEPHONY_LOGI("GetRilAttachApn use prefer apn");
-        return allApnItem_[0];
-    }
-    sptr<ApnItem> attachApn = nullptr;
-    for (const sptr<ApnItem> &apnItem : allApnItem_) {
-        if (apnItem->CanDealWithType(DATA_CONTEXT_ROLE_IA)) {
-            attachApn = apnItem;
-            break;
-        }
-        if (attachApn == nullptr && apnItem->CanDealWithType(DATA_CONTEXT_ROLE_DEFAULT)) {
-            attachApn = apnItem;
-        }
+        return apnCatalog->GetAllApnItem()[0];
     }
-    if (attachApn == nullptr) {
-        attachApn = allApnItem_[0];
-    }
-    return attachApn;
+    return apnCatalog->GetAttachApnItem();
 }
 
 sptr<ApnItem> ApnManager::GetApnItemById(const int32_t id)
 {
-    if (allApnItem_.empty()) {
+    std::shared_ptr<const ApnCatalog> apnCatalog = GetApnCatalog();
+    if (apnCatalog->IsEmpty()) {
         TELEPHONY_LOGE("apn item is null");
         return nullptr;
     }
-    sptr<ApnItem> attachApn = nullptr;
-    for (const sptr<ApnItem> &apnItem : allApnItem_) {
-        if (id == apnItem->attr_.profileId_) {
-            attachApn = apnItem;
-            break;
-        }
-    }
-    return attachApn;
+    return apnCatalog->GetApnItemById(id);
 }
 
 bool ApnManager::ResetApns(int32_t slotId)
@@ -632,12 +724,9 @@ bool ApnManager::ResetApns(int32_t slotId)
 
 void ApnManager::FetchBipApns(std::vector<sptr<ApnItem>> &matchApnItemList)
 {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    for (const sptr<ApnItem> &apnItem : allApnItem_) {
-        if (apnItem->CanDealWithType(DATA_CONTEXT_ROLE_BIP)) {
-            matchApnItemList.push_back(apnItem);
-            return;
-        }
+    sptr<ApnItem> bipApnItem = GetApnCatalog()->GetFirstApnItemByType(DATA_CONTEXT_ROLE_BIP);
+    if (bipApnItem != nullptr) {
+        matchApnItemList.push_back(bipApnItem);
     }
 }
 
@@ -648,39 +737,20 @@ void ApnManager::FetchDunApns(std::vector<sptr<ApnItem>> &matchApnItemList, cons
         TELEPHONY_LOGI("FetchDunApns: Dun apn is not used in roaming network");
         return;
     }
-    int32_t preferId = preferId_;
-    sptr<ApnItem> preferredApn = nullptr;
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    auto it = std::find_if(allApnItem_.begin(), allApnItem_.end(), [preferId](auto &apn) {
-        return apn != nullptr && apn->attr_.profileId_ == preferId;
-    });
-    if (it != allApnItem_.end()) {
-        preferredApn = *it;
-    }
+    std::shared_ptr<const ApnCatalog> apnCatalog = GetApnCatalog();
+    sptr<ApnItem> preferredApn = apnCatalog->GetApnItemById(preferId_);
     if (preferredApn != nullptr && preferredApn->CanDealWithType(DATA_CONTEXT_ROLE_DUN)) {
         matchApnItemList.insert(matchApnItemList.begin(), preferredApn);
     }
     if (matchApnItemList.empty()) {
-        for (const auto &item : allApnItem_) {
-            if (item->CanDealWithType(DATA_CONTEXT_ROLE_DUN)) {
-                matchApnItemList.push_back(item);
-            }
-        }
+        matchApnItemList = apnCatalog->GetApnItemsByType(DATA_CONTEXT_ROLE_DUN);
     }
 }
 
 bool ApnManager::IsPreferredApnUserEdited()
 {
-    bool isUserEdited = false;
-    int32_t preferId = preferId_;
-    std::shared_lock<std::shared_mutex> lock(mutex_);
-    auto it = std::find_if(allApnItem_.begin(), allApnItem_.end(), [preferId](auto &apn) {
-        return apn->attr_.profileId_ == preferId;
-    });
-    if (it != allApnItem_.end() && *it != nullptr) {
-        isUserEdited = (*it)->attr_.isEdited_;
-    }
-    return isUserEdited;
+    sptr<ApnItem> preferredApn = GetApnCatalog()->GetApnItemById(preferId_);
+    return preferredApn != nullptr && preferredApn->attr_.isEdited_;
 }
 
 void ApnManager::ClearAllApnBad()
@@ -692,15 +762,34 @@ void ApnManager::ClearAllApnBad()
     }
 }
 
+static std::string GetPdpProfileMergeKey(const PdpProfile &profile)
+{
+    // Fields IsSimilarPdpProfile requires to be equal, a key collision only costs an extra comparison.
+    return profile.apn + ',' + profile.mvnoType + ',' + profile.mvnoMatchData;
+}
+
 void ApnManager::TryMergeSimilarPdpProfile(std::vector<PdpProfile> &apnVec)
 {
     // coalesce similar APNs to prevent bringing up two data calls with same interface
+    // Merging never changes the key fields, so each profile is only compared with the later profiles of its bucket,
+    // the merges still happen in the order of a full pairwise scan.
+    std::unordered_map<std::string, std::vector<size_t>> buckets;
+    std::vector<const std::vector<size_t> *> profileBucket(apnVec.size(), nullptr);
+    std::vector<size_t> bucketPos(apnVec.size(), 0);
+    for (size_t i = 0; i < apnVec.size(); i++) {
+        std::vector<size_t> &bucket = buckets[GetPdpProfileMergeKey(apnVec[i])];
+        profileBucket[i] = &bucket;
+        bucketPos[i] = bucket.size();
+        bucket.push_back(i);
+    }
     std::vector<PdpProfile> newApnVec;
     for (size_t i = 0; i < apnVec.size(); i++) {
         if (apnVec[i].profileId == -1) {
             continue;
         }
-        for (size_t j = i + 1; j < apnVec.size(); j++) {
+        const std::vector<size_t> &bucket = *profileBucket[i];
+        for (size_t k = bucketPos[i] + 1; k < bucket.size(); k++) {
+            size_t j = bucket[k];
             if (ApnItem::IsSimilarPdpProfile(apnVec[i], apnVec[j])) {
                 MergePdpProfile(apnVec[i], apnVec[j]);
                 apnVec[j].profileId = -1;
@@ -770,6 +859,11 @@ uint64_t ApnManager::FindCapabilityByApnId(int32_t apnId)
 }
 
 bool ApnManager::GetPreferId(int32_t slotId, std::string &errMsg)
+{
+    return QueryPreferId(slotId, preferId_, errMsg);
+}
+
+bool ApnManager::QueryPreferId(int32_t slotId, int32_t &preferId, std::string &errMsg)
 {
     int32_t simId = CoreManagerInner::GetInstance().GetSimId(slotId);
     if (simId <= INVALID_SIM_ID) {
@@ -788,8 +882,8 @@ bool ApnManager::GetPreferId(int32_t slotId, std::string &errMsg)
     std::vector<PdpProfile> preferApnVec;
     if (helper->QueryPreferApn(slotId, preferApnVec, DB_CONNECT_MAX_WAIT_TIME)) {
         if (preferApnVec.size() > 0) {
-            preferId_ = preferApnVec[0].profileId;
-            TELEPHONY_LOGI("query preferId_ = %{public}d", preferId_);
+            preferId = preferApnVec[0].profileId;
+            TELEPHONY_LOGI("query preferId = %{public}d", preferId);
         } else {
             TELEPHONY_LOGI("query prefer apn is null");
         }
@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "apn_snapshot_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr uint32_t APN_SNAPSHOT_MAGIC = 0x534E5041; // "APNS"
+static constexpr uint32_t APN_SNAPSHOT_VERSION = 2;
+static constexpr uint32_t APN_SNAPSHOT_MAX_SIZE = 4 * 1024 * 1024;
+static constexpr uint32_t APN_SNAPSHOT_MAX_PROFILES = 4096;
+static constexpr uint64_t SNAPSHOT_HASH_OFFSET_BASIS = 14695981039346656037ULL;
+static constexpr uint64_t SNAPSHOT_HASH_PRIME = 1099511628211ULL;
+static constexpr mode_t APN_SNAPSHOT_DIR_MODE = 0700;
+static constexpr mode_t APN_SNAPSHOT_FILE_MODE = 0600;
+static const char *APN_SNAPSHOT_DEFAULT_DIR = "/data/service/el1/public/telephony/cellular_data";
+
+struct ApnSnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    int32_t preferId;
+    uint32_t profileCount;
+    uint32_t payloadSize;
+    uint32_t reserved;
+    uint64_t checksum;
+};
+
+// Credentials are never written to the snapshot, profiles which carry them are always read from the database.
+static std::string PdpProfile::* const SNAPSHOT_STRING_FIELDS[] = {
+    &PdpProfile::profileName, &PdpProfile::mcc, &PdpProfile::mnc, &PdpProfile::apn, &PdpProfile::apnTypes,
+    &PdpProfile::pdpProtocol, &PdpProfile::roamPdpProtocol, &PdpProfile::homeUrl, &PdpProfile::mmsIpAddress,
+    &PdpProfile::proxyIpAddress, &PdpProfile::mvnoType, &PdpProfile::mvnoMatchData, &PdpProfile::server
+};
+
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t length)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= SNAPSHOT_HASH_PRIME;
+    }
+    return hash;
+}
+
+static void WriteInt32(std::string &buffer, int32_t value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void WriteString(std::string &buffer, const std::string &value)
+{
+    uint32_t length = static_cast<uint32_t>(value.length());
+    buffer.append(reinterpret_cast<const char *>(&length), sizeof(length));
+    buffer.append(value);
+}
+
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+    bool ReadInt32(int32_t &value)
+    {
+        if (size_ - offset_ < sizeof(value)) {
+            return false;
+        }
+        std::copy(data_ + offset_, data_ + offset_ + sizeof(value), reinterpret_cast<uint8_t *>(&value));
+        offset_ += sizeof(value);
+        return true;
+    }
+    bool ReadString(std::string &value)
+    {
+        int32_t length = 0;
+        if (!ReadInt32(length) || length < 0 || size_ - offset_ < static_cast<size_t>(length)) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char *>(data_ + offset_), static_cast<size_t>(length));
+        offset_ += static_cast<size_t>(length);
+        return true;
+    }
+    bool IsEnd() const
+    {
+        return offset_ == size_;
+    }
+
+private:
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
+static bool ReadProfile(SnapshotReader &reader, PdpProfile &profile)
+{
+    int32_t profileId = 0;
+    int32_t authType = 0;
+    int32_t edited = 0;
+    int32_t isRoamingApn = 0;
+    int32_t bearingSystemType = 0;
+    if (!reader.ReadInt32(profileId) || !reader.ReadInt32(authType) || !reader.ReadInt32(edited) ||
+        !reader.ReadInt32(isRoamingApn) || !reader.ReadInt32(bearingSystemType)) {
+        return false;
+    }
+    profile.profileId = profileId;
+    profile.authType = authType;
+    profile.edited = edited;
+    profile.isRoamingApn = static_cast<decltype(profile.isRoamingApn)>(isRoamingApn);
+    profile.bearingSystemType = bearingSystemType;
+    for (std::string PdpProfile::* field : SNAPSHOT_STRING_FIELDS) {
+        if (!reader.ReadString(profile.*field)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ApnSnapshotCache &ApnSnapshotCache::GetInstance()
+{
+    static ApnSnapshotCache instance;
+    return instance;
+}
+
+uint64_t ApnSnapshotCache::MakeKey(const ApnQueryParam &param)
+{
+    uint64_t hash = HashBytes(SNAPSHOT_HASH_OFFSET_BASIS, &param.simId, sizeof(param.simId));
+    for (const std::string *str : { &param.mcc, &param.mnc, &param.opkey, &param.spn, &param.imsi, &param.gid1,
+        &param.iccId }) {
+        // Hash the terminator as well so that ("ab", "c") and ("a", "bc") differ.
+        hash = HashBytes(hash, str->c_str(), str->length() + 1);
+    }
+    return hash;
+}
+
+bool ApnSnapshotCache::IsSameSnapshot(const ApnSnapshot &left, const ApnSnapshot &right)
+{
+    if (left.preferId != right.preferId || left.profiles.size() != right.profiles.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < left.profiles.size(); ++i) {
+        const PdpProfile &l = left.profiles[i];
+        const PdpProfile &r = right.profiles[i];
+        if (l.profileId != r.profileId || l.authType != r.authType || l.edited != r.edited ||
+            l.isRoamingApn != r.isRoamingApn || l.bearingSystemType != r.bearingSystemType ||
+            l.authUser != r.authUser || l.authPwd != r.authPwd) {
+            return false;
+        }
+        for (std::string PdpProfile::* field : SNAPSHOT_STRING_FIELDS) {
+            if (l.*field != r.*field) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ApnSnapshotCache::HasCredential(const ApnSnapshot &snapshot)
+{
+    return std::any_of(snapshot.profiles.begin(), snapshot.profiles.end(), [](const PdpProfile &profile) {
+        return !profile.authUser.empty() || !profile.authPwd.empty();
+    });
+}
+
+static bool CreateSnapshotDir(const std::string &dir)
+{
+    for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+        std::string path = dir.substr(0, pos);
+        if (mkdir(path.c_str(), APN_SNAPSHOT_DIR_MODE) != 0 && errno != EEXIST) {
+            return false;
+        }
+        if (pos == std::string::npos) {
+            return true;
+        }
+    }
+}
+
+void ApnSnapshotCache::Serialize(uint64_t key, const ApnSnapshot &snapshot, std::string &buffer)
+{
+    std::string payload;
+    for (const PdpProfile &profile : snapshot.profiles) {
+        WriteInt32(payload, profile.profileId);
+        WriteInt32(payload, profile.authType);
+        WriteInt32(payload, profile.edited);
+        WriteInt32(payload, static_cast<int32_t>(profile.isRoamingApn));
+        WriteInt32(payload, profile.bearingSystemType);
+        for (std::string PdpProfile::* field : SNAPSHOT_STRING_FIELDS) {
+            WriteString(payload, profile.*field);
+        }
+    }
+    ApnSnapshotHeader header = {};
+    header.magic = APN_SNAPSHOT_MAGIC;
+    header.version = APN_SNAPSHOT_VERSION;
+    header.key = key;
+    header.preferId = snapshot.preferId;
+    header.profileCount = static_cast<uint32_t>(snapshot.profiles.size());
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    header.checksum = HashBytes(SNAPSHOT_HASH_OFFSET_BASIS, payload.data(), payload.size());
+    buffer.clear();
+    buffer.reserve(sizeof(header) + payload.size());
+    buffer.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    buffer.append(payload);
+}
+
+bool ApnSnapshotCache::Deserialize(const uint8_t *data, size_t size, uint64_t key, ApnSnapshot &snapshot)
+{
+    ApnSnapshotHeader header = {};
+    if (data == nullptr || size < sizeof(header)) {
+        return false;
+    }
+    std::copy(data, data + sizeof(header), reinterpret_cast<uint8_t *>(&header));
+    if (header.magic != APN_SNAPSHOT_MAGIC || header.version != APN_SNAPSHOT_VERSION) {
+        TELEPHONY_LOGI("apn snapshot version %{public}u mismatch", header.version);
+        return false;
+    }
+    if (header.key != key) {
+        TELEPHONY_LOGI("apn snapshot belongs to another sim or operator");
+        return false;
+    }
+    const uint8_t *payload = data + sizeof(header);
+    if (header.payloadSize != size - sizeof(header) || header.profileCount > APN_SNAPSHOT_MAX_PROFILES ||
+        header.checksum != HashBytes(SNAPSHOT_HASH_OFFSET_BASIS, payload, header.payloadSize)) {
+        TELEPHONY_LOGE("apn snapshot is corrupted");
+        return false;
+    }
+    SnapshotReader reader(payload, header.payloadSize);
+    std::vector<PdpProfile> profiles(header.profileCount);
+    for (PdpProfile &profile : profiles) {
+        if (!ReadProfile(reader, profile)) {
+            TELEPHONY_LOGE("apn snapshot is truncated");
+            return false;
+        }
+    }
+    if (!reader.IsEnd()) {
+        TELEPHONY_LOGE("apn snapshot has trailing data");
+        return false;
+    }
+    snapshot.preferId = header.preferId;
+    snapshot.profiles = std::move(profiles);
+    return true;
+}
+
+bool ApnSnapshotCache::IsValidSlotId(int32_t slotId)
+{
+    return slotId >= 0 && slotId < APN_SNAPSHOT_SLOT_NUM;
+}
+
+void ApnSnapshotCache::SetSnapshotDir(const std::string &dir)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshotDir_ = dir;
+}
+
+std::string ApnSnapshotCache::GetSnapshotPath(int32_t slotId)
+{
+    std::string dir = snapshotDir_.empty() ? APN_SNAPSHOT_DEFAULT_DIR : snapshotDir_;
+    return dir + "/apn_snapshot_" + std::to_string(slotId) + ".bin";
+}
+
+bool ApnSnapshotCache::Load(int32_t slotId, const ApnQueryParam &param, ApnSnapshot &snapshot)
+{
+    if (!IsValidSlotId(slotId)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string path = GetSnapshotPath(slotId);
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        TELEPHONY_LOGI("Slot%{public}d: no apn snapshot, errno %{public}d", slotId, errno);
+        return false;
+    }
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0 || fileStat.st_size > APN_SNAPSHOT_MAX_SIZE) {
+        TELEPHONY_LOGE("Slot%{public}d: invalid apn snapshot size", slotId);
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        TELEPHONY_LOGE("Slot%{public}d: mmap apn snapshot failed, errno %{public}d", slotId, errno);
+        return false;
+    }
+    bool result = Deserialize(static_cast<const uint8_t *>(addr), size, MakeKey(param), snapshot);
+    munmap(addr, size);
+    if (!result) {
+        unlink(path.c_str());
+    }
+    return result;
+}
+
+bool ApnSnapshotCache::Store(
+    int32_t slotId, const ApnQueryParam &param, const ApnSnapshot &snapshot, uint64_t generation)
+{
+    if (!IsValidSlotId(slotId)) {
+        return false;
+    }
+    if (HasCredential(snapshot)) {
+        TELEPHONY_LOGI("Slot%{public}d: apn profiles carry credentials, skip snapshot", slotId);
+        return false;
+    }
+    std::string buffer;
+    Serialize(MakeKey(param), snapshot, buffer);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The apn tables changed while the profiles were being queried, the result may already be outdated.
+    if (generation != generation_[slotId].load()) {
+        TELEPHONY_LOGI("Slot%{public}d: apn snapshot outdated, skip store", slotId);
+        return false;
+    }
+    std::string dir = snapshotDir_.empty() ? APN_SNAPSHOT_DEFAULT_DIR : snapshotDir_;
+    if (!CreateSnapshotDir(dir)) {
+        TELEPHONY_LOGE("Slot%{public}d: create apn snapshot dir failed, errno %{public}d", slotId, errno);
+        return false;
+    }
+    std::string path = GetSnapshotPath(slotId);
+    std::string tmpPath = path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, APN_SNAPSHOT_FILE_MODE);
+    if (fd < 0) {
+        TELEPHONY_LOGE("Slot%{public}d: open apn snapshot failed, errno %{public}d", slotId, errno);
+        return false;
+    }
+    size_t written = 0;
+    while (written < buffer.size()) {
+        ssize_t ret = write(fd, buffer.data() + written, buffer.size() - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    bool result = written == buffer.size() && fsync(fd) == 0;
+    close(fd);
+    if (!result || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        TELEPHONY_LOGE("Slot%{public}d: write apn snapshot failed, errno %{public}d", slotId, errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    TELEPHONY_LOGI("Slot%{public}d: store %{public}zu apn profiles to snapshot", slotId, snapshot.profiles.size());
+    return true;
+}
+
+void ApnSnapshotCache::Invalidate(int32_t slotId)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_[slotId]++;
+    unlink(GetSnapshotPath(slotId).c_str());
+}
+
+void ApnSnapshotCache::InvalidateAll()
+{
+    for (int32_t slotId = 0; slotId < APN_SNAPSHOT_SLOT_NUM; ++slotId) {
+        Invalidate(slotId);
+    }
+}
+
+uint64_t ApnSnapshotCache::GetGeneration(int32_t slotId) const
+{
+    if (!IsValidSlotId(slotId)) {
+        return 0;
+    }
+    return generation_[slotId].load();
+}
+
+bool ApnSnapshotCache::PostValidateTask(const std::function<void()> &task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (validateHandler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("ApnSnapshotValidator");
+        if (runner == nullptr) {
+            TELEPHONY_LOGE("create apn snapshot validator runner failed");
+            return false;
+        }
+        validateHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    return validateHandler_->PostTask(task);
+}
+
+void ApnSnapshotCache::SetStaleCallback(int32_t slotId, const StaleCallback &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    staleCallbacks_[slotId] = callback;
+}
+
+void ApnSnapshotCache::NotifyStale(int32_t slotId)
+{
+    StaleCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = staleCallbacks_.find(slotId);
+        if (it == staleCallbacks_.end()) {
+            return;
+        }
+        callback = it->second;
+    }
+    if (callback) {
+        callback();
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
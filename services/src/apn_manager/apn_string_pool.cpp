@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "apn_string_pool.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Telephony {
+ApnString::ApnString(const std::string &str)
+{
+    if (!str.empty()) {
+        str_ = ApnStringPool::GetInstance().Intern(str, pooled_);
+    }
+}
+
+ApnString::ApnString(const char *str)
+{
+    if (str != nullptr && str[0] != '\0') {
+        str_ = ApnStringPool::GetInstance().Intern(str, pooled_);
+    }
+}
+
+ApnString ApnString::MakeUnpooled(const std::string &str)
+{
+    ApnString apnString;
+    if (!str.empty()) {
+        apnString.str_ = std::make_shared<const std::string>(str);
+        apnString.pooled_ = false;
+    }
+    return apnString;
+}
+
+ApnStringPool &ApnStringPool::GetInstance()
+{
+    static ApnStringPool instance;
+    return instance;
+}
+
+std::shared_ptr<const std::string> ApnStringPool::Intern(const std::string &str, bool &pooled)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = strings_.find(std::string_view(str));
+    if (it != strings_.end()) {
+        pooled = true;
+        return it->second;
+    }
+    if (strings_.size() >= sweepSize_) {
+        SweepLocked();
+    }
+    auto value = std::make_shared<const std::string>(str);
+    pooled = strings_.size() < APN_STRING_POOL_MAX_SIZE;
+    if (pooled) {
+        strings_.emplace(std::string_view(*value), value);
+        stringBytes_ += GetEntryBytes(*value);
+    }
+    return value;
+}
+
+void ApnStringPool::SweepLocked()
+{
+    // Handles are only handed out under the lock, an entry the pool alone holds cannot be picked up meanwhile.
+    for (auto it = strings_.begin(); it != strings_.end();) {
+        if (it->second.use_count() == 1) {
+            stringBytes_ -= GetEntryBytes(*it->second);
+            it = strings_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    sweepSize_ = std::min(std::max(APN_STRING_POOL_SWEEP_SIZE, strings_.size() * 2), APN_STRING_POOL_MAX_SIZE);
+}
+
+size_t ApnStringPool::GetEntryBytes(const std::string &str)
+{
+    return str.capacity() + sizeof(std::string) + sizeof(std::shared_ptr<const std::string>);
+}
+
+size_t ApnStringPool::GetStringCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return strings_.size();
+}
+
+size_t ApnStringPool::GetStringBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stringBytes_;
+}
+} // namespace Telephony
+} // namespace OHOS
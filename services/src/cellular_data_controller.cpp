@@ -15,6 +15,7 @@
 
 #include "cellular_data_controller.h"
 
+#include "cellular_data_startup.h"
 #include "core_manager_inner.h"
 #include "network_search_callback.h"
 static constexpr int32_t SIM_ACCOUNT_LOADED_REGISTER = 0;
@@ -162,11 +163,30 @@ void CellularDataController::AsynchronousRegister()
         TELEPHONY_LOGI("Slot%{public}d: core inited", slotId_);
         Init();
         RegisterEvents();
+        NotifyRegistered();
         return;
     }
     SendEvent(CellularDataEventCode::MSG_ASYNCHRONOUS_REGISTER_EVENT_ID, CORE_INIT_DELAY_TIME, Priority::HIGH);
 }
 
+void CellularDataController::SetRegisteredCallback(const std::function<void(int32_t)> &callback)
+{
+    std::lock_guard<std::mutex> lock(registeredCallbackMutex_);
+    registeredCallback_ = callback;
+}
+
+void CellularDataController::NotifyRegistered()
+{
+    std::function<void(int32_t)> callback;
+    {
+        std::lock_guard<std::mutex> lock(registeredCallbackMutex_);
+        callback.swap(registeredCallback_);
+    }
+    if (callback != nullptr) {
+        callback(slotId_);
+    }
+}
+
 void CellularDataController::ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event)
 {
     if (event == nullptr) {
@@ -271,6 +291,16 @@ int32_t CellularDataController::GetCellularDataFlowType()
     return cellularDataHandler_->GetCellularDataFlowType();
 }
 
+bool CellularDataController::GetConnectionTrafficInfo(std::vector<ConnectionTrafficInfo> &infoList)
+{
+    if (cellularDataHandler_ == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: cellular data handler is null", slotId_);
+        return false;
+    }
+    cellularDataHandler_->GetConnectionTrafficInfo(infoList);
+    return true;
+}
+
 int32_t CellularDataController::SetPolicyDataOn(bool enable)
 {
     if (cellularDataHandler_ != nullptr) {
@@ -359,7 +389,12 @@ void CellularDataController::SystemAbilityStatusChangeListener::OnAddSystemAbili
                         TelCommonEvent::DATA_SHARE_READY});
 #ifdef BASE_POWER_IMPROVEMENT
                if (system::GetBoolParameter("const.vendor.ril.power.feature_tele_power", false)) {
-                    handler_->SubscribeTelePowerEvent();
+                    // The power save subscription is not needed for the first data call, keep it off the boot path.
+                    std::shared_ptr<CellularDataHandler> handler = handler_;
+                    CellularDataStartup::GetInstance().AddDeferredPhase(
+                        "telePowerSubscribe" + std::to_string(slotId_), [handler]() {
+                            handler->PostTask([handler]() { handler->SubscribeTelePowerEvent(); });
+                        });
                 }
 #endif
             }
@@ -15,9 +15,21 @@
 
 #include "cellular_data_dump_helper.h"
 
+#include "cellular_data_io_worker.h"
+#include "cellular_data_perf_stats.h"
+#include "cellular_data_rdb_helper.h"
+#include "cellular_data_settings_rdb_helper.h"
+#include "cellular_data_setup_tracer.h"
+#include "cellular_data_startup.h"
 #include "cellular_data_service.h"
 #include "core_manager_inner.h"
+#include "data_service_ext_wrapper.h"
 #include "enum_convert.h"
+#include "shared_event_executor.h"
+#include "stall_detection_scheduler.h"
+#include "state_machine.h"
+#include "state_notification.h"
+#include "telephony_ext_wrapper.h"
 
 namespace OHOS {
 namespace Telephony {
@@ -32,6 +44,12 @@ bool CellularDataDumpHelper::Dump(const std::vector<std::string> &args, std::str
             return true;
         }
     }
+    for (const std::string &arg : args) {
+        if (arg == "-perf_dump") {
+            ShowPerfInfo(result);
+            return true;
+        }
+    }
     ShowCellularDataInfo(result);
     return true;
 }
@@ -64,6 +82,37 @@ void CellularDataDumpHelper::ShowHelp(std::string &result) const
     result.append("dump performance statistics\n");
 }
 
+void CellularDataDumpHelper::ShowPerfInfo(std::string &result) const
+{
+    result.append("Ohos cellular data performance statistics: \n");
+    for (int32_t i = 0; i < MAX_PERF_SLOT_NUM; i++) {
+        CellularDataPerfStats::GetInstance().Dump(i, result);
+        CellularDataSetupTracer::GetInstance().Dump(i, result);
+    }
+    CellularDataIoWorker::GetInstance().Dump(result);
+    StallDetectionTimer::GetInstance().Dump(result);
+    StateNotification::GetInstance().Dump(result);
+    SharedEventExecutor::GetInstance().Dump(result);
+    StateMachineDeferStats deferStats = StateMachineEventHandler::GetTotalDeferStats();
+    result.append("StateMachineDeferEvents: deferred=" + std::to_string(deferStats.deferredCount));
+    result.append(" replayed=" + std::to_string(deferStats.replayedCount));
+    result.append(" overflowed=" + std::to_string(deferStats.overflowCount) + "\n");
+    auto rdbHelper = CellularDataRdbHelper::GetInstance();
+    if (rdbHelper != nullptr) {
+        rdbHelper->DumpHelperPool(result);
+    }
+    auto settingHelper = CellularDataSettingsRdbHelper::GetInstance();
+    if (settingHelper != nullptr) {
+        settingHelper->DumpHelperPool(result);
+    }
+#ifdef OHOS_BUILD_ENABLE_TELEPHONY_EXT
+    TELEPHONY_EXT_WRAPPER.DumpSymbolStats(result);
+#endif
+#ifdef OHOS_BUILD_ENABLE_DATA_SERVICE_EXT
+    DATA_SERVICE_EXT_WRAPPER.DumpSymbolStats(result);
+#endif
+}
+
 void CellularDataDumpHelper::ShowCellularDataInfo(std::string &result) const
 {
     CellularDataService &dataService = DelayedRefSingleton<CellularDataService>::GetInstance();
@@ -77,6 +126,10 @@ void CellularDataDumpHelper::ShowCellularDataInfo(std::string &result) const
     result.append("SpendTime                    : ");
     result.append(std::to_string(dataService.GetSpendTime()));
     result.append("\n");
+    result.append("InitPhaseTime                : ");
+    result.append(dataService.GetInitPhaseTime());
+    result.append("\n");
+    CellularDataStartup::GetInstance().Dump(result);
     result.append("CellularDataSlotId           : ");
     result.append(dataService.GetCellularDataSlotIdDump());
     result.append("\n");
@@ -99,6 +152,9 @@ void CellularDataDumpHelper::ShowCellularDataInfo(std::string &result) const
             dataService.IsCellularDataRoamingEnabled(i, dataRoamingEnabled);
             result.append(GetBoolValue(dataRoamingEnabled));
             result.append("\n");
+            result.append("ConnectionTraffic            : ");
+            result.append(dataService.GetConnectionTrafficDump(i));
+            result.append("\n");
         }
     }
     bool dataEnabled = false;
@@ -14,10 +14,19 @@
  */
 
 #include "cellular_data_handler.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+
 #include "cellular_data_error.h"
 #include "cellular_data_hisysevent.h"
+#include "cellular_data_io_worker.h"
+#include "cellular_data_perf_stats.h"
 #include "cellular_data_service.h"
 #include "cellular_data_settings_rdb_helper.h"
+#include "cellular_data_startup.h"
+#include "cellular_data_setup_tracer.h"
 #include "cellular_data_utils.h"
 #include "common_event_manager.h"
 #include "common_event_support.h"
@@ -42,6 +51,7 @@ static constexpr int32_t SIM_ACCOUNT_LOADED_BUT_SIMID_INVALID = 2;
 static constexpr int32_t SIM_ACCOUNT_LOADED_RECEIVE = 3;
 static constexpr int32_t APN_CREATE_ERROR_FIRST_CNT = 3;
 const std::string DEFAULT_DATA_ROAMING = "persist.telephony.defaultdataroaming";
+constexpr const char *APN_ACTIVATE_KEEP_PERIOD = "persist.telephony.apn_activate_keep_period";
 #ifdef BASE_POWER_IMPROVEMENT
 constexpr const char *PERMISSION_STARTUP_COMPLETED = "ohos.permission.RECEIVER_STARTUP_COMPLETED";
 #endif
@@ -53,6 +63,35 @@ constexpr const char *GCF_LAST_PLMN = "00101";
 constexpr const char *GCF_CUR_PLMN = "24681";
 constexpr const char *CN_MCC = "460";
 constexpr const char *OUT_BORDER_MCC = "454";
+
+template<typename Entry, size_t N>
+static constexpr std::array<Entry, N> SortByEventId(const Entry (&table)[N])
+{
+    std::array<Entry, N> sorted {};
+    for (size_t i = 0; i < N; ++i) {
+        sorted[i] = table[i];
+    }
+    for (size_t i = 1; i < N; ++i) {
+        for (size_t j = i; j > 0 && sorted[j].eventId < sorted[j - 1].eventId; --j) {
+            Entry tmp = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = tmp;
+        }
+    }
+    return sorted;
+}
+
+template<typename Entry, size_t N>
+static constexpr bool IsEventIdUnique(const std::array<Entry, N> &sorted)
+{
+    for (size_t i = 1; i < N; ++i) {
+        if (sorted[i].eventId == sorted[i - 1].eventId) {
+            return false;
+        }
+    }
+    return true;
+}
+
 CellularDataHandler::CellularDataHandler(int32_t slotId)
     : TelEventHandler("CellularDataHandler"), slotId_(slotId)
 {}
@@ -81,6 +120,31 @@ void CellularDataHandler::Init()
     dataSwitchSettings_->LoadSwitchValue();
     GetConfigurationFor5G();
     SetRilLinkBandwidths();
+    InitApnActivateStats();
+    std::weak_ptr<TelEventHandler> weakHandler = std::static_pointer_cast<TelEventHandler>(shared_from_this());
+    stateMachinePool_ = std::make_shared<CellularDataStateMachinePool>(slotId_, [weakHandler]() {
+        auto handler = std::static_pointer_cast<CellularDataHandler>(weakHandler.lock());
+        return handler == nullptr ? nullptr : handler->CreateInitializedCellularDataConnect();
+    });
+    // Machines are built on the handler thread ahead of the first connection.
+    SendEvent(CellularDataEventCode::MSG_PREWARM_STATE_MACHINE_POOL);
+    ApnSnapshotCache::GetInstance().SetStaleCallback(slotId_, [weakHandler]() {
+        auto handler = weakHandler.lock();
+        if (handler != nullptr) {
+            handler->SendEvent(CellularDataEventCode::MSG_APN_CHANGED);
+        }
+    });
+}
+
+void CellularDataHandler::InitApnActivateStats()
+{
+    int32_t keepPeriod = GetIntParameter(APN_ACTIVATE_KEEP_PERIOD, static_cast<int32_t>(KEEP_APN_ACTIVATE_PERIOD));
+    if (keepPeriod <= 0) {
+        TELEPHONY_LOGE("Slot%{public}d: invalid apn activate keep period %{public}d", slotId_, keepPeriod);
+        keepPeriod = static_cast<int32_t>(KEEP_APN_ACTIVATE_PERIOD);
+    }
+    std::lock_guard<std::mutex> lock(apnActivateStatsMutex_);
+    apnActivateStats_.SetKeepPeriod(static_cast<uint32_t>(keepPeriod));
 }
 
 CellularDataHandler::~CellularDataHandler() {}
@@ -120,8 +184,10 @@ bool CellularDataHandler::RequestNet(const NetRequest &request)
     netRequest->capability = ApnManager::FindBestCapability(request.capability);
     netRequest->ident = request.ident;
     netRequest->bearTypes = request.bearTypes;
+    int32_t apnId = ApnManager::FindApnIdByCapability(netRequest->capability);
     AppExecFwk::InnerEvent::Pointer event =
         InnerEvent::Get(CellularDataEventCode::MSG_REQUEST_NETWORK, netRequest, TYPE_REQUEST_NET);
+    CellularDataSetupTracer::GetInstance().Mark(slotId_, apnId, SetupTraceStage::REQUEST_NET);
     return SendEvent(event);
 }
 
@@ -143,6 +209,13 @@ int32_t CellularDataHandler::SetCellularDataEnable(bool userDataOn)
         return TELEPHONY_ERR_SUCCESS;
     }
 
+    SendDataSwitchChangeInfo(userDataOn);
+    return dataSwitchSettings_->SetUserDataOn(userDataOn);
+}
+
+__attribute__((no_sanitize("cfi")))
+void CellularDataHandler::SendDataSwitchChangeInfo(bool userDataOn)
+{
 #ifdef OHOS_BUILD_ENABLE_TELEPHONY_EXT
     if (TELEPHONY_EXT_WRAPPER.sendDataSwitchChangeInfo_) {
         int32_t callingUid = IPCSkeleton::GetCallingUid();
@@ -152,7 +225,6 @@ int32_t CellularDataHandler::SetCellularDataEnable(bool userDataOn)
         TELEPHONY_EXT_WRAPPER.sendDataSwitchChangeInfo_(bundleName.c_str(), callingPid, userDataOn);
     }
 #endif
-    return dataSwitchSettings_->SetUserDataOn(userDataOn);
 }
 
 int32_t CellularDataHandler::SetIntelligenceSwitchEnable(bool userSwitchOn)
@@ -750,6 +822,9 @@ void CellularDataHandler::AttemptEstablishDataConnection(sptr<ApnHolder> &apnHol
         FinishTrace(HITRACE_TAG_OHOS);
         return;
     }
+    // Marked once admitted only, a rejected attempt must not leave a span open.
+    CellularDataSetupTracer::GetInstance().Mark(
+        slotId_, ApnManager::FindApnIdByApnName(apnHolder->GetApnType()), SetupTraceStage::ATTEMPT_ESTABLISH);
     if (CheckMultiApnState(apnHolder)) {
         TELEPHONY_LOGE("Slot%{public}d: bip or dun is using", slotId_);
     }
@@ -795,6 +870,69 @@ std::shared_ptr<CellularDataStateMachine> CellularDataHandler::CreateCellularDat
     return cellularDataStateMachine;
 }
 
+std::shared_ptr<CellularDataStateMachine> CellularDataHandler::CreateInitializedCellularDataConnect()
+{
+    if (connectionManager_ == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: connectionManager_ is null", slotId_);
+        return nullptr;
+    }
+    std::shared_ptr<CellularDataStateMachine> cellularDataStateMachine = CreateCellularDataConnect();
+    if (cellularDataStateMachine == nullptr) {
+        return nullptr;
+    }
+    cellularDataStateMachine->Init();
+    connectionManager_->AddConnectionStateMachine(cellularDataStateMachine);
+    return cellularDataStateMachine;
+}
+
+std::shared_ptr<CellularDataStateMachine> CellularDataHandler::AcquireCellularDataConnection()
+{
+    if (stateMachinePool_ == nullptr) {
+        std::shared_ptr<CellularDataStateMachine> idleMachine = FindIdleCellularDataConnection();
+        return idleMachine != nullptr ? idleMachine : CreateInitializedCellularDataConnect();
+    }
+    std::shared_ptr<CellularDataStateMachine> cellularDataStateMachine = stateMachinePool_->Acquire(
+        [this](const std::shared_ptr<CellularDataStateMachine> &candidate) {
+            return candidate->IsInactiveState() && apnManager_ != nullptr &&
+                apnManager_->IsDataConnectionNotUsed(candidate);
+        });
+    // Machines which went idle without passing through the pool are still found by the scan.
+    if (cellularDataStateMachine == nullptr) {
+        cellularDataStateMachine = FindIdleCellularDataConnection();
+    }
+    if (cellularDataStateMachine == nullptr) {
+        cellularDataStateMachine = stateMachinePool_->Create();
+    }
+    if (stateMachinePool_->NeedPreWarm()) {
+        SendEvent(CellularDataEventCode::MSG_PREWARM_STATE_MACHINE_POOL);
+    }
+    return cellularDataStateMachine;
+}
+
+void CellularDataHandler::ReleaseCellularDataConnection(const std::shared_ptr<CellularDataStateMachine> &stateMachine)
+{
+    if (stateMachinePool_ == nullptr || apnManager_ == nullptr || connectionManager_ == nullptr) {
+        return;
+    }
+    // A machine reused by another apn keeps serving it.
+    if (!apnManager_->IsDataConnectionNotUsed(stateMachine)) {
+        return;
+    }
+    if (!stateMachinePool_->Release(stateMachine)) {
+        TELEPHONY_LOGI("Slot%{public}d: state machine pool is full, retire the machine", slotId_);
+        connectionManager_->RemoveConnectionStateMachine(stateMachine);
+    }
+}
+
+void CellularDataHandler::HandlePreWarmStateMachinePool(const InnerEvent::Pointer &event)
+{
+    if (stateMachinePool_ == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: stateMachinePool_ is null", slotId_);
+        return;
+    }
+    stateMachinePool_->PreWarm();
+}
+
 bool CellularDataHandler::EstablishDataConnection(sptr<ApnHolder> &apnHolder, int32_t radioTech)
 {
     int32_t profileId = GetCurrentApnId();
@@ -832,19 +970,10 @@ bool CellularDataHandler::EstablishDataConnection(sptr<ApnHolder> &apnHolder, in
                 return false;
             }
         }
-        cellularDataStateMachine = FindIdleCellularDataConnection();
+        cellularDataStateMachine = AcquireCellularDataConnection();
         if (cellularDataStateMachine == nullptr) {
-            cellularDataStateMachine = CreateCellularDataConnect();
-            if (cellularDataStateMachine == nullptr) {
-                TELEPHONY_LOGE("Slot%{public}d: cellularDataStateMachine is null", slotId_);
-                return false;
-            }
-            cellularDataStateMachine->Init();
-            if (connectionManager_ == nullptr) {
-                TELEPHONY_LOGE("Slot%{public}d: connectionManager_ is null", slotId_);
-                return false;
-            }
-            connectionManager_->AddConnectionStateMachine(cellularDataStateMachine);
+            TELEPHONY_LOGE("Slot%{public}d: cellularDataStateMachine is null", slotId_);
+            return false;
         }
     } else {
         return HandleCompatibleDataConnection(cellularDataStateMachine, apnHolder);
@@ -869,6 +998,8 @@ bool CellularDataHandler::EstablishDataConnection(sptr<ApnHolder> &apnHolder, in
         return false;
     }
     cellularDataStateMachine->SendEvent(event);
+    CellularDataSetupTracer::GetInstance().Mark(
+        slotId_, ApnManager::FindApnIdByApnName(apnHolder->GetApnType()), SetupTraceStage::SM_CONNECT);
     SetApnActivateStart(apnHolder->GetApnType());
     return true;
 }
@@ -906,6 +1037,7 @@ void CellularDataHandler::EstablishDataConnectionComplete(const InnerEvent::Poin
             TELEPHONY_LOGE("Slot%{public}d: flag:%{public}d complete apnHolder is null", slotId_, resultInfo->flag);
             return;
         }
+        CellularDataSetupTracer::GetInstance().Mark(slotId_, resultInfo->flag, SetupTraceStage::ESTABLISH_COMPLETE);
         apnHolder->SetApnState(PROFILE_STATE_CONNECTED);
         CellularDataHiSysEvent::WriteDataConnectStateBehaviorEvent(slotId_, apnHolder->GetApnType(),
             apnHolder->GetCapability(), static_cast<int32_t>(PROFILE_STATE_CONNECTED));
@@ -914,6 +1046,7 @@ void CellularDataHandler::EstablishDataConnectionComplete(const InnerEvent::Poin
             HILOG_COMM_IMPL(LOG_INFO, LOG_DOMAIN, TELEPHONY_LOG_TAG,
                 "default apn has connected, to setup internal_default apn");
             SendEvent(CellularDataEventCode::MSG_RETRY_TO_SETUP_DATACALL, DATA_CONTEXT_ROLE_INTERNAL_DEFAULT_ID, 0);
+            CellularDataStartup::GetInstance().OnDefaultApnConnected();
         }
         DataConnCompleteUpdateState(apnHolder, resultInfo);
     }
@@ -924,12 +1057,12 @@ void CellularDataHandler::DataConnCompleteUpdateState(const sptr<ApnHolder> &apn
 {
     std::shared_ptr<CellularDataStateMachine> stateMachine = apnHolder->GetCellularDataStateMachine();
     if (stateMachine != nullptr) {
-        std::string proxyIpAddress = "";
         sptr<ApnItem> attachApn = apnManager_->GetRilAttachApn();
         if (attachApn != nullptr) {
-            proxyIpAddress = attachApn->attr_.proxyIpAddress_;
+            stateMachine->UpdateHttpProxy(attachApn->GetProxyHost(), attachApn->GetProxyPort());
+        } else {
+            stateMachine->UpdateHttpProxy("", DEFAULT_PORT);
         }
-        stateMachine->UpdateHttpProxy(proxyIpAddress);
         stateMachine->UpdateNetworkInfo(*resultInfo);
     } else {
         apnHolder->SetApnState(PROFILE_STATE_IDLE);
@@ -1007,6 +1140,19 @@ void CellularDataHandler::UpdateApnInfo(const int32_t profileId)
         TELEPHONY_LOGE("Slot%{public}d: failed due to invalid sim id %{public}d", slotId_, simId);
         return;
     }
+    // The prefer apn table holds profileId once the write is done, a prefer id read before is outdated.
+    currentApnId_ = profileId;
+    currentApnIdGeneration_++;
+    bool posted = CellularDataIoWorker::GetInstance().PostTask(slotId_, [simId, profileId]() {
+        WriteApnInfo(simId, profileId);
+    });
+    if (!posted) {
+        TELEPHONY_LOGE("Slot%{public}d: post update apn info task failed", slotId_);
+    }
+}
+
+void CellularDataHandler::WriteApnInfo(const int32_t simId, const int32_t profileId)
+{
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreatorDataShareHelper();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is nullptr.");
@@ -1034,24 +1180,58 @@ void CellularDataHandler::UpdateApnInfo(const int32_t profileId)
     dataShareHelper->Release();
 }
 
-int32_t CellularDataHandler::GetCurrentApnId()
+void CellularDataHandler::RefreshCurrentApnId()
 {
     int32_t simId = CoreManagerInner::GetInstance().GetSimId(slotId_);
     if (simId <= INVALID_SIM_ID) {
         TELEPHONY_LOGE("Slot%{public}d: failed due to invalid sim id %{public}d", slotId_, simId);
-        return 0;
+        return;
     }
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreatorDataShareHelper();
-    if (dataShareHelper == nullptr) {
-        TELEPHONY_LOGE("dataShareHelper is nullptr.");
-        return 0;
+    auto result = std::make_shared<CurrentApnIdResult>();
+    result->apnIdGeneration = currentApnIdGeneration_;
+    std::weak_ptr<AppExecFwk::EventHandler> weakHandler = weak_from_this();
+    bool posted = CellularDataIoWorker::GetInstance().PostTask(slotId_, [simId, result, weakHandler]() {
+        std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreatorDataShareHelper();
+        if (dataShareHelper == nullptr) {
+            TELEPHONY_LOGE("dataShareHelper is nullptr.");
+            return;
+        }
+        bool found = GetCurrentDataShareApnInfo(dataShareHelper, simId, result->apnId);
+        dataShareHelper->Release();
+        auto handler = weakHandler.lock();
+        if (!found || handler == nullptr) {
+            return;
+        }
+        InnerEvent::Pointer event = InnerEvent::Get(CellularDataEventCode::MSG_CURRENT_APN_ID_LOADED, result);
+        handler->SendEvent(event);
+    });
+    if (!posted) {
+        TELEPHONY_LOGE("Slot%{public}d: post current apn id task failed", slotId_);
     }
-    int32_t profileIdValue = 0;
-    if (!GetCurrentDataShareApnInfo(dataShareHelper, simId, profileIdValue)) {
-        TELEPHONY_LOGE("GetCurrentDataShareApnInfo fail.");
+}
+
+void CellularDataHandler::HandleCurrentApnIdLoaded(const InnerEvent::Pointer &event)
+{
+    if (event == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: event is null", slotId_);
+        return;
     }
-    dataShareHelper->Release();
-    return profileIdValue;
+    std::shared_ptr<CurrentApnIdResult> result = event->GetSharedObject<CurrentApnIdResult>();
+    if (result == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: current apn id result is null", slotId_);
+        return;
+    }
+    // An UpdateApnInfo after the read already holds the newer id.
+    if (result->apnIdGeneration != currentApnIdGeneration_) {
+        return;
+    }
+    currentApnId_ = result->apnId;
+}
+
+int32_t CellularDataHandler::GetCurrentApnId()
+{
+    // Refreshed from the prefer apn table on every apn load and prefer apn change, see HandleApnChanged.
+    return currentApnId_;
 }
 
 int32_t CellularDataHandler::GetSlotId() const
@@ -1086,6 +1266,7 @@ void CellularDataHandler::DisconnectDataComplete(const InnerEvent::Pointer &even
     stateMachine->UpdateNetworkInfo(*netInfo);
     connectionManager_->RemoveActiveConnectionByCid(stateMachine->GetCid());
     apnHolder->SetCellularDataStateMachine(nullptr);
+    ReleaseCellularDataConnection(stateMachine);
     apnHolder->SetApnState(PROFILE_STATE_IDLE);
     CellularDataHiSysEvent::WriteDataConnectStateBehaviorEvent(slotId_, apnHolder->GetApnType(),
         apnHolder->GetCapability(), static_cast<int32_t>(PROFILE_STATE_IDLE));
@@ -1147,6 +1328,7 @@ void CellularDataHandler::RetryOrClearConnection(const sptr<ApnHolder> &apnHolde
         apnHolder->SetApnBadState(true);
         ClearConnection(apnHolder, DisConnectionReason::REASON_CLEAR_CONNECTION);
     } else if (reason == DisConnectionReason::REASON_RETRY_CONNECTION) {
+        CellularDataPerfStats::GetInstance().IncreaseRetryCount(slotId_);
         apnHolder->SetApnState(PROFILE_STATE_RETRYING);
         RetryScene scene = static_cast<RetryScene>(netInfo->retryScene);
         bool isRetrying = (apnManager_->GetOverallDefaultApnState() == ApnProfileState::PROFILE_STATE_RETRYING);
@@ -1403,6 +1585,7 @@ void CellularDataHandler::MsgRequestNetwork(const InnerEvent::Pointer &event)
     }
 
     if (event->GetParam() == TYPE_REQUEST_NET) {
+        CellularDataSetupTracer::GetInstance().Mark(slotId_, id, SetupTraceStage::MSG_REQUEST_NETWORK);
         apnHolder->RequestCellularData(request);
 #ifdef OHOS_BUILD_ENABLE_TELEPHONY_EXT
         NotifyReqCellularData(true);
@@ -1422,11 +1605,70 @@ void CellularDataHandler::ProcessEvent(const InnerEvent::Pointer &event)
         TELEPHONY_LOGE("Slot%{public}d: event is null!", slotId_);
         return;
     }
-    uint32_t eventCode = event->GetInnerEventId();
-    std::map<uint32_t, Fun>::iterator it = eventIdMap_.find(eventCode);
-    if (it != eventIdMap_.end()) {
-        it->second(event);
+    PerfEventScope perfScope(slotId_, PerfComponent::CELLULAR_DATA_HANDLER, event);
+    EventFun fun = FindEventFun(event->GetInnerEventId());
+    if (fun != nullptr) {
+        (this->*fun)(event);
+    }
+}
+
+CellularDataHandler::EventFun CellularDataHandler::FindEventFun(uint32_t eventId)
+{
+    static constexpr EventFunEntry EVENT_FUN_TABLE[] = {
+        { RadioEvent::RADIO_PS_CONNECTION_ATTACHED, &CellularDataHandler::RadioPsConnectionAttached },
+        { RadioEvent::RADIO_PS_ROAMING_OPEN, &CellularDataHandler::RoamingStateOn },
+        { RadioEvent::RADIO_PS_ROAMING_CLOSE, &CellularDataHandler::RoamingStateOff },
+        { RadioEvent::RADIO_EMERGENCY_STATE_OPEN, &CellularDataHandler::PsRadioEmergencyStateOpen },
+        { RadioEvent::RADIO_EMERGENCY_STATE_CLOSE, &CellularDataHandler::PsRadioEmergencyStateClose },
+        { CellularDataEventCode::MSG_ESTABLISH_DATA_CONNECTION_COMPLETE,
+            &CellularDataHandler::EstablishDataConnectionComplete },
+        { CellularDataEventCode::MSG_DISCONNECT_DATA_COMPLETE, &CellularDataHandler::DisconnectDataComplete },
+        { CellularDataEventCode::MSG_ESTABLISH_DATA_CONNECTION, &CellularDataHandler::MsgEstablishDataConnection },
+        { CellularDataEventCode::MSG_SETTING_SWITCH, &CellularDataHandler::HandleSettingSwitchChanged },
+        { CellularDataEventCode::MSG_REQUEST_NETWORK, &CellularDataHandler::MsgRequestNetwork },
+        { RadioEvent::RADIO_STATE_CHANGED, &CellularDataHandler::HandleRadioStateChanged },
+        { RadioEvent::RADIO_DSDS_MODE_CHANGED, &CellularDataHandler::HandleDsdsModeChanged },
+        { RadioEvent::RADIO_SIM_STATE_CHANGE, &CellularDataHandler::HandleSimEvent },
+        { RadioEvent::RADIO_SIM_RECORDS_LOADED, &CellularDataHandler::HandleSimEvent },
+        { RadioEvent::RADIO_SIM_ACCOUNT_LOADED, &CellularDataHandler::HandleSimEvent },
+        { RadioEvent::RADIO_PS_RAT_CHANGED, &CellularDataHandler::PsDataRatChanged },
+        { CellularDataEventCode::MSG_APN_CHANGED, &CellularDataHandler::HandleApnChanged },
+        { CellularDataEventCode::MSG_SET_RIL_ATTACH_APN, &CellularDataHandler::SetRilAttachApnResponse },
+        { RadioEvent::RADIO_NR_STATE_CHANGED, &CellularDataHandler::HandleRadioNrStateChanged },
+        { RadioEvent::RADIO_NR_FREQUENCY_CHANGED, &CellularDataHandler::HandleRadioNrFrequencyChanged },
+        { CellularDataEventCode::MSG_DB_SETTING_ENABLE_CHANGED, &CellularDataHandler::HandleDBSettingEnableChanged },
+        { CellularDataEventCode::MSG_DB_SETTING_ROAMING_CHANGED, &CellularDataHandler::HandleDBSettingRoamingChanged },
+        { CellularDataEventCode::MSG_DB_SETTING_INCALL_CHANGED, &CellularDataHandler::HandleDBSettingIncallChanged },
+        { CellularDataEventCode::MSG_INCALL_DATA_COMPLETE, &CellularDataHandler::IncallDataComplete },
+        { RadioEvent::RADIO_RIL_ADAPTER_HOST_DIED, &CellularDataHandler::OnRilAdapterHostDied },
+        { RadioEvent::RADIO_FACTORY_RESET, &CellularDataHandler::HandleFactoryReset },
+        { RadioEvent::RADIO_CLEAN_ALL_DATA_CONNECTIONS, &CellularDataHandler::OnCleanAllDataConnectionsDone },
+        { CellularDataEventCode::MSG_DATA_CALL_LIST_CHANGED, &CellularDataHandler::HandleUpdateNetInfo },
+        { RadioEvent::RADIO_NV_REFRESH_FINISHED, &CellularDataHandler::HandleSimEvent },
+        { CellularDataEventCode::MSG_RETRY_TO_SETUP_DATACALL, &CellularDataHandler::RetryToSetupDatacall },
+        { CellularDataEventCode::MSG_ESTABLISH_ALL_APNS_IF_CONNECTABLE,
+            &CellularDataHandler::HandleEstablishAllApnsIfConnectable },
+        { CellularDataEventCode::MSG_RESUME_DATA_PERMITTED_TIMEOUT, &CellularDataHandler::ResumeDataPermittedTimerOut },
+        { CellularDataEventCode::MSG_RETRY_TO_CREATE_APN, &CellularDataHandler::HandleApnChanged },
+        { CellularDataEventCode::MSG_RETRY_TO_LOAD_SIM_ACCOUNT, &CellularDataHandler::HandleRetryLoadSimAccount },
+        { RadioEvent::RADIO_RESIDENT_NETWORK_CHANGE, &CellularDataHandler::HandleResidentNetworkChanged },
+        { CellularDataEventCode::MSG_MCC_CHANGE_ACTIVATE_DELAY, &CellularDataHandler::HandleMccChangeDelay },
+        { CellularDataEventCode::MSG_APN_LOADED, &CellularDataHandler::HandleApnLoaded },
+        { CellularDataEventCode::MSG_PREWARM_STATE_MACHINE_POOL, &CellularDataHandler::HandlePreWarmStateMachinePool },
+        { CellularDataEventCode::MSG_CURRENT_APN_ID_LOADED, &CellularDataHandler::HandleCurrentApnIdLoaded },
+#ifdef BASE_POWER_IMPROVEMENT
+        { CellularDataEventCode::MSG_TIMEOUT_TO_REPLY_COMMON_EVENT, &CellularDataHandler::HandleReplyCommonEvent },
+#endif
+    };
+    // Sorted once at compile time and shared by the handlers of all slots.
+    static constexpr auto SORTED_EVENT_FUN_TABLE = SortByEventId(EVENT_FUN_TABLE);
+    static_assert(IsEventIdUnique(SORTED_EVENT_FUN_TABLE), "duplicate event id in CellularDataHandler table");
+    auto it = std::lower_bound(SORTED_EVENT_FUN_TABLE.begin(), SORTED_EVENT_FUN_TABLE.end(), eventId,
+        [](const EventFunEntry &entry, uint32_t id) { return entry.eventId < id; });
+    if (it == SORTED_EVENT_FUN_TABLE.end() || it->eventId != eventId) {
+        return nullptr;
     }
+    return it->fun;
 }
 
 void CellularDataHandler::OnCallStateChanged(int32_t slotId, int32_t state)
@@ -1704,12 +1946,13 @@ void CellularDataHandler::HandleRecordsChanged()
             dataSwitchSettings_->SetPolicyDataOn(true);
         }
         lastIccId_ = iccId;
+        // The apns of the previous sim must not be used until HandleApnLoaded brings the ones of this sim.
+        if (apnManager_ != nullptr) {
+            apnManager_->ClearApnItems();
+        }
     }
     GetConfigurationFor5G();
-    CreateApnItem();
-    SetRilAttachApn();
-    ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_CHANGE_CONNECTION);
-    EstablishAllApnsIfConnectable();
+    CreateApnItem(APN_LOAD_FOR_RECORDS_CHANGED);
 }
 
 void CellularDataHandler::HandleSimEvent(const AppExecFwk::InnerEvent::Pointer &event)
@@ -1790,22 +2033,11 @@ void CellularDataHandler::HandleSimAccountLoaded()
     if (dataSwitchSettings_ != nullptr) {
         dataSwitchSettings_->LoadSwitchValue();
     }
-    CoreManagerInner &coreInner = CoreManagerInner::GetInstance();
-    const int32_t defSlotId = coreInner.GetDefaultCellularDataSlotId();
     ReportEventToChr(slotId_, SIM_ACCOUNT_LOADED, SIM_ACCOUNT_LOADED_RECEIVE);
     CellularDataHiSysEvent::WriteDataActivateFaultEvent(slotId_, SWITCH_ON,
         CellularDataErrorCode::DATA_ERROR_RECEIVE_SIM_ACCOUNT_READY,
         "receive sim account ready");
-    CreateApnItem();
-    if (defSlotId == slotId_) {
-        EstablishAllApnsIfConnectable();
-        ApnProfileState apnState = apnManager_->GetOverallApnState();
-        if (registerRes && apnState == ApnProfileState::PROFILE_STATE_CONNECTED) {
-            UpdateNetworkInfo();
-        }
-    } else {
-        ClearAllConnections(DisConnectionReason::REASON_CLEAR_CONNECTION);
-    }
+    CreateApnItem(APN_LOAD_FOR_SIM_ACCOUNT_LOADED);
 }
 
 void CellularDataHandler::HandleRetryLoadSimAccount(const AppExecFwk::InnerEvent::Pointer &event)
@@ -1845,22 +2077,79 @@ void CellularDataHandler::StopLoadSimAccountTimer()
     RemoveEvent(CellularDataEventCode::MSG_RETRY_TO_LOAD_SIM_ACCOUNT);
 }
 
-void CellularDataHandler::CreateApnItem()
+void CellularDataHandler::CreateApnItem(uint32_t reasons)
 {
     if (apnManager_ == nullptr) {
         TELEPHONY_LOGE("Slot%{public}d: apnManager_ is null", slotId_);
         return;
     }
-    int32_t result = 0;
-    std::string errMsg = "";
-    for (int32_t i = 0; i < DEFAULT_READ_APN_TIME; ++i) {
-        errMsg = "";
-        result = apnManager_->CreateAllApnItemByDatabase(slotId_, errMsg);
-        if (result != 0) {
-            break;
+    pendingApnLoadReasons_ |= reasons;
+    uint64_t generation = ++apnLoadGeneration_;
+    int32_t count = 0;
+    if (apnManager_->CreateExtApnItem(slotId_, count)) {
+        FinishApnLoad(count, "");
+        return;
+    }
+    auto result = std::make_shared<ApnLoadResult>();
+    result->generation = generation;
+    result->apnIdGeneration = currentApnIdGeneration_;
+    int32_t slotId = slotId_;
+    std::weak_ptr<AppExecFwk::EventHandler> weakHandler = weak_from_this();
+    bool posted = CellularDataIoWorker::GetInstance().PostTask(slotId_, [slotId, result, weakHandler]() {
+        for (int32_t i = 0; i < DEFAULT_READ_APN_TIME; ++i) {
+            result->errMsg = "";
+            result->loaded = ApnManager::LoadApnSnapshot(slotId, result->snapshot, result->errMsg);
+            if (result->loaded && !result->snapshot.profiles.empty()) {
+                break;
+            }
+        }
+        auto handler = weakHandler.lock();
+        if (handler == nullptr) {
+            return;
+        }
+        InnerEvent::Pointer event = InnerEvent::Get(CellularDataEventCode::MSG_APN_LOADED, result);
+        handler->SendEvent(event);
+    });
+    if (!posted) {
+        TELEPHONY_LOGE("Slot%{public}d: post apn load task failed", slotId_);
+        FinishApnLoad(0, "post apn load task failed");
+    }
+}
+
+void CellularDataHandler::HandleApnLoaded(const InnerEvent::Pointer &event)
+{
+    if (event == nullptr || apnManager_ == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: event or apnManager_ is null", slotId_);
+        return;
+    }
+    std::shared_ptr<ApnLoadResult> result = event->GetSharedObject<ApnLoadResult>();
+    if (result == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: apn load result is null", slotId_);
+        return;
+    }
+    if (result->generation != apnLoadGeneration_) {
+        TELEPHONY_LOGI("Slot%{public}d: drop outdated apn load %{public}" PRIu64, slotId_, result->generation);
+        return;
+    }
+    int32_t count = 0;
+    if (apnManager_->CreateExtApnItem(slotId_, count)) {
+        FinishApnLoad(count, "");
+        return;
+    }
+    if (result->loaded) {
+        count = apnManager_->CreateAllApnItemBySnapshot(slotId_, result->snapshot);
+        if (result->apnIdGeneration == currentApnIdGeneration_) {
+            currentApnId_ = result->snapshot.preferId;
         }
+    } else {
+        apnManager_->ResetPreferId();
     }
-    if (result == 0 && !HasInnerEvent(CellularDataEventCode::MSG_RETRY_TO_CREATE_APN)) {
+    FinishApnLoad(count, result->errMsg);
+}
+
+void CellularDataHandler::FinishApnLoad(int32_t count, const std::string &errMsg)
+{
+    if (count == 0 && !HasInnerEvent(CellularDataEventCode::MSG_RETRY_TO_CREATE_APN)) {
         if (retryCreateApnTimes_ == APN_CREATE_ERROR_FIRST_CNT) {
             CellularDataHiSysEvent::WriteDataActivateFaultEvent(slotId_, SWITCH_ON,
                 CellularDataErrorCode::DATA_ERROR_CREATE_APN_EMPTY,
@@ -1878,12 +2167,56 @@ void CellularDataHandler::CreateApnItem()
                     errMsg);
             }
         }
-    } else if (result != 0) {
+    } else if (count != 0) {
         retryCreateApnTimes_ = 0;
         if (HasInnerEvent(CellularDataEventCode::MSG_RETRY_TO_CREATE_APN)) {
             RemoveEvent(CellularDataEventCode::MSG_RETRY_TO_CREATE_APN);
         }
     }
+    uint32_t reasons = pendingApnLoadReasons_;
+    pendingApnLoadReasons_ = 0;
+    ContinueAfterApnLoad(reasons);
+}
+
+void CellularDataHandler::ContinueAfterApnLoad(uint32_t reasons)
+{
+    if (apnManager_ == nullptr) {
+        return;
+    }
+    if ((reasons & APN_LOAD_FOR_SIM_ACCOUNT_LOADED) != 0) {
+        const int32_t defSlotId = CoreManagerInner::GetInstance().GetDefaultCellularDataSlotId();
+        if (defSlotId == slotId_) {
+            EstablishAllApnsIfConnectable();
+            ApnProfileState apnState = apnManager_->GetOverallApnState();
+            if (isSimAccountLoaded_ && apnState == ApnProfileState::PROFILE_STATE_CONNECTED) {
+                UpdateNetworkInfo();
+            }
+        } else {
+            ClearAllConnections(DisConnectionReason::REASON_CLEAR_CONNECTION);
+        }
+    }
+    if ((reasons & APN_LOAD_FOR_RECORDS_CHANGED) != 0) {
+        SetRilAttachApn();
+        ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_CHANGE_CONNECTION);
+        EstablishAllApnsIfConnectable();
+    }
+    if ((reasons & APN_LOAD_FOR_APN_CHANGED) != 0) {
+        SetRilAttachApn();
+        ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_CLEAR_CONNECTION);
+        apnManager_->ClearAllApnBad();
+        for (const sptr<ApnHolder> &apnHolder : apnManager_->GetAllApnHolder()) {
+            if (apnHolder == nullptr) {
+                continue;
+            }
+            int32_t id = apnManager_->FindApnIdByApnName(apnHolder->GetApnType());
+            if (apnHolder->GetApnState() == PROFILE_STATE_RETRYING) {
+                apnHolder->InitialApnRetryCount();
+                apnHolder->SetApnState(PROFILE_STATE_IDLE);
+                RemoveEvent(CellularDataEventCode::MSG_RETRY_TO_SETUP_DATACALL);
+            }
+            SendEvent(CellularDataEventCode::MSG_ESTABLISH_DATA_CONNECTION, id, ESTABLISH_DATA_CONNECTION_DELAY);
+        }
+    }
 }
 
 bool CellularDataHandler::HandleApnChanged()
@@ -1911,22 +2244,9 @@ void CellularDataHandler::HandleApnChanged(const InnerEvent::Pointer &event)
         TELEPHONY_LOGE("Slot%{public}d: apnManager_ is null", slotId_);
         return;
     }
-    CreateApnItem();
-    SetRilAttachApn();
-    ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_CLEAR_CONNECTION);
-    apnManager_->ClearAllApnBad();
-    for (const sptr<ApnHolder> &apnHolder : apnManager_->GetAllApnHolder()) {
-        if (apnHolder == nullptr) {
-            continue;
-        }
-        int32_t id = apnManager_->FindApnIdByApnName(apnHolder->GetApnType());
-        if (apnHolder->GetApnState() == PROFILE_STATE_RETRYING) {
-            apnHolder->InitialApnRetryCount();
-            apnHolder->SetApnState(PROFILE_STATE_IDLE);
-            RemoveEvent(CellularDataEventCode::MSG_RETRY_TO_SETUP_DATACALL);
-        }
-        SendEvent(CellularDataEventCode::MSG_ESTABLISH_DATA_CONNECTION, id, ESTABLISH_DATA_CONNECTION_DELAY);
-    }
+    // The apn load may be served by the snapshot cache, the prefer apn id is read from the table itself.
+    RefreshCurrentApnId();
+    CreateApnItem(APN_LOAD_FOR_APN_CHANGED);
 }
 
 int32_t CellularDataHandler::GetCellularDataFlowType()
@@ -1938,6 +2258,15 @@ int32_t CellularDataHandler::GetCellularDataFlowType()
     return connectionManager_->GetDataFlowType();
 }
 
+void CellularDataHandler::GetConnectionTrafficInfo(std::vector<ConnectionTrafficInfo> &infoList)
+{
+    if (connectionManager_ == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: connection manager is null", slotId_);
+        return;
+    }
+    connectionManager_->GetConnectionTraffic(infoList);
+}
+
 void CellularDataHandler::HandleRadioStateChanged(const AppExecFwk::InnerEvent::Pointer &event)
 {
     if (apnManager_ == nullptr || event == nullptr) {
@@ -2363,13 +2692,15 @@ void CellularDataHandler::GetDefaultDataEnableConfig()
     }
     OperatorConfig config;
     if (ret == TELEPHONY_ERR_DATABASE_READ_EMPTY) {
+        int32_t simDetected = static_cast<int32_t>(DataSimDetectedCode::SIM_DETECTED_ENABLED);
         CoreManagerInner::GetInstance().GetOperatorConfigs(slotId_, config);
         if (config.boolValue.find(KEY_DEFAULT_DATA_ENABLE_BOOL) != config.boolValue.end()) {
             dataEnbaled = config.boolValue[KEY_DEFAULT_DATA_ENABLE_BOOL];
             TELEPHONY_LOGI("Slot%{public}d: OperatorConfig dataEnable_ = %{public}d", slotId_, dataEnbaled);
-            dataSwitchSettings_->SetUserDataOn(dataEnbaled);
+            dataSwitchSettings_->SetUserDataOnAndSimDetected(dataEnbaled, simDetected);
+            return;
         }
-        dataSwitchSettings_->SetAnySimDetected(static_cast<int32_t>(DataSimDetectedCode::SIM_DETECTED_ENABLED));
+        dataSwitchSettings_->SetAnySimDetected(simDetected);
     }
 }
 
@@ -2517,6 +2848,8 @@ void CellularDataHandler::HandleDBSettingEnableChanged(const AppExecFwk::InnerEv
         TELEPHONY_LOGE("Slot%{public}d: dataSwitchSettings_ is null.", slotId_);
         return;
     }
+    // The cached switch value is stale once the settings observer fires, even when the change is not acted on.
+    dataSwitchSettings_->InvalidateUserDataStatus();
     if (TELEPHONY_EXT_WRAPPER.isVirtualModemConnected_ && TELEPHONY_EXT_WRAPPER.isVirtualModemConnected_()) {
         TELEPHONY_LOGI("dc is connected, do nothing");
         return;
@@ -2551,7 +2884,9 @@ void CellularDataHandler::HandleDBSettingRoamingChanged(const AppExecFwk::InnerE
         TELEPHONY_LOGE("Slot%{public}d: dataSwitchSettings_ is null", slotId_);
         return;
     }
-    bool dataRoamingEnabled = dataSwitchSettings_->IsUserDataRoamingOn();
+    dataSwitchSettings_->InvalidateUserDataRoamingStatus();
+    bool dataRoamingEnabled = false;
+    dataSwitchSettings_->QueryUserDataRoamingStatus(dataRoamingEnabled);
     bool roamingState = false;
     if (CoreManagerInner::GetInstance().GetPsRoamingState(slotId_) > 0) {
         roamingState = true;
@@ -2672,7 +3007,7 @@ void CellularDataHandler::GetDataConnApnAttr(ApnItem::Attribute &apnAttr) const
             if (apnItem == nullptr) {
                 continue;
             }
-            apnAttr = apnItem->attr_;
+            apnItem->attr_.ToAttribute(apnAttr);
             return;
         }
     }
@@ -2713,8 +3048,17 @@ int32_t CellularDataHandler::GetDataRecoveryState()
 void CellularDataHandler::HandleFactoryReset(const InnerEvent::Pointer &event)
 {
     TELEPHONY_LOGI("Slot%{public}d: factory reset", slotId_);
-    SetCellularDataEnable(true);
-    SetCellularDataRoamingEnabled(defaultDataRoamingEnable_);
+    if (dataSwitchSettings_ != nullptr) {
+        bool dataEnabled = true;
+        if (dataSwitchSettings_->QueryUserDataStatus(dataEnabled) == TELEPHONY_ERR_SUCCESS && !dataEnabled) {
+            SendDataSwitchChangeInfo(true);
+        }
+        // Both switches go back to their defaults in one settings batch.
+        int32_t result = dataSwitchSettings_->ResetUserDataSwitches(defaultDataRoamingEnable_);
+        if (result != TELEPHONY_ERR_SUCCESS) {
+            TELEPHONY_LOGE("Slot%{public}d: reset data switches failed %{public}d", slotId_, result);
+        }
+    }
     if (apnManager_ == nullptr) {
         TELEPHONY_LOGE("Slot%{public}d: apnManager_ is null", slotId_);
         return;
@@ -2877,46 +3221,10 @@ ApnActivateReportInfo CellularDataHandler::GetInternalActReportInfo()
 
 ApnActivateReportInfo CellularDataHandler::GetApnActReportInfo(uint32_t apnId)
 {
-    struct ApnActivateReportInfo info;
-    uint32_t totalDuration = 0;
-    uint32_t totalActTimes = 0;
-    uint32_t totalActSuccTimes = 0;
-    uint32_t topReason = 0;
-    uint32_t topReasonCnt = 0;
-    std::map<uint32_t, uint32_t> errorMap;
-    std::unique_lock<std::mutex> lock(apnActivateListMutex_);
-    EraseApnActivateList();
-    for (uint32_t i = 0; i < apnActivateChrList_.size(); i++) {
-        ApnActivateInfo info = apnActivateChrList_[i];
-        if (info.apnId != apnId) {
-            continue;
-        }
-        totalDuration += info.duration;
-        totalActTimes++;
-        if (info.reason == 0) {
-            totalActSuccTimes++;
-            continue;
-        }
-        if (errorMap.find(info.reason) != errorMap.end()) {
-            errorMap[info.reason] = errorMap[info.reason]+1;
-        } else {
-            errorMap[info.reason] = 1;
-        }
-    }
-    lock.unlock();
-    info.actTimes = totalActTimes;
-    info.actSuccTimes = totalActSuccTimes;
-    info.averDuration = totalActSuccTimes == 0 ? 0 : totalDuration / totalActSuccTimes;
-    std::map<uint32_t, uint32_t>::iterator iter;
-    for (iter = errorMap.begin(); iter != errorMap.end(); ++iter) {
-        if (iter->second > topReasonCnt) {
-            topReason = iter->first;
-            topReasonCnt = iter->second;
-        }
-    }
-    info.topReason = topReason;
-    TELEPHONY_LOGD("GetApnActReportInfo,%{public}d,%{public}d,%{public}d,%{public}d,%{public}d,",
-        totalDuration, totalActTimes, totalActSuccTimes, topReason, topReasonCnt);
+    std::lock_guard<std::mutex> lock(apnActivateStatsMutex_);
+    ApnActivateReportInfo info = apnActivateStats_.GetReportInfo(apnId, GetCurTime());
+    TELEPHONY_LOGD("GetApnActReportInfo,%{public}d,%{public}d,%{public}d,%{public}d,",
+        info.averDuration, info.actTimes, info.actSuccTimes, info.topReason);
     return info;
 }
 
@@ -2933,7 +3241,7 @@ void CellularDataHandler::SetApnActivateStart(const std::string &apnType)
 
 void CellularDataHandler::SetApnActivateEnd(const std::shared_ptr<SetupDataCallResultInfo> &resultInfo)
 {
-    struct ApnActivateInfo info;
+    struct ApnActivateInfo info = {};
     info.actSuccTime = GetCurTime();
     info.reason = resultInfo->reason;
     info.apnId = resultInfo->flag;
@@ -2945,22 +3253,11 @@ void CellularDataHandler::SetApnActivateEnd(const std::shared_ptr<SetupDataCallR
         && defaultApnActTime_ != 0) {
         info.duration = info.actSuccTime - defaultApnActTime_;
     }
-    std::lock_guard<std::mutex> lock(apnActivateListMutex_);
-    EraseApnActivateList();
-    apnActivateChrList_.push_back(info);
-}
-
-void CellularDataHandler::EraseApnActivateList()
-{
-    int64_t currentTime = GetCurTime();
-    for (std::vector<ApnActivateInfo>::iterator iter = apnActivateChrList_.begin();
-        iter != apnActivateChrList_.end();) {
-        if ((currentTime - iter->actSuccTime) > KEEP_APN_ACTIVATE_PERIOD) {
-            iter = apnActivateChrList_.erase(iter);
-        } else {
-            iter++;
-        }
+    if (info.duration > 0) {
+        CellularDataPerfStats::GetInstance().RecordSetupLatency(slotId_, info.duration);
     }
+    std::lock_guard<std::mutex> lock(apnActivateStatsMutex_);
+    apnActivateStats_.Record(info);
 }
 
 bool CellularDataHandler::IsBlockSetRilAttachApn()
@@ -15,6 +15,7 @@
 
 #include "cellular_data_rdb_observer.h"
 
+#include "apn_snapshot_cache.h"
 #include "cellular_data_event_code.h"
 
 namespace OHOS {
@@ -30,6 +31,7 @@ CellularDataRdbObserver::~CellularDataRdbObserver() = default;
 void CellularDataRdbObserver::OnChange()
 {
     TELEPHONY_LOGI("OnChange");
+    ApnSnapshotCache::GetInstance().InvalidateAll();
     auto cellularDataHandler = cellularDataHandler_.lock();
     if (cellularDataHandler == nullptr) {
         TELEPHONY_LOGE("cellularDataHandler is null");
@@ -16,10 +16,12 @@
 #include "cellular_data_service.h"
 
 #include <cinttypes>
+#include <condition_variable>
 
 #include "cellular_data_dump_helper.h"
 #include "cellular_data_error.h"
 #include "cellular_data_hisysevent.h"
+#include "cellular_data_startup.h"
 #include "cellular_data_utils.h"
 #include "core_manager_inner.h"
 #include "telephony_ext_wrapper.h"
@@ -33,6 +35,7 @@ namespace Telephony {
 using namespace NetManagerStandard;
 
 constexpr const char *PERSIST_EDM_MOBILE_DATA_POLICY = "persist.edm.mobile_data_policy";
+constexpr int64_t CONTROLLER_REGISTER_TIMEOUT_MS = 1000;
 constexpr const char *MOBILE_DATA_POLICY_FORCE_OPEN = "force_open";
 constexpr const char *MOBILE_DATA_POLICY_DISALLOW = "disallow";
 bool g_registerResult = SystemAbility::MakeAndRegisterAbility(&DelayedRefSingleton<CellularDataService>::GetInstance());
@@ -119,33 +122,90 @@ int32_t CellularDataService::GetIntelligenceSwitchState(bool &switchState)
 
 bool CellularDataService::Init()
 {
+    CellularDataStartup &startup = CellularDataStartup::GetInstance();
+    startup.Begin();
 #ifdef OHOS_BUILD_ENABLE_TELEPHONY_EXT
-    TELEPHONY_EXT_WRAPPER.InitTelephonyExtWrapper();
+    startup.RunCriticalPhase("telephonyExt", []() { TELEPHONY_EXT_WRAPPER.InitTelephonyExtWrapper(); });
 #endif
 #ifdef OHOS_BUILD_ENABLE_DATA_SERVICE_EXT
-    DATA_SERVICE_EXT_WRAPPER.InitDataServiceExtWrapper();
+    // Only the stall detection of an established connection uses this wrapper.
+    startup.AddDeferredPhase("dataServiceExt", []() { DATA_SERVICE_EXT_WRAPPER.InitDataServiceExtWrapper(); });
 #endif
-    InitModule();
+    startup.RunCriticalPhase("initModule", [this]() { InitModule(); });
+    startup.RunCriticalPhase("controllers", [this]() { RegisterControllers(); });
     if (!registerToService_) {
-        bool ret = Publish(DelayedRefSingleton<CellularDataService>::GetInstance().AsObject());
+        bool ret = false;
+        startup.RunCriticalPhase("publish", [this, &ret]() {
+            ret = Publish(DelayedRefSingleton<CellularDataService>::GetInstance().AsObject());
+        });
         if (!ret) {
             TELEPHONY_LOGE("Publish failed!");
             return false;
         }
         registerToService_ = true;
     }
-    std::lock_guard<std::mutex> guard(mapLock_);
-    for (const std::pair<const int32_t, std::shared_ptr<CellularDataController>> &it : cellularDataControllers_) {
-        if (it.second != nullptr) {
-            it.second->AsynchronousRegister();
-        } else {
-            TELEPHONY_LOGE("CellularDataController is null");
-        }
-    }
+    TELEPHONY_LOGI("init phase time: %{public}s", GetInitPhaseTime().c_str());
     isInitSuccess_ = true;
     return true;
 }
 
+void CellularDataService::RegisterControllers()
+{
+    std::vector<std::pair<int32_t, std::shared_ptr<CellularDataController>>> controllers;
+    {
+        std::lock_guard<std::mutex> guard(mapLock_);
+        for (const std::pair<const int32_t, std::shared_ptr<CellularDataController>> &it :
+            cellularDataControllers_) {
+            if (it.second != nullptr) {
+                controllers.emplace_back(it.first, it.second);
+            } else {
+                TELEPHONY_LOGE("CellularDataController is null");
+            }
+        }
+    }
+    struct RegisterLatch {
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t remaining = 0;
+    };
+    auto latch = std::make_shared<RegisterLatch>();
+    latch->remaining = controllers.size();
+    for (const auto &[slotId, controller] : controllers) {
+        RecordSlotInitTime(slotId, false);
+        controller->SetRegisteredCallback([this, latch](int32_t id) {
+            RecordSlotInitTime(id, true);
+            std::lock_guard<std::mutex> lock(latch->mutex);
+            latch->remaining--;
+            latch->cv.notify_all();
+        });
+        // Every controller owns an event runner, so the slots run Init and RegisterEvents side by side.
+        if (!controller->SendEvent(CellularDataEventCode::MSG_ASYNCHRONOUS_REGISTER_EVENT_ID, 0,
+            AppExecFwk::EventQueue::Priority::HIGH)) {
+            TELEPHONY_LOGE("Slot%{public}d: post controller register failed, register in place", slotId);
+            controller->AsynchronousRegister();
+        }
+    }
+    // A slot still waiting for core service keeps retrying on its runner, publish does not wait for it.
+    std::unique_lock<std::mutex> lock(latch->mutex);
+    if (!latch->cv.wait_for(lock, std::chrono::milliseconds(CONTROLLER_REGISTER_TIMEOUT_MS),
+        [latch]() { return latch->remaining == 0; })) {
+        TELEPHONY_LOGE("wait controller register timeout, %{public}zu slots pending", latch->remaining);
+    }
+}
+
+void CellularDataService::RecordSlotInitTime(int32_t slotId, bool isEnd)
+{
+    int64_t now =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    std::lock_guard<std::mutex> lock(slotInitTimeLock_);
+    if (isEnd) {
+        slotInitTime_[slotId].endTime = now;
+    } else {
+        slotInitTime_[slotId] = { now, 0L };
+    }
+}
+
 int32_t CellularDataService::IsCellularDataEnabled(bool &dataEnabled)
 {
     if (!TelephonyPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
@@ -556,6 +616,20 @@ std::string CellularDataService::GetEndTime()
     return oss.str();
 }
 
+std::string CellularDataService::GetBeginTime(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(slotInitTimeLock_);
+    auto it = slotInitTime_.find(slotId);
+    return std::to_string(it == slotInitTime_.end() ? 0L : it->second.beginTime);
+}
+
+std::string CellularDataService::GetEndTime(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(slotInitTimeLock_);
+    auto it = slotInitTime_.find(slotId);
+    return std::to_string(it == slotInitTime_.end() ? 0L : it->second.endTime);
+}
+
 std::string CellularDataService::GetCellularDataSlotIdDump()
 {
     std::ostringstream oss;
@@ -597,6 +671,22 @@ std::string CellularDataService::GetFlowDataInfoDump()
     return oss.str();
 }
 
+std::string CellularDataService::GetConnectionTrafficDump(int32_t slotId)
+{
+    std::ostringstream oss;
+    std::shared_ptr<CellularDataController> cellularDataController = GetCellularDataController(slotId);
+    if (cellularDataController == nullptr) {
+        return oss.str();
+    }
+    std::vector<ConnectionTrafficInfo> infoList;
+    cellularDataController->GetConnectionTrafficInfo(infoList);
+    for (const ConnectionTrafficInfo &info : infoList) {
+        oss << info.apnType << "(" << info.ifaceName << " cid " << info.cid << ") txPackets " << info.txPackets
+            << " rxPackets " << info.rxPackets << " txBytes " << info.txBytes << " rxBytes " << info.rxBytes << "; ";
+    }
+    return oss.str();
+}
+
 int32_t CellularDataService::StrategySwitch(int32_t slotId, bool enable)
 {
     std::shared_ptr<CellularDataController> cellularDataController = GetCellularDataController(slotId);
@@ -662,6 +752,28 @@ int64_t CellularDataService::GetSpendTime()
     return endTime_ - beginTime_;
 }
 
+int64_t CellularDataService::GetSpendTime(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(slotInitTimeLock_);
+    auto it = slotInitTime_.find(slotId);
+    if (it == slotInitTime_.end() || it->second.endTime == 0L) {
+        return -1L;
+    }
+    return it->second.endTime - it->second.beginTime;
+}
+
+std::string CellularDataService::GetInitPhaseTime()
+{
+    std::string result = CellularDataStartup::GetInstance().GetCriticalPhaseTime();
+    std::lock_guard<std::mutex> lock(slotInitTimeLock_);
+    for (const auto &[slotId, initTime] : slotInitTime_) {
+        result.append(" slot" + std::to_string(slotId) + "=");
+        result.append(initTime.endTime == 0L ? "pending" :
+            std::to_string(initTime.endTime - initTime.beginTime) + "ms");
+    }
+    return result;
+}
+
 int32_t CellularDataService::RegisterSimAccountCallback(const sptr<SimAccountCallback> &callback)
 {
     return CoreManagerInner::GetInstance().RegisterSimAccountCallback(GetTokenID(), callback);
@@ -995,6 +1107,22 @@ int32_t CellularDataService::GetActiveApnName(std::string &apnName)
     return 0;
 }
 
+int32_t CellularDataService::GetConnectionTrafficInfo(int32_t slotId, std::vector<ConnectionTrafficInfo> &infoList)
+{
+    if (!TelephonyPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
+        TELEPHONY_LOGE("Permission denied!");
+        return TELEPHONY_ERR_PERMISSION_ERR;
+    }
+    std::shared_ptr<CellularDataController> cellularDataController = GetCellularDataController(slotId);
+    if (cellularDataController == nullptr) {
+        TELEPHONY_LOGE("cellularDataControllers is null, slotId=%{public}d", slotId);
+        return CELLULAR_DATA_INVALID_PARAM;
+    }
+    infoList.clear();
+    bool result = cellularDataController->GetConnectionTrafficInfo(infoList);
+    return result ? TELEPHONY_ERR_SUCCESS : TELEPHONY_ERR_FAIL;
+}
+
 __attribute__((no_sanitize("cfi")))
 void CellularDataService::SendSlotChangeInfoToChr(int32_t slotId)
 {
@@ -15,6 +15,7 @@
 
 #include "data_connection_manager.h"
 
+#include "cellular_data_perf_stats.h"
 #include "cellular_data_utils.h"
 #include "core_manager_inner.h"
 #include "radio_event.h"
@@ -56,6 +57,9 @@ void DataConnectionManager::AddConnectionStateMachine(const std::shared_ptr<Cell
     if (stateMachine != nullptr) {
         stateMachines_.push_back(stateMachine);
     }
+    if (connectionMonitor_ != nullptr) {
+        connectionMonitor_->SetConnections(stateMachines_);
+    }
 }
 
 void DataConnectionManager::RemoveConnectionStateMachine(const std::shared_ptr<CellularDataStateMachine> &stateMachine)
@@ -72,6 +76,9 @@ void DataConnectionManager::RemoveConnectionStateMachine(const std::shared_ptr<C
             break;
         }
     }
+    if (connectionMonitor_ != nullptr) {
+        connectionMonitor_->SetConnections(stateMachines_);
+    }
 }
 
 std::vector<std::shared_ptr<CellularDataStateMachine>> DataConnectionManager::GetAllConnectionMachine()
@@ -189,6 +196,7 @@ bool CcmDefaultState::StateProcess(const AppExecFwk::InnerEvent::Pointer &event)
         TELEPHONY_LOGE("event is null");
         return false;
     }
+    PerfEventScope perfScope(connectManager_.GetSlotId(), PerfComponent::DATA_CONNECTION_MANAGER, event);
     int32_t id = event->GetInnerEventId();
     switch (id) {
         case RadioEvent::RADIO_CONNECTED:
@@ -332,6 +340,16 @@ int32_t DataConnectionManager::GetDataFlowType()
     return static_cast<int32_t>(flowType);
 }
 
+void DataConnectionManager::GetConnectionTraffic(std::vector<ConnectionTrafficInfo> &infoList)
+{
+    if (connectionMonitor_ == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: connection monitor is null", slotId_);
+        return;
+    }
+    connectionMonitor_->UpdateConnectionTraffic();
+    infoList = connectionMonitor_->GetConnectionTraffic();
+}
+
 void DataConnectionManager::SetDataFlowType(CellDataFlowType dataFlowType)
 {
     if (connectionMonitor_ == nullptr) {
@@ -13,9 +13,12 @@
  * limitations under the License.
  */
 
+#include <chrono>
+
 #include "core_manager_inner.h"
 
 #include "cellular_data_hisysevent.h"
+#include "cellular_data_perf_stats.h"
 #include "cellular_data_service.h"
 #include "data_service_ext_wrapper.h"
 #include "telephony_ext_wrapper.h"
@@ -37,6 +40,11 @@ void DataConnectionMonitor::HandleScreenStateChanged(bool isScreenOn)
         return;
     }
     isScreenOn_ = isScreenOn;
+    if (updateNetStat_) {
+        // Re-arm the flow type sampling at the rate of the new screen state.
+        RemoveEvent(CellularDataEventCode::MSG_RUN_MONITOR_TASK);
+        UpdateNetTrafficState();
+    }
     const int32_t defSlotId = CoreManagerInner::GetInstance().GetDefaultCellularDataSlotId();
     if (slotId_ != defSlotId && !IsVsimEnabled()) {
         return;
@@ -78,18 +86,34 @@ void DataConnectionMonitor::StartStallDetectionTimer()
 {
     TELEPHONY_LOGD("Slot%{public}d: start stall detection", slotId_);
     stallDetectionEnabled_ = true;
-    int32_t stallDetectionPeriod = GetStallDetectionPeriod();
+    int32_t stallDetectionPeriod = stallDetectionPolicy_.Reset(GetStallDetectionPeriod());
     TELEPHONY_LOGD("stallDetectionPeriod = %{public}d", stallDetectionPeriod);
-    if (!HasInnerEvent(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID)) {
-        AppExecFwk::InnerEvent::Pointer event =
-            AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID);
-        SendEvent(event, stallDetectionPeriod, Priority::LOW);
+    if (!StallDetectionTimer::GetInstance().IsScheduled(slotId_) &&
+        !HasInnerEvent(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID)) {
+        ScheduleStallDetection(stallDetectionPeriod);
     }
 }
 
+void DataConnectionMonitor::ScheduleStallDetection(int32_t delayMs)
+{
+    std::weak_ptr<AppExecFwk::EventHandler> weakMonitor = shared_from_this();
+    // The ticks of all slots share one timer, the tick itself still runs on this handler.
+    StallDetectionTimer::GetInstance().Schedule(slotId_, delayMs, [weakMonitor]() {
+        auto monitor = weakMonitor.lock();
+        if (monitor != nullptr) {
+            monitor->SendEvent(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID, 0, Priority::LOW);
+        }
+    });
+}
+
 __attribute__((no_sanitize("cfi"))) void DataConnectionMonitor::OnStallDetectionTimer()
 {
+    // A tick popped by the shared timer right before the stop may still arrive here.
+    if (!stallDetectionEnabled_) {
+        return;
+    }
     TELEPHONY_LOGD("Slot%{public}d: on stall detection", slotId_);
+    UpdateConnectionTraffic();
 #ifdef OHOS_BUILD_ENABLE_DATA_SERVICE_EXT
     if (DATA_SERVICE_EXT_WRAPPER.requestTcpAndDnsPackets_) {
         DATA_SERVICE_EXT_WRAPPER.requestTcpAndDnsPackets_();
@@ -105,12 +129,15 @@ __attribute__((no_sanitize("cfi"))) void DataConnectionMonitor::OnStallDetection
         HandleRecovery();
         noRecvPackets_ = 0;
     }
-    int32_t stallDetectionPeriod = GetStallDetectionPeriod();
+    StallDetectionSample sample;
+    sample.sentPackets = stallSentPackets_;
+    sample.recvPackets = stallRecvPackets_;
+    sample.screenOn = isScreenOn_;
+    sample.aggressiveRecovery = IsAggressiveRecovery();
+    int32_t stallDetectionPeriod = stallDetectionPolicy_.NextPeriod(sample);
     TELEPHONY_LOGD("stallDetectionPeriod = %{public}d", stallDetectionPeriod);
     if (!HasInnerEvent(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID) && stallDetectionEnabled_) {
-        AppExecFwk::InnerEvent::Pointer event =
-            AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID);
-        SendEvent(event, stallDetectionPeriod, Priority::LOW);
+        ScheduleStallDetection(stallDetectionPeriod);
     }
 }
 
@@ -118,9 +145,42 @@ void DataConnectionMonitor::StopStallDetectionTimer()
 {
     TELEPHONY_LOGD("Slot%{public}d: stop stall detection", slotId_);
     stallDetectionEnabled_ = false;
+    StallDetectionTimer::GetInstance().Cancel(slotId_);
     RemoveEvent(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID);
 }
 
+void DataConnectionMonitor::SetConnections(const std::vector<std::shared_ptr<CellularDataStateMachine>> &connections)
+{
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    connections_.assign(connections.begin(), connections.end());
+}
+
+void DataConnectionMonitor::UpdateConnectionTraffic()
+{
+    if (stallDetectionTrafficManager_ == nullptr) {
+        return;
+    }
+    std::vector<std::shared_ptr<CellularDataStateMachine>> connections;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (const std::weak_ptr<CellularDataStateMachine> &connection : connections_) {
+            auto stateMachine = connection.lock();
+            if (stateMachine != nullptr) {
+                connections.push_back(stateMachine);
+            }
+        }
+    }
+    stallDetectionTrafficManager_->UpdateConnectionTraffic(connections);
+}
+
+std::vector<ConnectionTrafficInfo> DataConnectionMonitor::GetConnectionTraffic()
+{
+    if (stallDetectionTrafficManager_ == nullptr) {
+        return {};
+    }
+    return stallDetectionTrafficManager_->GetConnectionTraffic();
+}
+
 void DataConnectionMonitor::UpdateFlowInfo()
 {
     if (stallDetectionTrafficManager_ == nullptr) {
@@ -136,6 +196,8 @@ void DataConnectionMonitor::UpdateFlowInfo()
     stallDetectionTrafficManager_->GetPacketData(currentSentPackets, currentRecvPackets);
     int64_t sentPackets = currentSentPackets - previousSentPackets;
     int64_t recvPackets = currentRecvPackets - previousRecvPackets;
+    stallSentPackets_ = sentPackets;
+    stallRecvPackets_ = recvPackets;
     if (sentPackets > 0 && recvPackets == 0) {
         noRecvPackets_ += sentPackets;
     } else if ((sentPackets > 0 && recvPackets > 0) || (sentPackets == 0 && recvPackets > 0)) {
@@ -154,6 +216,7 @@ void DataConnectionMonitor::HandleRecovery()
         dataRecoveryState_ = RecoveryState::STATE_REQUEST_CONTEXT_LIST;
         return;
     }
+    CellularDataPerfStats::GetInstance().IncreaseStallRecoveryCount(slotId_, dataRecoveryState_);
     switch (dataRecoveryState_) {
         case RecoveryState::STATE_REQUEST_CONTEXT_LIST: {
             TELEPHONY_LOGI("Slot%{public}d: Handle Recovery: get data call list", slotId_);
@@ -211,9 +274,8 @@ void DataConnectionMonitor::EndNetStatistics()
 {
     RemoveEvent(CellularDataEventCode::MSG_RUN_MONITOR_TASK);
     updateNetStat_ = false;
-    if (dataFlowType_ != CellDataFlowType::DATA_FLOW_TYPE_NONE) {
-        dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_NONE;
-        StateNotification::GetInstance().OnUpDataFlowtype(slotId_, dataFlowType_);
+    if (dataFlowTypeFilter_.Force(CellDataFlowType::DATA_FLOW_TYPE_NONE, GetSteadyTimeMs())) {
+        StateNotification::GetInstance().OnUpDataFlowtype(slotId_, dataFlowTypeFilter_.GetFlowType());
     }
 }
 
@@ -223,7 +285,7 @@ void DataConnectionMonitor::UpdateNetTrafficState()
         UpdateDataFlowType();
         AppExecFwk::InnerEvent::Pointer event =
             AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_RUN_MONITOR_TASK);
-        SendEvent(event, DEFAULT_NET_STATISTICS_PERIOD);
+        SendEvent(event, isScreenOn_ ? NET_STATISTICS_SCREEN_ON_PERIOD : DEFAULT_NET_STATISTICS_PERIOD);
     }
 }
 
@@ -284,38 +346,36 @@ void DataConnectionMonitor::UpdateDataFlowType()
     trafficManager_->GetPacketData(previousSentPackets, previousRecvPackets);
     trafficManager_->UpdatePacketData();
     trafficManager_->GetPacketData(currentSentPackets, currentRecvPackets);
-    int64_t sentPackets = currentSentPackets - previousSentPackets;
-    int64_t recvPackets = currentRecvPackets - previousRecvPackets;
-    CellDataFlowType previousDataFlowType = dataFlowType_;
-    if (previousSentPackets != 0 || previousRecvPackets != 0) {
-        if (sentPackets > 0 && recvPackets == 0) {
-            dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_UP;
-        } else if (sentPackets == 0 && recvPackets > 0) {
-            dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_DOWN;
-        } else if (sentPackets > 0 && recvPackets > 0) {
-            dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_UP_DOWN;
-        } else {
-            dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_NONE;
-        }
+    if (previousSentPackets == 0 && previousRecvPackets == 0) {
+        return;
     }
-    if (previousDataFlowType != dataFlowType_) {
-        StateNotification::GetInstance().OnUpDataFlowtype(slotId_, dataFlowType_);
+    CellDataFlowType sampleType = DataFlowTypeFilter::Classify(
+        currentSentPackets - previousSentPackets, currentRecvPackets - previousRecvPackets);
+    if (dataFlowTypeFilter_.Update(sampleType, GetSteadyTimeMs())) {
+        StateNotification::GetInstance().OnUpDataFlowtype(slotId_, dataFlowTypeFilter_.GetFlowType());
+    } else if (sampleType != dataFlowTypeFilter_.GetFlowType()) {
+        CellularDataPerfStats::GetInstance().IncreaseFlowTypeSuppressedCount(slotId_);
     }
 }
 
 CellDataFlowType DataConnectionMonitor::GetDataFlowType()
 {
-    return dataFlowType_;
+    return dataFlowTypeFilter_.GetFlowType();
 }
 
 void DataConnectionMonitor::SetDataFlowType(CellDataFlowType dataFlowType)
 {
-    if (dataFlowType_ != dataFlowType) {
-        dataFlowType_ = dataFlowType;
-        StateNotification::GetInstance().OnUpDataFlowtype(slotId_, dataFlowType_);
+    if (dataFlowTypeFilter_.Force(dataFlowType, GetSteadyTimeMs())) {
+        StateNotification::GetInstance().OnUpDataFlowtype(slotId_, dataFlowType);
     }
 }
 
+int64_t DataConnectionMonitor::GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void DataConnectionMonitor::IsNeedDoRecovery(bool needDoRecovery)
 {
     if (needDoRecovery) {
@@ -323,12 +383,11 @@ void DataConnectionMonitor::IsNeedDoRecovery(bool needDoRecovery)
     } else {
         dataRecoveryState_ = RecoveryState::STATE_REQUEST_CONTEXT_LIST;
     }
-    int32_t stallDetectionPeriod = GetStallDetectionPeriod();
+    // The ext wrapper judges the traffic itself, no packet counters are sampled on this path.
+    int32_t stallDetectionPeriod = stallDetectionPolicy_.Reset(GetStallDetectionPeriod());
     TELEPHONY_LOGD("stallDetectionPeriod = %{public}d", stallDetectionPeriod);
     if (!HasInnerEvent(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID) && stallDetectionEnabled_) {
-        AppExecFwk::InnerEvent::Pointer event =
-            AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_STALL_DETECTION_EVENT_ID);
-        SendEvent(event, stallDetectionPeriod, Priority::LOW);
+        ScheduleStallDetection(stallDetectionPeriod);
     }
 }
 
@@ -338,6 +397,7 @@ void DataConnectionMonitor::ProcessEvent(const AppExecFwk::InnerEvent::Pointer &
         TELEPHONY_LOGE("Slot%{public}d: event is null", slotId_);
         return;
     }
+    PerfEventScope perfScope(slotId_, PerfComponent::DATA_CONNECTION_MONITOR, event);
     uint32_t eventID = event->GetInnerEventId();
     switch (eventID) {
         case CellularDataEventCode::MSG_RUN_MONITOR_TASK: {
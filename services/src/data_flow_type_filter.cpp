@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "data_flow_type_filter.h"
+
+namespace OHOS {
+namespace Telephony {
+DataFlowTypeFilter::DataFlowTypeFilter(const DataFlowTypeConfig &config) : config_(config) {}
+
+CellDataFlowType DataFlowTypeFilter::Classify(int64_t sentPackets, int64_t recvPackets)
+{
+    if (sentPackets > 0 && recvPackets > 0) {
+        return CellDataFlowType::DATA_FLOW_TYPE_UP_DOWN;
+    }
+    if (sentPackets > 0) {
+        return CellDataFlowType::DATA_FLOW_TYPE_UP;
+    }
+    if (recvPackets > 0) {
+        return CellDataFlowType::DATA_FLOW_TYPE_DOWN;
+    }
+    return CellDataFlowType::DATA_FLOW_TYPE_NONE;
+}
+
+bool DataFlowTypeFilter::Update(CellDataFlowType sampleType, int64_t nowMs)
+{
+    if (sampleType == flowType_) {
+        candidateSamples_ = 0;
+        return false;
+    }
+    if (sampleType == candidateType_ && candidateSamples_ > 0) {
+        candidateSamples_++;
+    } else {
+        candidateType_ = sampleType;
+        candidateSamples_ = 1;
+    }
+    if (candidateSamples_ < config_.hysteresisSamples || nowMs - lastChangeMs_ < config_.minDwellMs) {
+        return false;
+    }
+    return Force(sampleType, nowMs);
+}
+
+bool DataFlowTypeFilter::Force(CellDataFlowType flowType, int64_t nowMs)
+{
+    candidateSamples_ = 0;
+    if (flowType == flowType_) {
+        return false;
+    }
+    flowType_ = flowType;
+    lastChangeMs_ = nowMs;
+    return true;
+}
+
+CellDataFlowType DataFlowTypeFilter::GetFlowType() const
+{
+    return flowType_;
+}
+} // namespace Telephony
+} // namespace OHOS
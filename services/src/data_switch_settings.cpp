@@ -22,16 +22,30 @@
 
 namespace OHOS {
 namespace Telephony {
-DataSwitchSettings::DataSwitchSettings(int32_t slotId) : slotId_(slotId) {}
+DataSwitchSettings::DataSwitchSettings(int32_t slotId) : userDataRoamingSimId_(INVALID_SIM_ID), slotId_(slotId) {}
 
 void DataSwitchSettings::LoadSwitchValue()
 {
+    InvalidateUserDataStatus();
+    InvalidateUserDataRoamingStatus();
     bool dataEnabled = false;
     bool dataRoamingEnabled = false;
     QueryUserDataStatus(dataEnabled);
     QueryUserDataRoamingStatus(dataRoamingEnabled);
     TELEPHONY_LOGI("slotId:%{public}d userDataOn_:%{public}d userDataRoaming_:%{public}d policyDataOn_:%{public}d",
-        slotId_, userDataOn_, userDataRoaming_, policyDataOn_);
+        slotId_, userDataOn_.load(), userDataRoaming_.load(), policyDataOn_);
+}
+
+void DataSwitchSettings::InvalidateUserDataStatus()
+{
+    userDataOnGeneration_++;
+    userDataOnCached_.store(false, std::memory_order_release);
+}
+
+void DataSwitchSettings::InvalidateUserDataRoamingStatus()
+{
+    userDataRoamingGeneration_++;
+    userDataRoamingSimId_.store(INVALID_SIM_ID, std::memory_order_release);
 }
 
 bool DataSwitchSettings::IsInternalDataOn() const
@@ -60,11 +74,14 @@ int32_t DataSwitchSettings::SetUserDataOn(bool userDataOn)
                             : static_cast<int>(DataSwitchCode::CELLULAR_DATA_DISABLED));
     HILOG_COMM_IMPL(LOG_INFO, LOG_DOMAIN, TELEPHONY_LOG_TAG, "value:%{public}d", value);
     bool userDataOnTmp = userDataOn_;
+    bool userDataOnCachedTmp = userDataOnCached_;
     userDataOn_ = userDataOn;
+    userDataOnCached_ = true;
     Uri userDataEnableUri(CELLULAR_DATA_SETTING_DATA_ENABLE_URI);
     int32_t result = settingsRdbHelper->PutValue(userDataEnableUri, CELLULAR_DATA_COLUMN_ENABLE, value);
     if (result != TELEPHONY_ERR_SUCCESS) {
         userDataOn_ = userDataOnTmp;
+        userDataOnCached_ = userDataOnCachedTmp;
     }
     return result;
 }
@@ -82,6 +99,36 @@ int32_t DataSwitchSettings::SetAnySimDetected(int32_t simDetected)
     return result;
 }
 
+int32_t DataSwitchSettings::SetUserDataOnAndSimDetected(bool userDataOn, int32_t simDetected)
+{
+    // For the VSIM card, no need to save switch state.
+    if (slotId_ == CELLULAR_DATA_VSIM_SLOT_ID) {
+        return SetAnySimDetected(simDetected);
+    }
+    std::shared_ptr<CellularDataSettingsRdbHelper> settingsRdbHelper = CellularDataSettingsRdbHelper::GetInstance();
+    if (settingsRdbHelper == nullptr) {
+        TELEPHONY_LOGE("settingsRdbHelper == nullptr!");
+        return TELEPHONY_ERR_LOCAL_PTR_NULL;
+    }
+    int value = (userDataOn ? static_cast<int>(DataSwitchCode::CELLULAR_DATA_ENABLED)
+                            : static_cast<int>(DataSwitchCode::CELLULAR_DATA_DISABLED));
+    HILOG_COMM_IMPL(LOG_INFO, LOG_DOMAIN, TELEPHONY_LOG_TAG, "value:%{public}d simDetected:%{public}d", value,
+        simDetected);
+    userDataOn_ = userDataOn;
+    userDataOnCached_ = true;
+    std::vector<SettingsValueEntry> entries = {
+        { CELLULAR_DATA_SETTING_DATA_ENABLE_URI, CELLULAR_DATA_COLUMN_ENABLE, value },
+        { CELLULAR_DATA_SETTING_ANY_SIM_DETECTED_URI, SIM_DETECTED_COLUMN_ENABLE, simDetected },
+    };
+    int32_t result = settingsRdbHelper->PutValues(entries);
+    if (result != TELEPHONY_ERR_SUCCESS) {
+        // The keys are not written atomically, the data switch may hold either value now.
+        InvalidateUserDataStatus();
+    }
+    TELEPHONY_LOGI("DataSwitchSettings::SetUserDataOnAndSimDetected result:%{public}d", result);
+    return result;
+}
+
 int32_t DataSwitchSettings::SetIntelliSwitchOn(bool userSwitchOn)
 {
     std::shared_ptr<CellularDataSettingsRdbHelper> settingsRdbHelper = CellularDataSettingsRdbHelper::GetInstance();
@@ -108,11 +155,16 @@ int32_t DataSwitchSettings::QueryUserDataStatus(bool &dataEnabled)
         dataEnabled = true;
         return TELEPHONY_ERR_SUCCESS;
     }
+    if (userDataOnCached_.load(std::memory_order_acquire)) {
+        dataEnabled = userDataOn_;
+        return TELEPHONY_ERR_SUCCESS;
+    }
     std::shared_ptr<CellularDataSettingsRdbHelper> settingsRdbHelper = CellularDataSettingsRdbHelper::GetInstance();
     if (settingsRdbHelper == nullptr) {
         TELEPHONY_LOGE("settingsRdbHelper is nullptr!");
         return TELEPHONY_ERR_LOCAL_PTR_NULL;
     }
+    uint32_t generation = userDataOnGeneration_;
     Uri userDataEnableUri(CELLULAR_DATA_SETTING_DATA_ENABLE_URI);
     int32_t userDataEnable = static_cast<int32_t>(DataSwitchCode::CELLULAR_DATA_ENABLED);
     lastQryRet_ = settingsRdbHelper->GetValue(userDataEnableUri, CELLULAR_DATA_COLUMN_ENABLE, userDataEnable);
@@ -122,6 +174,9 @@ int32_t DataSwitchSettings::QueryUserDataStatus(bool &dataEnabled)
     }
     userDataOn_ = (userDataEnable == static_cast<int32_t>(DataSwitchCode::CELLULAR_DATA_ENABLED));
     dataEnabled = userDataOn_;
+    if (generation == userDataOnGeneration_) {
+        userDataOnCached_.store(true, std::memory_order_release);
+    }
     return TELEPHONY_ERR_SUCCESS;
 }
 
@@ -183,7 +238,47 @@ int32_t DataSwitchSettings::SetUserDataRoamingOn(bool dataRoamingEnabled)
         userDataRoamingUri, std::string(CELLULAR_DATA_COLUMN_ROAMING) + std::to_string(simId), value);
     if (result == TELEPHONY_ERR_SUCCESS) {
         userDataRoaming_ = dataRoamingEnabled;
+        userDataRoamingSimId_.store(simId, std::memory_order_release);
+    }
+    return result;
+}
+
+int32_t DataSwitchSettings::ResetUserDataSwitches(bool dataRoamingEnabled)
+{
+    // For the VSIM card, no need to save switch state.
+    if (slotId_ == CELLULAR_DATA_VSIM_SLOT_ID) {
+        TELEPHONY_LOGI("ResetUserDataSwitches, no need for slot %{public}d", slotId_);
+        return TELEPHONY_ERR_SUCCESS;
+    }
+    std::shared_ptr<CellularDataSettingsRdbHelper> settingsRdbHelper = CellularDataSettingsRdbHelper::GetInstance();
+    if (settingsRdbHelper == nullptr) {
+        TELEPHONY_LOGE("settingsRdbHelper is nullptr!");
+        return TELEPHONY_ERR_LOCAL_PTR_NULL;
+    }
+    // A switch already holding its default is left alone, so its observers are not woken up.
+    std::vector<SettingsValueEntry> entries;
+    bool dataEnabled = false;
+    if (QueryUserDataStatus(dataEnabled) != TELEPHONY_ERR_SUCCESS || !dataEnabled) {
+        entries.push_back({ CELLULAR_DATA_SETTING_DATA_ENABLE_URI, CELLULAR_DATA_COLUMN_ENABLE,
+            static_cast<int>(DataSwitchCode::CELLULAR_DATA_ENABLED) });
+    }
+    int32_t simId = CoreManagerInner::GetInstance().GetSimId(slotId_);
+    bool currentDataRoamEnabled = dataRoamingEnabled;
+    if (simId > INVALID_SIM_ID && (QueryUserDataRoamingStatus(currentDataRoamEnabled) != TELEPHONY_ERR_SUCCESS ||
+        currentDataRoamEnabled != dataRoamingEnabled)) {
+        entries.push_back({ std::string(CELLULAR_DATA_SETTING_DATA_ROAMING_URI) + std::to_string(simId),
+            std::string(CELLULAR_DATA_COLUMN_ROAMING) + std::to_string(simId),
+            dataRoamingEnabled ? static_cast<int>(RoamingSwitchCode::CELLULAR_DATA_ROAMING_ENABLED)
+                               : static_cast<int>(RoamingSwitchCode::CELLULAR_DATA_ROAMING_DISABLED) });
+    }
+    if (entries.empty()) {
+        return TELEPHONY_ERR_SUCCESS;
     }
+    int32_t result = settingsRdbHelper->PutValues(entries);
+    TELEPHONY_LOGI("Slot%{public}d: reset %{public}zu switches result:%{public}d", slotId_, entries.size(), result);
+    // Either way the cached values are stale, the next query reads what has actually been written.
+    InvalidateUserDataStatus();
+    InvalidateUserDataRoamingStatus();
     return result;
 }
 
@@ -205,6 +300,12 @@ int32_t DataSwitchSettings::QueryUserDataRoamingStatus(bool &dataRoamingEnabled)
         TELEPHONY_LOGE("Slot%{public}d: invalid sim id %{public}d", slotId_, simId);
         return TELEPHONY_ERR_LOCAL_PTR_NULL;
     }
+    // The roaming switch is stored per sim, a value cached for the former card does not apply.
+    if (userDataRoamingSimId_.load(std::memory_order_acquire) == simId) {
+        dataRoamingEnabled = userDataRoaming_;
+        return TELEPHONY_ERR_SUCCESS;
+    }
+    uint32_t generation = userDataRoamingGeneration_;
     Uri userDataRoamingUri(std::string(CELLULAR_DATA_SETTING_DATA_ROAMING_URI) + std::to_string(simId));
     int32_t userDataRoamingValue = static_cast<int32_t>(RoamingSwitchCode::CELLULAR_DATA_ROAMING_DISABLED);
     int32_t ret = settingsRdbHelper->GetValue(
@@ -215,6 +316,9 @@ int32_t DataSwitchSettings::QueryUserDataRoamingStatus(bool &dataRoamingEnabled)
     }
     userDataRoaming_ = (userDataRoamingValue == static_cast<int32_t>(RoamingSwitchCode::CELLULAR_DATA_ROAMING_ENABLED));
     dataRoamingEnabled = userDataRoaming_;
+    if (generation == userDataRoamingGeneration_) {
+        userDataRoamingSimId_.store(simId, std::memory_order_release);
+    }
     return TELEPHONY_ERR_SUCCESS;
 }
 
@@ -251,8 +355,8 @@ bool DataSwitchSettings::IsAllowActiveData() const
     if (userDataOn_ && policyDataOn_ && internalDataOn_) {
         return true;
     } else {
-        TELEPHONY_LOGD("Activation not allowed[user:%{public}d policy:%{public}d internal:%{public}d]", userDataOn_,
-            policyDataOn_, internalDataOn_);
+        TELEPHONY_LOGD("Activation not allowed[user:%{public}d policy:%{public}d internal:%{public}d]",
+            userDataOn_.load(), policyDataOn_, internalDataOn_);
         return false;
     }
 }
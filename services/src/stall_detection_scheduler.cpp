@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stall_detection_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+static const std::string STALL_DETECTION_TIMER_TASK = "StallDetectionTimer";
+static constexpr double RECV_RATIO_SMOOTH_FACTOR = 0.25;
+static constexpr double RECV_RATIO_DEGRADE_FACTOR = 0.5;
+static constexpr int64_t TIMER_SLACK_DIVISOR = 4;
+
+int32_t StallDetectionPolicy::Reset(int32_t basePeriodMs)
+{
+    periodMs_ = basePeriodMs;
+    recvRatio_ = -1.0;
+    return periodMs_;
+}
+
+int32_t StallDetectionPolicy::GetPeriod() const
+{
+    return periodMs_;
+}
+
+bool StallDetectionPolicy::IsDegrading(const StallDetectionSample &sample) const
+{
+    if (sample.sentPackets <= 0) {
+        return false;
+    }
+    if (sample.recvPackets <= 0) {
+        return true;
+    }
+    double ratio = static_cast<double>(sample.recvPackets) / static_cast<double>(sample.sentPackets);
+    return recvRatio_ > 0 && ratio < recvRatio_ * RECV_RATIO_DEGRADE_FACTOR;
+}
+
+int32_t StallDetectionPolicy::NextPeriod(const StallDetectionSample &sample)
+{
+    if (sample.aggressiveRecovery) {
+        periodMs_ = DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+        return periodMs_;
+    }
+    if (!sample.screenOn) {
+        // Background traffic is not worth a faster wakeup, keep the screen off period whatever the link does.
+        periodMs_ = DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+    } else if (IsDegrading(sample)) {
+        periodMs_ = std::max(DATA_STALL_ALARM_MIN_DELAY_IN_MS,
+            std::min(periodMs_, DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT) / 2);
+    } else if (sample.sentPackets > 0 || sample.recvPackets > 0) {
+        periodMs_ = DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+    } else {
+        periodMs_ = (periodMs_ >= DATA_STALL_ALARM_IDLE_MAX_DELAY_IN_MS / 2) ? DATA_STALL_ALARM_IDLE_MAX_DELAY_IN_MS :
+            periodMs_ * 2;
+    }
+    if (sample.sentPackets > 0 && sample.recvPackets > 0) {
+        double ratio = static_cast<double>(sample.recvPackets) / static_cast<double>(sample.sentPackets);
+        recvRatio_ = (recvRatio_ < 0) ? ratio :
+            (recvRatio_ * (1 - RECV_RATIO_SMOOTH_FACTOR) + ratio * RECV_RATIO_SMOOTH_FACTOR);
+    }
+    return periodMs_;
+}
+
+void StallDetectionTimerQueue::Schedule(int32_t slotId, int64_t nowMs, int64_t delayMs)
+{
+    delayMs = std::max<int64_t>(delayMs, 0);
+    Entry &entry = entries_[slotId];
+    entry.deadlineMs = nowMs + delayMs;
+    entry.earliestMs = entry.deadlineMs - delayMs / TIMER_SLACK_DIVISOR;
+}
+
+void StallDetectionTimerQueue::Cancel(int32_t slotId)
+{
+    entries_.erase(slotId);
+}
+
+bool StallDetectionTimerQueue::IsScheduled(int32_t slotId) const
+{
+    return entries_.find(slotId) != entries_.end();
+}
+
+int64_t StallDetectionTimerQueue::GetNextFireTime() const
+{
+    int64_t fireMs = -1;
+    for (const auto &[slotId, entry] : entries_) {
+        if (fireMs < 0 || entry.deadlineMs < fireMs) {
+            fireMs = entry.deadlineMs;
+        }
+    }
+    return fireMs;
+}
+
+std::vector<int32_t> StallDetectionTimerQueue::PopDue(int64_t nowMs)
+{
+    std::vector<int32_t> dueSlots;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.earliestMs <= nowMs) {
+            dueSlots.push_back(it->first);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return dueSlots;
+}
+
+StallDetectionTimer &StallDetectionTimer::GetInstance()
+{
+    static StallDetectionTimer instance;
+    return instance;
+}
+
+int64_t StallDetectionTimer::GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void StallDetectionTimer::Schedule(int32_t slotId, int64_t delayMs, const Tick &tick)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.Schedule(slotId, GetSteadyTimeMs(), delayMs);
+    ticks_[slotId] = tick;
+    RearmLocked();
+}
+
+void StallDetectionTimer::Cancel(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.Cancel(slotId);
+    ticks_.erase(slotId);
+    RearmLocked();
+}
+
+bool StallDetectionTimer::IsScheduled(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.IsScheduled(slotId);
+}
+
+void StallDetectionTimer::RearmLocked()
+{
+    int64_t fireMs = queue_.GetNextFireTime();
+    if (fireMs == armedFireMs_) {
+        return;
+    }
+    if (handler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("StallDetectionTimer");
+        if (runner == nullptr) {
+            TELEPHONY_LOGE("create stall detection timer runner failed");
+            return;
+        }
+        handler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    handler_->RemoveTask(STALL_DETECTION_TIMER_TASK);
+    armedFireMs_ = -1;
+    if (fireMs < 0) {
+        return;
+    }
+    int64_t delayMs = std::max<int64_t>(fireMs - GetSteadyTimeMs(), 0);
+    if (handler_->PostTask([this]() { OnFire(); }, STALL_DETECTION_TIMER_TASK, delayMs)) {
+        armedFireMs_ = fireMs;
+    } else {
+        TELEPHONY_LOGE("post stall detection timer failed");
+    }
+}
+
+void StallDetectionTimer::OnFire()
+{
+    std::vector<Tick> dueTicks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        armedFireMs_ = -1;
+        wakeupCount_++;
+        for (int32_t slotId : queue_.PopDue(GetSteadyTimeMs())) {
+            auto it = ticks_.find(slotId);
+            if (it != ticks_.end()) {
+                dueTicks.push_back(it->second);
+                ticks_.erase(it);
+            }
+        }
+        tickCount_ += dueTicks.size();
+        RearmLocked();
+    }
+    for (const Tick &tick : dueTicks) {
+        if (tick != nullptr) {
+            tick();
+        }
+    }
+}
+
+void StallDetectionTimer::Dump(std::string &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.append("Stall detection timer: wakeups=" + std::to_string(wakeupCount_));
+    result.append(" ticks=" + std::to_string(tickCount_) + "\n");
+}
+} // namespace Telephony
+} // namespace OHOS
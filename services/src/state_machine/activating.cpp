@@ -16,6 +16,7 @@
 #include "activating.h"
 
 #include "cellular_data_hisysevent.h"
+#include "cellular_data_setup_tracer.h"
 #include "inactive.h"
 #include "radio_event.h"
 #include "apn_manager.h"
@@ -84,6 +85,8 @@ bool Activating::RilActivatePdpContextDone(const AppExecFwk::InnerEvent::Pointer
     } else {
         TELEPHONY_LOGE("cdConnectionManager is null");
     }
+    CellularDataSetupTracer::GetInstance().Mark(
+        stateMachine->GetSlotId(), stateMachine->apnId_, SetupTraceStage::RIL_ACTIVATE_DONE);
     stateMachine->DeferEvent(std::move(event));
     stateMachine->TransitionTo(stateMachine->activeState_);
     return true;
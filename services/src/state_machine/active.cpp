@@ -48,15 +48,7 @@ bool Active::StateProcess(const AppExecFwk::InnerEvent::Pointer &event)
         TELEPHONY_LOGE("event is null");
         return false;
     }
-    bool retVal = false;
-    uint32_t eventCode = event->GetInnerEventId();
-    std::map<uint32_t, Fun>::iterator it = eventIdFunMap_.find(eventCode);
-    if (it != eventIdFunMap_.end()) {
-        if (it->second != nullptr) {
-            return it->second(event);
-        }
-    }
-    return retVal;
+    return eventTable_.Dispatch(*this, event);
 }
 
 bool Active::ProcessConnectDone(const AppExecFwk::InnerEvent::Pointer &event)
@@ -20,6 +20,7 @@
 #include "active.h"
 #include "apn_manager.h"
 #include "cellular_data_hisysevent.h"
+#include "cellular_data_setup_tracer.h"
 #include "cellular_data_utils.h"
 #include "core_manager_inner.h"
 #include "default.h"
@@ -75,6 +76,7 @@ bool CellularDataStateMachine::IsDefaultState() const
 
 void CellularDataStateMachine::SetCapability(uint64_t capability)
 {
+    std::lock_guard<std::mutex> guard(mtx_);
     capability_ = capability;
 }
 
@@ -90,6 +92,7 @@ int32_t CellularDataStateMachine::GetCid() const
 
 void CellularDataStateMachine::SetCid(const int32_t cid)
 {
+    std::lock_guard<std::mutex> guard(mtx_);
     cid_ = cid;
 }
 
@@ -107,6 +110,23 @@ sptr<ApnItem> CellularDataStateMachine::GetApnItem() const
     return apnItem_;
 }
 
+std::string CellularDataStateMachine::GetIfName()
+{
+    std::lock_guard<std::mutex> guard(mtx_);
+    return ifName_;
+}
+
+CellularDataStateMachine::TrafficSnapshot CellularDataStateMachine::GetTrafficSnapshot()
+{
+    std::lock_guard<std::mutex> guard(mtx_);
+    TrafficSnapshot snapshot;
+    snapshot.isActive = currentState_ != nullptr && currentState_ == activeState_;
+    snapshot.ifName = ifName_;
+    snapshot.cid = cid_;
+    snapshot.capability = capability_;
+    return snapshot;
+}
+
 static void FillActivateDataParam(ActivateDataParam& activeDataParam, sptr<ApnItem> apn)
 {
     activeDataParam.dataProfile.profileId = apn->attr_.profileId_;
@@ -141,17 +161,16 @@ void CellularDataStateMachine::DoConnect(const DataConnectionParams &connectionP
     activeDataParam.isRoaming = connectionParams.GetUserDataRoaming();
     FillActivateDataParam(activeDataParam, apn);
     if (IS_SUPPORT_NR_SLICE) {
-        GetNetworkSlicePara(connectionParams, apn);
         activeDataParam.dataProfile.snssai = apn->attr_.snssai_;
         activeDataParam.dataProfile.sscMode = apn->attr_.sscMode_;
-        activeDataParam.dataProfile.apn = apn->attr_.apn_;
-        activeDataParam.dataProfile.protocol = apn->attr_.protocol_;
+        GetNetworkSlicePara(connectionParams, activeDataParam.dataProfile);
     }
     int32_t bitMap = ApnManager::FindApnTypeByApnName(connectionParams.GetApnHolder()->GetApnType());
     activeDataParam.dataProfile.supportedApnTypesBitmap = bitMap;
     HILOG_COMM_IMPL(LOG_INFO, LOG_DOMAIN, TELEPHONY_LOG_TAG,
         "Slot%{public}d: Activate PDP context (%{public}d, %{public}s, %{public}s, %{public}s, %{public}d)",
-        slotId, apn->attr_.profileId_, apn->attr_.apn_, apn->attr_.protocol_, apn->attr_.types_, bitMap);
+        slotId, apn->attr_.profileId_, activeDataParam.dataProfile.apn.c_str(),
+        activeDataParam.dataProfile.protocol.c_str(), apn->attr_.types_.c_str(), bitMap);
     int32_t result = CoreManagerInner::GetInstance().ActivatePdpContext(slotId, RadioEvent::RADIO_RIL_SETUP_DATA_CALL,
         activeDataParam, stateMachineEventHandler_);
     if (result != TELEPHONY_ERR_SUCCESS) {
@@ -214,6 +233,7 @@ int32_t CellularDataStateMachine::OnInterfaceLinkStateChanged(const std::string
         return 0;
     }
     lock.unlock();
+    CellularDataNetAgent::GetInstance().InvalidateCellIface(GetSlotId());
     if (!up) {
         if (stateMachineEventHandler_ == nullptr) {
             TELEPHONY_LOGE("stateMachineEventHandler_ is nullptr");
@@ -269,6 +289,7 @@ void CellularDataStateMachine::Init()
 
 void CellularDataStateMachine::SetCurrentState(std::shared_ptr<State> state)
 {
+    std::lock_guard<std::mutex> guard(mtx_);
     currentState_ = state;
 }
 
@@ -344,30 +365,11 @@ void CellularDataStateMachine::GetMtuSizeFromOpCfg(int32_t &mtuSize, int32_t slo
 
 void CellularDataStateMachine::SplitProxyIpAddress(const std::string &proxyIpAddress, std::string &host, uint16_t &port)
 {
-    std::vector<std::string> address;
-    size_t pos = 0;
-    size_t found = 0;
-    while ((found = proxyIpAddress.find(':', pos)) != std::string::npos) {
-        address.push_back(proxyIpAddress.substr(pos, found - pos));
-        pos = found + 1;
-    }
-    address.push_back(proxyIpAddress.substr(pos));
-    if (address.size() == HOST_SIZE) {
-        host = address[0];
-    }
-    if (address.size() == HOST_PORT_SIZE) {
-        host = address[0];
-        if (!address[1].empty() && IsValidDecValue(address[1])) {
-            port = static_cast<uint16_t>(std::stoi(address[1]));
-        }
-    }
+    ApnItem::ParseProxyAddress(proxyIpAddress, host, port);
 }
 
-void CellularDataStateMachine::UpdateHttpProxy(const std::string &proxyIpAddress)
+void CellularDataStateMachine::UpdateHttpProxy(const std::string &host, uint16_t port)
 {
-    std::string host = "";
-    uint16_t port = DEFAULT_PORT;
-    SplitProxyIpAddress(proxyIpAddress, host, port);
     HttpProxy httpProxy = { host, port, {} };
     netLinkInfo_->httpProxy_ = httpProxy;
 }
@@ -422,10 +424,12 @@ void CellularDataStateMachine::UpdateNetworkInfo(const SetupDataCallResultInfo &
     netSupplierInfo_->score_ = GetNetScoreBySlotId(slotId);
     cause_ = dataCallInfo.reason;
     CellularDataNetAgent &netAgent = CellularDataNetAgent::GetInstance();
+    netAgent.InvalidateCellIface(slotId);
     int32_t supplierId = netAgent.GetSupplierId(slotId, capability_);
     netAgent.UpdateNetSupplierInfo(supplierId, netSupplierInfo_);
     if (netSupplierInfo_->isAvailable_) {
         netAgent.UpdateNetLinkInfo(supplierId, netLinkInfo_);
+        CellularDataSetupTracer::GetInstance().Mark(slotId, apnId_, SetupTraceStage::UPDATE_NETWORK_INFO);
     }
 }
 
@@ -434,6 +438,7 @@ void CellularDataStateMachine::UpdateNetworkInfo()
     std::lock_guard<std::mutex> guard(mtx_);
     int32_t slotId = GetSlotId();
     CellularDataNetAgent &netAgent = CellularDataNetAgent::GetInstance();
+    netAgent.InvalidateCellIface(slotId);
     netLinkInfo_->tcpBufferSizes_ = tcpBuffer_;
     netSupplierInfo_->linkUpBandwidthKbps_ = upBandwidth_;
     netSupplierInfo_->linkDownBandwidthKbps_ = downBandwidth_;
@@ -552,7 +557,8 @@ uint64_t CellularDataStateMachine::GetReuseApnCap() const
     return reuseApnCap_;
 }
 
-void CellularDataStateMachine::GetNetworkSlicePara(const DataConnectionParams& connectionParams, sptr<ApnItem> apn)
+void CellularDataStateMachine::GetNetworkSlicePara(const DataConnectionParams& connectionParams,
+    DataProfile &dataProfile)
 {
     std::string apnType = connectionParams.GetApnHolder()->GetApnType();
     bool isNrSa = false;
@@ -566,7 +572,7 @@ void CellularDataStateMachine::GetNetworkSlicePara(const DataConnectionParams& c
     if (!isNrSa) {
         return;
     }
-    std::string dnn = apn->attr_.apn_;
+    std::string dnn = dataProfile.apn;
     TELEPHONY_LOGI("GetNetworkSlicePara apnType = %{public}s, dnn = %{public}s",
         apnType.c_str(), dnn.c_str());
     if (apnType.find("snssai") != std::string::npos) {
@@ -575,18 +581,15 @@ void CellularDataStateMachine::GetNetworkSlicePara(const DataConnectionParams& c
         std::map<std::string, std::string> networkSliceParas;
         DelayedSingleton<NetManagerStandard::NetworkSliceClient>::GetInstance()->GetRSDByNetCap(
             netcap, networkSliceParas);
-        FillRSDFromNetCap(networkSliceParas, apn);
+        FillRSDFromNetCap(networkSliceParas, dataProfile);
     } else if (!dnn.empty()) {
         std::string snssai;
         uint8_t sscMode = 0;
         DelayedSingleton<NetManagerStandard::NetworkSliceClient>::GetInstance()->GetRouteSelectionDescriptorByDNN(
             dnn, snssai, sscMode);
-        apn->attr_.sscMode_ = sscMode;
+        dataProfile.sscMode = sscMode;
         if (!snssai.empty()) {
-            std::fill(apn->attr_.snssai_, apn->attr_.snssai_ + ApnItem::ALL_APN_ITEM_CHAR_LENGTH, '\0');
-            size_t len = std::min(snssai.size(), static_cast<size_t>(ApnItem::ALL_APN_ITEM_CHAR_LENGTH - 1));
-            std::copy(snssai.begin(), snssai.begin() + len, apn->attr_.snssai_);
-            apn->attr_.snssai_[len] = '\0';
+            dataProfile.snssai = snssai.substr(0, ApnItem::ALL_APN_ITEM_CHAR_LENGTH - 1);
         }
         TELEPHONY_LOGI("GetRouteSelectionDescriptorByDNN snssai = %{public}s, sscmode = %{public}d",
             snssai.c_str(), sscMode);
@@ -594,38 +597,25 @@ void CellularDataStateMachine::GetNetworkSlicePara(const DataConnectionParams& c
 }
 
 void CellularDataStateMachine::FillRSDFromNetCap(
-    std::map<std::string, std::string> networkSliceParas, sptr<ApnItem> apn)
+    std::map<std::string, std::string> networkSliceParas, DataProfile &dataProfile)
 {
     if (networkSliceParas["sscmode"] != "0") {
         int sscMode = 0;
         std::from_chars(networkSliceParas["sscmode"].data(), networkSliceParas["sscmode"].data() +
             networkSliceParas["sscmode"].size(), sscMode);
-        apn->attr_.sscMode_ = sscMode;
+        dataProfile.sscMode = sscMode;
     }
 
-    constexpr size_t BUF_SIZE = ApnItem::ALL_APN_ITEM_CHAR_LENGTH;
-    constexpr size_t MAX_COPY = BUF_SIZE - 1;
+    constexpr size_t MAX_COPY = ApnItem::ALL_APN_ITEM_CHAR_LENGTH - 1;
 
     if (networkSliceParas["snssai"] != "") {
-        std::string snssai = networkSliceParas["snssai"];
-        std::fill(apn->attr_.snssai_, apn->attr_.snssai_ + BUF_SIZE, '\0');
-        size_t len = std::min(snssai.size(), MAX_COPY);
-        std::copy(snssai.begin(), snssai.begin() + len, apn->attr_.snssai_);
-        apn->attr_.snssai_[len] = '\0';
+        dataProfile.snssai = networkSliceParas["snssai"].substr(0, MAX_COPY);
     }
     if (networkSliceParas["dnn"] != "") {
-        std::string dnn = networkSliceParas["dnn"];
-        std::fill(apn->attr_.apn_, apn->attr_.apn_ + BUF_SIZE, '\0');
-        size_t len = std::min(dnn.size(), MAX_COPY);
-        std::copy(dnn.begin(), dnn.begin() + len, apn->attr_.apn_);
-        apn->attr_.apn_[len] = '\0';
+        dataProfile.apn = networkSliceParas["dnn"].substr(0, MAX_COPY);
     }
     if (networkSliceParas["pdusessiontype"] != "0") {
-        std::string pdusessiontype = networkSliceParas["pdusessiontype"];
-        std::fill(apn->attr_.protocol_, apn->attr_.protocol_ + BUF_SIZE, '\0');
-        size_t len = std::min(pdusessiontype.size(), MAX_COPY);
-        std::copy(pdusessiontype.begin(), pdusessiontype.begin() + len, apn->attr_.protocol_);
-        apn->attr_.protocol_[len] = '\0';
+        dataProfile.protocol = networkSliceParas["pdusessiontype"].substr(0, MAX_COPY);
     }
     TELEPHONY_LOGI("FillRSD: snssai = %{public}s, sscmode = %{public}s, dnn = %{public}s, pdusession = %{public}s",
         networkSliceParas["snssai"].c_str(), networkSliceParas["sscmode"].c_str(), networkSliceParas["dnn"].c_str(),
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "cellular_data_state_machine_pool.h"
+
+#include <algorithm>
+
+#include "cellular_data_perf_stats.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+CellularDataStateMachinePool::CellularDataStateMachinePool(
+    int32_t slotId, const Creator &creator, size_t warmCount, size_t maxIdleCount)
+    : slotId_(slotId), creator_(creator), warmCount_(std::min(warmCount, maxIdleCount)), maxIdleCount_(maxIdleCount)
+{
+    freeList_.reserve(maxIdleCount_);
+}
+
+bool CellularDataStateMachinePool::NeedPreWarm()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return freeList_.size() < warmCount_;
+}
+
+size_t CellularDataStateMachinePool::PreWarm()
+{
+    size_t created = 0;
+    while (NeedPreWarm()) {
+        std::shared_ptr<CellularDataStateMachine> stateMachine = Create();
+        if (stateMachine == nullptr) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeList_.push_back(stateMachine);
+        created++;
+    }
+    if (created > 0) {
+        TELEPHONY_LOGI("Slot%{public}d: pre-warmed %{public}zu state machines", slotId_, created);
+    }
+    return created;
+}
+
+std::shared_ptr<CellularDataStateMachine> CellularDataStateMachinePool::Acquire(const IdleChecker &isIdle)
+{
+    std::shared_ptr<CellularDataStateMachine> stateMachine;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.acquireCount++;
+        while (!freeList_.empty()) {
+            std::shared_ptr<CellularDataStateMachine> candidate = std::move(freeList_.back());
+            freeList_.pop_back();
+            // A machine picked up again behind the pool's back is dropped here, it comes back on its next release.
+            if (candidate != nullptr && (isIdle == nullptr || isIdle(candidate))) {
+                stats_.hitCount++;
+                stateMachine = std::move(candidate);
+                break;
+            }
+        }
+    }
+    CellularDataPerfStats::GetInstance().RecordStateMachinePoolAcquire(slotId_, stateMachine != nullptr);
+    return stateMachine;
+}
+
+std::shared_ptr<CellularDataStateMachine> CellularDataStateMachinePool::Create()
+{
+    std::shared_ptr<CellularDataStateMachine> stateMachine = creator_ ? creator_() : nullptr;
+    if (stateMachine == nullptr) {
+        TELEPHONY_LOGE("Slot%{public}d: create state machine failed", slotId_);
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.createCount++;
+    return stateMachine;
+}
+
+bool CellularDataStateMachinePool::Release(const std::shared_ptr<CellularDataStateMachine> &stateMachine)
+{
+    if (stateMachine == nullptr) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (std::find(freeList_.begin(), freeList_.end(), stateMachine) != freeList_.end()) {
+        return true;
+    }
+    if (freeList_.size() >= maxIdleCount_) {
+        stats_.retireCount++;
+        return false;
+    }
+    freeList_.push_back(stateMachine);
+    return true;
+}
+
+size_t CellularDataStateMachinePool::GetIdleCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return freeList_.size();
+}
+
+StateMachinePoolStats CellularDataStateMachinePool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -36,17 +36,11 @@ bool Default::StateProcess(const AppExecFwk::InnerEvent::Pointer &event)
         TELEPHONY_LOGE("event is null");
         return false;
     }
-    std::shared_ptr<CellularDataStateMachine> stateMachine = stateMachine_.lock();
-    if (stateMachine == nullptr) {
+    if (stateMachine_.expired()) {
         TELEPHONY_LOGE("stateMachine is null");
         return false;
     }
-    uint32_t eventCode = event->GetInnerEventId();
-    std::map<uint32_t, Fun>::iterator it = eventIdFunMap_.find(eventCode);
-    if (it != eventIdFunMap_.end()) {
-        return it->second(event);
-    }
-    return false;
+    return eventTable_.Dispatch(*this, event);
 }
 
 bool Default::ProcessConnectDone(const AppExecFwk::InnerEvent::Pointer &event)
@@ -235,17 +235,11 @@ bool IdleState::StateProcess(const AppExecFwk::InnerEvent::Pointer &event)
         TELEPHONY_LOGE("event is null");
         return NOT_PROCESSED;
     }
-    std::shared_ptr<IncallDataStateMachine> stateMachine = stateMachine_.lock();
-    if (stateMachine == nullptr) {
+    if (stateMachine_.expired()) {
         TELEPHONY_LOGE("stateMachine is null");
         return NOT_PROCESSED;
     }
-    uint32_t eventCode = event->GetInnerEventId();
-    std::map<uint32_t, Fun>::iterator it = eventIdFunMap_.find(eventCode);
-    if (it != eventIdFunMap_.end()) {
-        return it->second(event);
-    }
-    return NOT_PROCESSED;
+    return eventTable_.Dispatch(*this, event);
 }
 
 bool IdleState::ProcessCallStarted(const AppExecFwk::InnerEvent::Pointer &event)
@@ -352,17 +346,11 @@ bool SecondaryActiveState::StateProcess(const AppExecFwk::InnerEvent::Pointer &e
         TELEPHONY_LOGE("event is null");
         return NOT_PROCESSED;
     }
-    std::shared_ptr<IncallDataStateMachine> stateMachine = stateMachine_.lock();
-    if (stateMachine == nullptr) {
+    if (stateMachine_.expired()) {
         TELEPHONY_LOGE("stateMachine is null");
         return NOT_PROCESSED;
     }
-    uint32_t eventCode = event->GetInnerEventId();
-    std::map<uint32_t, Fun>::iterator it = eventIdFunMap_.find(eventCode);
-    if (it != eventIdFunMap_.end()) {
-        return it->second(event);
-    }
-    return NOT_PROCESSED;
+    return eventTable_.Dispatch(*this, event);
 }
 
 bool SecondaryActiveState::ProcessSettingsOn(const AppExecFwk::InnerEvent::Pointer &event)
@@ -15,30 +15,180 @@
 
 #include "state_notification.h"
 
+#include <chrono>
+#include <vector>
+
 #include "telephony_log_wrapper.h"
 #include "telephony_state_registry_client.h"
 
 namespace OHOS {
 namespace Telephony {
+static constexpr const char *STATE_NOTIFICATION_FLUSH_TASK = "StateNotificationFlush";
+
+static std::shared_ptr<AppExecFwk::EventHandler> GetDispatchHandler()
+{
+    static std::shared_ptr<AppExecFwk::EventHandler> handler = []() -> std::shared_ptr<AppExecFwk::EventHandler> {
+        auto runner = AppExecFwk::EventRunner::Create("StateNotification");
+        if (runner == nullptr) {
+            TELEPHONY_LOGE("create state notification runner failed");
+            return nullptr;
+        }
+        return std::make_shared<AppExecFwk::EventHandler>(runner);
+    }();
+    return handler;
+}
+
 StateNotification StateNotification::stateNotification_;
 StateNotification &StateNotification::GetInstance()
 {
     return stateNotification_;
 }
 
+int64_t StateNotification::GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void StateNotification::UpdateCellularDataConnectState(int32_t slotId, ApnProfileState dataState, int32_t networkType)
 {
     int32_t state = CellularDataStateAdapter(dataState);
     int32_t wrapState = WrapCellularDataState(state);
-    TELEPHONY_LOGI(
-        "slotId = %{public}d, wrapState = %{public}d, networkType = %{public}d", slotId, wrapState, networkType);
-    TelephonyStateRegistryClient::GetInstance().UpdateCellularDataConnectState(slotId, wrapState, networkType);
+    int64_t nowMs = GetSteadyTimeMs();
+    bool scheduled = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SlotState &slot = slots_[slotId];
+        if (slot.connectPending) {
+            // Replaced before it was dispatched.
+            slot.connectPending = false;
+            stats_.suppressedCount++;
+        }
+        if (slot.hasConnectState && slot.connectState == wrapState && slot.networkType == networkType) {
+            stats_.suppressedCount++;
+            return;
+        }
+        slot.connectPending = true;
+        slot.pendingConnectState = wrapState;
+        slot.pendingNetworkType = networkType;
+        bool isConnecting = wrapState == static_cast<int32_t>(DataConnectState::DATA_STATE_CONNECTING);
+        slot.connectDueMs = isConnecting ? nowMs + debounceWindowMs_ : nowMs;
+        scheduled = ScheduleFlushLocked(slot.connectDueMs, nowMs);
+    }
+    if (!scheduled) {
+        Flush();
+    }
 }
 
 void StateNotification::OnUpDataFlowtype(int32_t slotId, CellDataFlowType flowType)
 {
-    TELEPHONY_LOGI("slotId = %{public}d, flowType = %{public}d", slotId, flowType);
-    TelephonyStateRegistryClient::GetInstance().UpdateCellularDataFlow(slotId, static_cast<int32_t>(flowType));
+    int32_t type = static_cast<int32_t>(flowType);
+    int64_t nowMs = GetSteadyTimeMs();
+    bool scheduled = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SlotState &slot = slots_[slotId];
+        if (slot.flowPending) {
+            slot.flowPending = false;
+            stats_.suppressedCount++;
+        }
+        if (slot.hasFlowType && slot.flowType == type) {
+            stats_.suppressedCount++;
+            return;
+        }
+        slot.flowPending = true;
+        slot.pendingFlowType = type;
+        scheduled = ScheduleFlushLocked(nowMs, nowMs);
+    }
+    if (!scheduled) {
+        Flush();
+    }
+}
+
+void StateNotification::SetDebounceWindow(int64_t windowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    debounceWindowMs_ = windowMs < 0 ? 0 : windowMs;
+}
+
+bool StateNotification::ScheduleFlushLocked(int64_t dueMs, int64_t nowMs)
+{
+    if (flushDueMs_ >= 0 && flushDueMs_ <= dueMs) {
+        return true;
+    }
+    auto handler = GetDispatchHandler();
+    if (handler == nullptr) {
+        return false;
+    }
+    handler->RemoveTask(STATE_NOTIFICATION_FLUSH_TASK);
+    int64_t delayMs = dueMs > nowMs ? dueMs - nowMs : 0;
+    if (!handler->PostTask([this]() { Flush(); }, STATE_NOTIFICATION_FLUSH_TASK, delayMs)) {
+        flushDueMs_ = -1;
+        return false;
+    }
+    flushDueMs_ = dueMs;
+    return true;
+}
+
+void StateNotification::Flush()
+{
+    std::vector<PendingPublish> publishes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t nowMs = GetSteadyTimeMs();
+        int64_t nextDueMs = -1;
+        flushDueMs_ = -1;
+        for (auto &[slotId, slot] : slots_) {
+            if (slot.connectPending && slot.connectDueMs <= nowMs) {
+                slot.connectPending = false;
+                slot.hasConnectState = true;
+                slot.connectState = slot.pendingConnectState;
+                slot.networkType = slot.pendingNetworkType;
+                publishes.push_back({ slotId, true, slot.connectState, slot.networkType });
+            } else if (slot.connectPending && (nextDueMs < 0 || slot.connectDueMs < nextDueMs)) {
+                nextDueMs = slot.connectDueMs;
+            }
+            if (slot.flowPending) {
+                slot.flowPending = false;
+                slot.hasFlowType = true;
+                slot.flowType = slot.pendingFlowType;
+                publishes.push_back({ slotId, false, slot.flowType, 0 });
+            }
+        }
+        stats_.publishedCount += publishes.size();
+        if (nextDueMs >= 0 && !ScheduleFlushLocked(nextDueMs, nowMs)) {
+            TELEPHONY_LOGE("schedule state notification failed");
+        }
+    }
+    for (const PendingPublish &publish : publishes) {
+        Publish(publish);
+    }
+}
+
+void StateNotification::Publish(const PendingPublish &publish)
+{
+    if (publish.isConnectState) {
+        TELEPHONY_LOGI("slotId = %{public}d, wrapState = %{public}d, networkType = %{public}d",
+            publish.slotId, publish.state, publish.networkType);
+        TelephonyStateRegistryClient::GetInstance().UpdateCellularDataConnectState(
+            publish.slotId, publish.state, publish.networkType);
+        return;
+    }
+    TELEPHONY_LOGI("slotId = %{public}d, flowType = %{public}d", publish.slotId, publish.state);
+    TelephonyStateRegistryClient::GetInstance().UpdateCellularDataFlow(publish.slotId, publish.state);
+}
+
+StateNotificationStats StateNotification::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void StateNotification::Dump(std::string &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.append("State notification: published=" + std::to_string(stats_.publishedCount));
+    result.append(" suppressed=" + std::to_string(stats_.suppressedCount) + "\n");
 }
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
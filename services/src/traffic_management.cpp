@@ -15,8 +15,17 @@
 
 #include "traffic_management.h"
 
+#include <cerrno>
 #include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <net/if.h>
+#include <unistd.h>
+
+#include "apn_manager.h"
 #include "cellular_data_net_agent.h"
+#include "cellular_data_state_machine.h"
 #include "data_flow_statistics.h"
 #include "net_conn_client.h"
 #include "telephony_log_wrapper.h"
@@ -24,6 +33,9 @@
 namespace OHOS {
 namespace Telephony {
 using namespace NetManagerStandard;
+static constexpr size_t IFACE_COUNTER_PATH_SIZE = 128;
+static constexpr size_t IFACE_COUNTER_BUFFER_SIZE = 32;
+static constexpr int32_t DECIMAL_BASE = 10;
 
 TrafficManagement::TrafficManagement(int32_t slotId) : slotId_(slotId) {}
 
@@ -37,9 +49,9 @@ void TrafficManagement::GetPacketData(int64_t &sendPackets, int64_t &recvPackets
 
 void TrafficManagement::UpdatePacketData()
 {
-    DataFlowStatistics dataState;
     const std::string interfaceName = GetIfaceName();
-    if (!interfaceName.empty()) {
+    if (!interfaceName.empty() && !ReadPacketsFromKernel(interfaceName)) {
+        DataFlowStatistics dataState;
         sendPackets_ = dataState.GetIfaceTxPackets(interfaceName);
         recvPackets_ = dataState.GetIfaceRxPackets(interfaceName);
     }
@@ -47,10 +59,138 @@ void TrafficManagement::UpdatePacketData()
         slotId_, sendPackets_, recvPackets_);
 }
 
+bool TrafficManagement::ReadPacketsFromKernel(const std::string &ifaceName)
+{
+    if (!kernelCounterReadable_) {
+        return false;
+    }
+    int64_t sendPackets = 0;
+    int64_t recvPackets = 0;
+    int32_t ret = ReadIfaceCounter(ifaceName, "tx_packets", sendPackets);
+    if (ret == 0) {
+        ret = ReadIfaceCounter(ifaceName, "rx_packets", recvPackets);
+    }
+    if (ret == 0) {
+        sendPackets_ = sendPackets;
+        recvPackets_ = recvPackets;
+        return true;
+    }
+    if (ret == ENOENT) {
+        // The interface is gone, resolve it again on the next update.
+        CellularDataNetAgent::GetInstance().InvalidateCellIface(slotId_);
+    } else {
+        TELEPHONY_LOGE("Slot%{public}d: kernel counters not readable, errno %{public}d", slotId_, ret);
+        kernelCounterReadable_ = false;
+    }
+    return false;
+}
+
+int32_t TrafficManagement::ReadIfaceCounter(const std::string &ifaceName, const char *counter, int64_t &value)
+{
+    char path[IFACE_COUNTER_PATH_SIZE] = { 0 };
+    int len = snprintf(path, sizeof(path), "/sys/class/net/%s/statistics/%s", ifaceName.c_str(), counter);
+    if (len <= 0 || static_cast<size_t>(len) >= sizeof(path)) {
+        return EINVAL;
+    }
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+    char buffer[IFACE_COUNTER_BUFFER_SIZE] = { 0 };
+    ssize_t size = read(fd, buffer, sizeof(buffer) - 1);
+    int32_t readErrno = errno;
+    close(fd);
+    if (size <= 0) {
+        return size < 0 ? readErrno : EIO;
+    }
+    buffer[size] = '\0';
+    char *end = nullptr;
+    long long counterValue = strtoll(buffer, &end, DECIMAL_BASE);
+    if (end == buffer || counterValue < 0) {
+        return EIO;
+    }
+    value = static_cast<int64_t>(counterValue);
+    return 0;
+}
+
+void TrafficManagement::UpdateConnectionTraffic(
+    const std::vector<std::shared_ptr<CellularDataStateMachine>> &connections)
+{
+    std::vector<ConnectionTrafficInfo> traffic;
+    for (const std::shared_ptr<CellularDataStateMachine> &connection : connections) {
+        if (connection == nullptr) {
+            continue;
+        }
+        // Called from IPC and dump threads, read the connection fields together under its lock.
+        CellularDataStateMachine::TrafficSnapshot snapshot = connection->GetTrafficSnapshot();
+        if (!snapshot.isActive || snapshot.ifName.empty()) {
+            continue;
+        }
+        ConnectionTrafficInfo info;
+        info.ifaceName = snapshot.ifName;
+        info.apnType = ApnManager::FindApnNameByApnId(ApnManager::FindApnIdByCapability(snapshot.capability));
+        info.cid = snapshot.cid;
+        traffic.push_back(info);
+    }
+    if (!traffic.empty()) {
+        std::map<int32_t, LinkStats> linkStats;
+        bool dumped = ReadLinkStats(linkStats);
+        for (ConnectionTrafficInfo &info : traffic) {
+            ReadConnectionCounters(dumped ? &linkStats : nullptr, info);
+        }
+    }
+    std::lock_guard<std::mutex> lock(connectionTrafficMutex_);
+    connectionTraffic_.swap(traffic);
+}
+
+std::vector<ConnectionTrafficInfo> TrafficManagement::GetConnectionTraffic()
+{
+    std::lock_guard<std::mutex> lock(connectionTrafficMutex_);
+    return connectionTraffic_;
+}
+
+bool TrafficManagement::ReadLinkStats(std::map<int32_t, LinkStats> &linkStats)
+{
+    if (!linkStatsReadable_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    int32_t ret = LinkStatsReader::ReadAll(linkStats);
+    if (ret == EPERM || ret == EACCES || ret == EOPNOTSUPP || ret == EPROTONOSUPPORT) {
+        // Denied by policy or not supported by the kernel, it will not change until reboot.
+        TELEPHONY_LOGE("Slot%{public}d: link stats not readable, errno %{public}d", slotId_, ret);
+        linkStatsReadable_.store(false, std::memory_order_relaxed);
+    }
+    return ret == 0;
+}
+
+void TrafficManagement::ReadConnectionCounters(const std::map<int32_t, LinkStats> *linkStats,
+    ConnectionTrafficInfo &info)
+{
+    if (linkStats != nullptr) {
+        auto it = linkStats->find(static_cast<int32_t>(if_nametoindex(info.ifaceName.c_str())));
+        if (it != linkStats->end()) {
+            info.txPackets = it->second.txPackets;
+            info.rxPackets = it->second.rxPackets;
+            info.txBytes = it->second.txBytes;
+            info.rxBytes = it->second.rxBytes;
+        }
+        return;
+    }
+    ReadIfaceCounter(info.ifaceName, "tx_packets", info.txPackets);
+    ReadIfaceCounter(info.ifaceName, "rx_packets", info.rxPackets);
+    ReadIfaceCounter(info.ifaceName, "tx_bytes", info.txBytes);
+    ReadIfaceCounter(info.ifaceName, "rx_bytes", info.rxBytes);
+}
+
 std::string TrafficManagement::GetIfaceName()
 {
     std::string ifaceName = "";
-    int32_t netId = CellularDataNetAgent::GetInstance().GetCellNetId(slotId_);
+    int32_t netId = -1;
+    CellularDataNetAgent &netAgent = CellularDataNetAgent::GetInstance();
+    if (netAgent.GetCachedCellIface(slotId_, netId, ifaceName)) {
+        return ifaceName;
+    }
+    netId = netAgent.GetCellNetId(slotId_);
     // LCOV_EXCL_START
     if (netId < 0) {
         return ifaceName;
@@ -60,6 +200,9 @@ std::string TrafficManagement::GetIfaceName()
     NetLinkInfo info;
     NetConnClient::GetInstance().GetConnectionProperties(netHandle, info);
     ifaceName = info.ifaceName_;
+    if (!ifaceName.empty()) {
+        netAgent.CacheCellIface(slotId_, netId, ifaceName);
+    }
     TELEPHONY_LOGD("Slot%{public}d: data is connected ifaceName = %{public}s", slotId_, ifaceName.c_str());
     return ifaceName;
 }
@@ -135,18 +135,18 @@ void CellularDataHiSysEvent::WriteApnInfoBehaviorEvent(const int32_t slotId, spt
     if (apnItem == nullptr) {
         return;
     }
-    int32_t apnHasPsd = strlen(apnItem->attr_.password_) == 0 ? 0 : 1;
+    int32_t apnHasPsd = apnItem->attr_.password_.empty() ? 0 : 1;
     HiWriteBehaviorEvent(APN_INFO_EVENT,
         CARDID_KEY, slotId,
-        CARRIER_KEY, apnItem->attr_.apnName_,
-        APN_KEY, apnItem->attr_.apn_,
-        PROXY_KEY, apnItem->attr_.proxyIpAddress_,
-        MMSPROXY_KEY, apnItem->attr_.mmsIpAddress_,
-        NUMERIC_KEY, apnItem->attr_.numeric_,
+        CARRIER_KEY, apnItem->attr_.apnName_.c_str(),
+        APN_KEY, apnItem->attr_.apn_.c_str(),
+        PROXY_KEY, apnItem->attr_.proxyIpAddress_.c_str(),
+        MMSPROXY_KEY, apnItem->attr_.mmsIpAddress_.c_str(),
+        NUMERIC_KEY, apnItem->attr_.numeric_.c_str(),
         AUTHTYPE_KEY, apnItem->attr_.authType_,
-        APNTYPES_KEY, apnItem->attr_.types_,
-        PROTOCOL_KEY, apnItem->attr_.protocol_,
-        ROAMINGPROTOCOL_KEY, apnItem->attr_.roamingProtocol_,
+        APNTYPES_KEY, apnItem->attr_.types_.c_str(),
+        PROTOCOL_KEY, apnItem->attr_.protocol_.c_str(),
+        ROAMINGPROTOCOL_KEY, apnItem->attr_.roamingProtocol_.c_str(),
         BEARER_KEY, "",
         MVNOTYPE_KEY, "",
         MVNOMATCHDATA_KEY, "",
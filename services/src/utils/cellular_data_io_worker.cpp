@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cellular_data_io_worker.h"
+
+#include <algorithm>
+
+#include "cellular_data_perf_stats.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+CellularDataIoWorker &CellularDataIoWorker::GetInstance()
+{
+    static CellularDataIoWorker instance;
+    return instance;
+}
+
+bool CellularDataIoWorker::IsValidSlotId(int32_t slotId)
+{
+    return slotId >= 0 && slotId < IO_WORKER_SLOT_NUM;
+}
+
+std::shared_ptr<AppExecFwk::EventHandler> CellularDataIoWorker::GetWorkerHandler(int32_t slotId)
+{
+    int32_t index = IsValidSlotId(slotId) ? slotId % IO_WORKER_NUM : 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (workerHandlers_[index] == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("CellularDataIo" + std::to_string(index));
+        if (runner == nullptr) {
+            TELEPHONY_LOGE("create cellular data io runner %{public}d failed", index);
+            return nullptr;
+        }
+        workerHandlers_[index] = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    return workerHandlers_[index];
+}
+
+bool CellularDataIoWorker::PostTask(int32_t slotId, const std::function<void()> &task)
+{
+    auto handler = GetWorkerHandler(slotId);
+    if (handler == nullptr || task == nullptr) {
+        return false;
+    }
+    UpdatePendingCount(slotId, true);
+    int64_t postUs = CellularDataPerfStats::GetSteadyTimeUs();
+    bool ret = handler->PostTask([this, slotId, task, postUs]() {
+        int64_t beginUs = CellularDataPerfStats::GetSteadyTimeUs();
+        task();
+        int64_t endUs = CellularDataPerfStats::GetSteadyTimeUs();
+        RecordTask(slotId, beginUs - postUs, endUs - beginUs);
+    });
+    if (!ret) {
+        TELEPHONY_LOGE("Slot%{public}d: post io task failed", slotId);
+        UpdatePendingCount(slotId, false);
+    }
+    return ret;
+}
+
+void CellularDataIoWorker::UpdatePendingCount(int32_t slotId, bool isPosted)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t &pendingCount = stats_[slotId].pendingCount;
+    if (isPosted) {
+        pendingCount++;
+    } else if (pendingCount > 0) {
+        pendingCount--;
+    }
+}
+
+void CellularDataIoWorker::RecordTask(int32_t slotId, int64_t waitUs, int64_t costUs)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    IoWorkerStats &stats = stats_[slotId];
+    stats.taskCount++;
+    if (stats.pendingCount > 0) {
+        stats.pendingCount--;
+    }
+    stats.totalWaitUs += waitUs;
+    stats.maxWaitUs = std::max(stats.maxWaitUs, waitUs);
+    stats.totalCostUs += costUs;
+    stats.maxCostUs = std::max(stats.maxCostUs, costUs);
+}
+
+void CellularDataIoWorker::Dump(std::string &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int32_t i = 0; i < IO_WORKER_SLOT_NUM; ++i) {
+        const IoWorkerStats &stats = stats_[i];
+        if (stats.taskCount == 0 && stats.pendingCount == 0) {
+            continue;
+        }
+        int64_t count = std::max(static_cast<int64_t>(stats.taskCount), static_cast<int64_t>(1));
+        result.append("Slot" + std::to_string(i) + " io worker: tasks=" + std::to_string(stats.taskCount));
+        result.append(" pending=" + std::to_string(stats.pendingCount));
+        result.append(" avgWaitUs=" + std::to_string(stats.totalWaitUs / count));
+        result.append(" maxWaitUs=" + std::to_string(stats.maxWaitUs));
+        result.append(" avgCostUs=" + std::to_string(stats.totalCostUs / count));
+        result.append(" maxCostUs=" + std::to_string(stats.maxCostUs) + "\n");
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -281,5 +281,31 @@ void CellularDataNetAgent::NetDetection(int32_t netId)
     NetManagerStandard::NetHandle netHandle(netId);
     (void)NetConnClient::GetInstance().NetDetection(netHandle);
 }
+
+bool CellularDataNetAgent::GetCachedCellIface(int32_t slotId, int32_t &netId, std::string &ifaceName)
+{
+    std::lock_guard<std::mutex> lock(cellIfaceMutex_);
+    auto it = cellIfaces_.find(slotId);
+    if (it == cellIfaces_.end()) {
+        return false;
+    }
+    netId = it->second.netId;
+    ifaceName = it->second.ifaceName;
+    return true;
+}
+
+void CellularDataNetAgent::CacheCellIface(int32_t slotId, int32_t netId, const std::string &ifaceName)
+{
+    std::lock_guard<std::mutex> lock(cellIfaceMutex_);
+    CellIface &cellIface = cellIfaces_[slotId];
+    cellIface.netId = netId;
+    cellIface.ifaceName = ifaceName;
+}
+
+void CellularDataNetAgent::InvalidateCellIface(int32_t slotId)
+{
+    std::lock_guard<std::mutex> lock(cellIfaceMutex_);
+    cellIfaces_.erase(slotId);
+}
 } // namespace Telephony
 } // namespace OHOS
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cellular_data_perf_stats.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int64_t PERF_LATENCY_BUCKET_BOUNDS_US[PERF_LATENCY_BUCKET_NUM - 1] = {
+    100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000
+};
+static constexpr uint32_t PERCENT_50 = 50;
+static constexpr uint32_t PERCENT_90 = 90;
+static constexpr uint32_t PERCENT_99 = 99;
+static constexpr uint32_t PERCENT_MAX = 100;
+static const char *PERF_COMPONENT_NAME[] = {
+    "CellularDataHandler", "DataConnectionManager", "DataConnectionMonitor"
+};
+static const char *PERF_RECOVERY_STATE_NAME[PERF_RECOVERY_STATE_NUM] = {
+    "requestContextList", "cleanupConnections", "reregisterNetwork", "radioRestart"
+};
+
+CellularDataPerfStats &CellularDataPerfStats::GetInstance()
+{
+    static CellularDataPerfStats instance;
+    return instance;
+}
+
+int64_t CellularDataPerfStats::GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool CellularDataPerfStats::IsValidSlotId(int32_t slotId)
+{
+    return slotId >= 0 && slotId < MAX_PERF_SLOT_NUM;
+}
+
+size_t CellularDataPerfStats::GetBucketIndex(int64_t costUs)
+{
+    for (size_t i = 0; i < PERF_LATENCY_BUCKET_NUM - 1; ++i) {
+        if (costUs < PERF_LATENCY_BUCKET_BOUNDS_US[i]) {
+            return i;
+        }
+    }
+    return PERF_LATENCY_BUCKET_NUM - 1;
+}
+
+void CellularDataPerfStats::RecordEvent(
+    int32_t slotId, PerfComponent component, uint32_t eventId, int64_t waitUs, int64_t costUs)
+{
+    if (!IsValidSlotId(slotId) || component >= PerfComponent::PERF_COMPONENT_BUTT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    PerfLatencyHistogram &histogram = slotStats_[slotId].eventStats[static_cast<size_t>(component)][eventId];
+    histogram.count++;
+    histogram.totalCostUs += costUs;
+    histogram.maxCostUs = std::max(histogram.maxCostUs, costUs);
+    histogram.totalWaitUs += waitUs;
+    histogram.maxWaitUs = std::max(histogram.maxWaitUs, waitUs);
+    histogram.buckets[GetBucketIndex(costUs)]++;
+}
+
+void CellularDataPerfStats::RecordSetupLatency(int32_t slotId, int64_t costMs)
+{
+    if (!IsValidSlotId(slotId) || costMs < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    SlotPerfStats &stats = slotStats_[slotId];
+    stats.setupSamplesMs[stats.setupSampleIndex] = costMs;
+    stats.setupSampleIndex = (stats.setupSampleIndex + 1) % PERF_SETUP_SAMPLE_NUM;
+    stats.setupCount++;
+    stats.setupMaxMs = std::max(stats.setupMaxMs, costMs);
+}
+
+void CellularDataPerfStats::IncreaseRetryCount(int32_t slotId)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    slotStats_[slotId].retryCount++;
+}
+
+void CellularDataPerfStats::IncreaseStallRecoveryCount(int32_t slotId, RecoveryState state)
+{
+    size_t index = static_cast<size_t>(state);
+    if (!IsValidSlotId(slotId) || index >= PERF_RECOVERY_STATE_NUM) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    slotStats_[slotId].recoveryCount[index]++;
+}
+
+void CellularDataPerfStats::IncreaseFlowTypeSuppressedCount(int32_t slotId)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    slotStats_[slotId].flowTypeSuppressedCount++;
+}
+
+void CellularDataPerfStats::RecordStateMachinePoolAcquire(int32_t slotId, bool hit)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    slotStats_[slotId].poolAcquireCount++;
+    if (hit) {
+        slotStats_[slotId].poolHitCount++;
+    }
+}
+
+void CellularDataPerfStats::Reset(int32_t slotId)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    slotStats_[slotId] = SlotPerfStats();
+}
+
+int64_t CellularDataPerfStats::GetPercentile(std::vector<int64_t> &samples, uint32_t percent)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    // Nearest rank, the smallest sample which is not below percent of all samples.
+    size_t rank = (samples.size() * percent + PERCENT_MAX - 1) / PERCENT_MAX;
+    size_t index = rank > 0 ? rank - 1 : 0;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void CellularDataPerfStats::Dump(int32_t slotId, std::string &result)
+{
+    if (!IsValidSlotId(slotId)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_[slotId]);
+    const SlotPerfStats &stats = slotStats_[slotId];
+    result.append("Slot" + std::to_string(slotId) + " performance statistics:\n");
+    DumpSetupStats(stats, result);
+    result.append("  RetryCount                 : " + std::to_string(stats.retryCount) + "\n");
+    result.append("  StallRecoveryCount         :");
+    for (size_t i = 0; i < PERF_RECOVERY_STATE_NUM; ++i) {
+        result.append(" ");
+        result.append(PERF_RECOVERY_STATE_NAME[i]);
+        result.append("=" + std::to_string(stats.recoveryCount[i]));
+    }
+    result.append("\n");
+    result.append("  FlowTypeSuppressedCount    : " + std::to_string(stats.flowTypeSuppressedCount) + "\n");
+    uint64_t hitPercent = stats.poolAcquireCount == 0 ? 0 : stats.poolHitCount * PERCENT_MAX / stats.poolAcquireCount;
+    result.append("  StateMachinePool           : acquire=" + std::to_string(stats.poolAcquireCount));
+    result.append(" hit=" + std::to_string(stats.poolHitCount) + " hitRate=" + std::to_string(hitPercent) + "%\n");
+    DumpEventStats(stats, result);
+}
+
+void CellularDataPerfStats::DumpSetupStats(const SlotPerfStats &stats, std::string &result) const
+{
+    size_t sampleNum = std::min<uint64_t>(stats.setupCount, PERF_SETUP_SAMPLE_NUM);
+    std::vector<int64_t> samples(stats.setupSamplesMs.begin(), stats.setupSamplesMs.begin() + sampleNum);
+    result.append("  DataCallSetupLatency(ms)   : count=" + std::to_string(stats.setupCount));
+    result.append(" p50=" + std::to_string(GetPercentile(samples, PERCENT_50)));
+    result.append(" p90=" + std::to_string(GetPercentile(samples, PERCENT_90)));
+    result.append(" p99=" + std::to_string(GetPercentile(samples, PERCENT_99)));
+    result.append(" max=" + std::to_string(stats.setupMaxMs) + "\n");
+}
+
+void CellularDataPerfStats::DumpEventStats(const SlotPerfStats &stats, std::string &result) const
+{
+    for (size_t i = 0; i < stats.eventStats.size(); ++i) {
+        result.append("  ");
+        result.append(PERF_COMPONENT_NAME[i]);
+        result.append(" events (latency buckets in us: <100,<500,<1k,<5k,<10k,<50k,<100k,<500k,<1M,>=1M)\n");
+        for (const auto &[eventId, histogram] : stats.eventStats[i]) {
+            int64_t avgCost = static_cast<int64_t>(histogram.totalCostUs / static_cast<int64_t>(histogram.count));
+            int64_t avgWait = static_cast<int64_t>(histogram.totalWaitUs / static_cast<int64_t>(histogram.count));
+            result.append("    event=" + std::to_string(eventId));
+            result.append(" count=" + std::to_string(histogram.count));
+            result.append(" avgCost=" + std::to_string(avgCost));
+            result.append(" maxCost=" + std::to_string(histogram.maxCostUs));
+            result.append(" avgQueueWait=" + std::to_string(avgWait));
+            result.append(" maxQueueWait=" + std::to_string(histogram.maxWaitUs));
+            result.append(" hist=[");
+            for (size_t j = 0; j < PERF_LATENCY_BUCKET_NUM; ++j) {
+                result.append(std::to_string(histogram.buckets[j]));
+                result.append(j + 1 < PERF_LATENCY_BUCKET_NUM ? "," : "]\n");
+            }
+        }
+    }
+}
+
+PerfEventScope::PerfEventScope(
+    int32_t slotId, PerfComponent component, const AppExecFwk::InnerEvent::Pointer &event)
+    : slotId_(slotId), component_(component)
+{
+    beginUs_ = CellularDataPerfStats::GetSteadyTimeUs();
+    if (event == nullptr) {
+        return;
+    }
+    eventId_ = event->GetInnerEventId();
+    int64_t handleUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        event->GetHandleTime().time_since_epoch()).count();
+    if (handleUs > 0 && beginUs_ > handleUs) {
+        waitUs_ = beginUs_ - handleUs;
+    }
+}
+
+PerfEventScope::~PerfEventScope()
+{
+    int64_t costUs = CellularDataPerfStats::GetSteadyTimeUs() - beginUs_;
+    CellularDataPerfStats::GetInstance().RecordEvent(slotId_, component_, eventId_, waitUs_, costUs);
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -22,7 +22,11 @@
 static constexpr const char *SIM_ID = "simId";
 namespace OHOS {
 namespace Telephony {
-CellularDataRdbHelper::CellularDataRdbHelper() : cellularDataUri_(CELLULAR_DATA_RDB_SELECTION) {}
+CellularDataRdbHelper::CellularDataRdbHelper() : cellularDataUri_(CELLULAR_DATA_RDB_SELECTION)
+{
+    helperPool_ = std::make_shared<DataShareHelperPool>("CellularDataRdb",
+        [this](int waitTime) { return CreateDataAbilityHelper(waitTime); });
+}
 
 CellularDataRdbHelper::~CellularDataRdbHelper() = default;
 
@@ -52,33 +56,31 @@ std::shared_ptr<DataShare::DataShareHelper> CellularDataRdbHelper::CreateDataAbi
 int CellularDataRdbHelper::Update(
     const DataShare::DataShareValuesBucket &value, const DataShare::DataSharePredicates &predicates)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         return NULL_POINTER_EXCEPTION;
     }
     TELEPHONY_LOGI("Cellular data RDB helper update");
     int32_t result = dataShareHelper->Update(cellularDataUri_, predicates, value);
-    dataShareHelper->Release();
     return result;
 }
 
 int CellularDataRdbHelper::Insert(const DataShare::DataShareValuesBucket &values)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         return NULL_POINTER_EXCEPTION;
     }
     TELEPHONY_LOGI("Cellular data RDB helper insert");
     int32_t result = dataShareHelper->Insert(cellularDataUri_, values);
-    dataShareHelper->Release();
     return result;
 }
 
 bool CellularDataRdbHelper::ResetApns(int32_t slotId)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         return false;
@@ -90,7 +92,6 @@ bool CellularDataRdbHelper::ResetApns(int32_t slotId)
     DataShare::DataShareValuesBucket values;
     values.Put(SIM_ID, simId);
     int32_t result = dataShareHelper->Update(resetApnUri, predicates, values);
-    dataShareHelper->Release();
     return result >= 0;
 }
 
@@ -98,7 +99,7 @@ bool CellularDataRdbHelper::QueryApns(
     const std::string &mcc, const std::string &mnc, std::vector<PdpProfile> &apnVec, int32_t slotId,
     std::string &errMsg)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper(DB_CONNECT_MAX_WAIT_TIME);
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire(DB_CONNECT_MAX_WAIT_TIME);
     // LCOV_EXCL_START
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
@@ -116,7 +117,7 @@ bool CellularDataRdbHelper::QueryApns(
     // LCOV_EXCL_START
     if (result == nullptr) {
         TELEPHONY_LOGE("query apns error");
-        dataShareHelper->Release();
+        helperPool_->Discard(dataShareHelper);
         errMsg = "query apns error";
         return false;
     }
@@ -129,7 +130,6 @@ bool CellularDataRdbHelper::QueryApns(
     }
     // LCOV_EXCL_STOP
     result->Close();
-    dataShareHelper->Release();
     return true;
 }
 
@@ -141,7 +141,7 @@ bool CellularDataRdbHelper::QueryMvnoApnsByType(const std::string &mcc, const st
         TELEPHONY_LOGE("mvnoDataFromSim is empty!");
         return true;
     }
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         return false;
@@ -156,18 +156,17 @@ bool CellularDataRdbHelper::QueryMvnoApnsByType(const std::string &mcc, const st
         dataShareHelper->Query(cellularDataUri, predicates, columns);
     if (result == nullptr) {
         TELEPHONY_LOGE("Query apns error");
-        dataShareHelper->Release();
+        helperPool_->Discard(dataShareHelper);
         return false;
     }
     ReadMvnoApnResult(result, mvnoDataFromSim, mvnoApnVec);
     result->Close();
-    dataShareHelper->Release();
     return true;
 }
 
 bool CellularDataRdbHelper::QueryPreferApn(int32_t slotId, std::vector<PdpProfile> &apnVec, const int waitTime)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper(waitTime);
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire(waitTime);
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         CellularDataHiSysEvent::WriteDataActivateFaultEvent(slotId, SWITCH_ON,
@@ -181,14 +180,13 @@ bool CellularDataRdbHelper::QueryPreferApn(int32_t slotId, std::vector<PdpProfil
     std::shared_ptr<DataShare::DataShareResultSet> result = dataShareHelper->Query(preferApnUri, predicates, columns);
     if (result == nullptr) {
         TELEPHONY_LOGE("query prefer apns error");
-        dataShareHelper->Release();
+        helperPool_->Discard(dataShareHelper);
         CellularDataHiSysEvent::WriteDataActivateFaultEvent(slotId, SWITCH_ON,
             CellularDataErrorCode::DATA_ERROR_APN_QUERY_FAIL, "Query apn fail");
         return false;
     }
     ReadApnResult(result, apnVec);
     result->Close();
-    dataShareHelper->Release();
     if (apnVec.size() <= 0) {
         TELEPHONY_LOGI("simid no set prefer apn");
         CellularDataHiSysEvent::WriteDataActivateFaultEvent(slotId, SWITCH_ON,
@@ -314,7 +312,7 @@ bool CellularDataRdbHelper::IsMvnoDataMatched(const std::string &mvnoDataFromSim
 
 void CellularDataRdbHelper::RegisterObserver(const sptr<AAFwk::IDataAbilityObserver> &dataObserver)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         return;
@@ -326,13 +324,12 @@ void CellularDataRdbHelper::RegisterObserver(const sptr<AAFwk::IDataAbilityObser
     dataShareHelper->RegisterObserver(preferApnUri, dataObserver);
     dataShareHelper->RegisterObserver(initApnUri, dataObserver);
     dataShareHelper->RegisterObserver(cellularDataUri_, dataObserver);
-    dataShareHelper->Release();
     TELEPHONY_LOGI("RegisterObserver Success");
 }
 
 void CellularDataRdbHelper::UnRegisterObserver(const sptr<AAFwk::IDataAbilityObserver> &dataObserver)
 {
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("dataShareHelper is null");
         return;
@@ -344,7 +341,6 @@ void CellularDataRdbHelper::UnRegisterObserver(const sptr<AAFwk::IDataAbilityObs
     dataShareHelper->UnregisterObserver(preferApnUri, dataObserver);
     dataShareHelper->UnregisterObserver(initApnUri, dataObserver);
     dataShareHelper->UnregisterObserver(cellularDataUri_, dataObserver);
-    dataShareHelper->Release();
     TELEPHONY_LOGI("UnRegisterObserver Success");
 }
 
@@ -379,7 +375,7 @@ void CellularDataRdbHelper::QueryApnIds(const ApnInfo &apnInfo, std::vector<uint
     if (GetSimId() == -1) {
         return;
     }
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         return;
     }
@@ -407,7 +403,7 @@ void CellularDataRdbHelper::QueryApnIds(const ApnInfo &apnInfo, std::vector<uint
     std::shared_ptr<DataShare::DataShareResultSet> rst = dataShareHelper->Query(cellularDataUri, predicates, columns);
     if (rst == nullptr) {
         TELEPHONY_LOGE("QueryApnIds: query apns error");
-        dataShareHelper->Release();
+        helperPool_->Discard(dataShareHelper);
         return;
     }
     int rowCnt = 0;
@@ -423,7 +419,6 @@ void CellularDataRdbHelper::QueryApnIds(const ApnInfo &apnInfo, std::vector<uint
         apnIdList.push_back(profileId);
     }
     rst->Close();
-    dataShareHelper->Release();
 }
 
 int32_t CellularDataRdbHelper::SetPreferApn(int32_t apnId)
@@ -431,7 +426,7 @@ int32_t CellularDataRdbHelper::SetPreferApn(int32_t apnId)
     if (GetSimId() == -1) {
         return -1;
     }
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("SetPreferApn dataShareHelper is null");
         return -1;
@@ -447,11 +442,9 @@ int32_t CellularDataRdbHelper::SetPreferApn(int32_t apnId)
     int32_t result = dataShareHelper->Update(preferApnUri, predicates, values);
     if (result < TELEPHONY_ERR_SUCCESS) {
         TELEPHONY_LOGE("SetPreferApn fail! result:%{public}d", result);
-        dataShareHelper->Release();
         return -1;
     }
     TELEPHONY_LOGI("SetPreferApn result:%{public}d", result);
-    dataShareHelper->Release();
     return 0;
 }
 
@@ -500,7 +493,7 @@ void CellularDataRdbHelper::QueryAllApnInfo(std::vector<ApnInfo> &apnInfoList)
     if (GetSimId() == -1) {
         return;
     }
-    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = CreateDataAbilityHelper();
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper = helperPool_->Acquire();
     if (dataShareHelper == nullptr) {
         TELEPHONY_LOGE("QueryAllApnInfo dataShareHelper is null");
         return;
@@ -514,7 +507,7 @@ void CellularDataRdbHelper::QueryAllApnInfo(std::vector<ApnInfo> &apnInfoList)
         dataShareHelper->Query(cellularDataUri, predicates, columns);
     if (result == nullptr) {
         TELEPHONY_LOGE("QueryAllApnInfo error");
-        dataShareHelper->Release();
+        helperPool_->Discard(dataShareHelper);
         return;
     }
     int rowCnt = 0;
@@ -526,7 +519,11 @@ void CellularDataRdbHelper::QueryAllApnInfo(std::vector<ApnInfo> &apnInfoList)
         apnInfoList.push_back(apnInfo);
     }
     result->Close();
-    dataShareHelper->Release();
+}
+
+void CellularDataRdbHelper::DumpHelperPool(std::string &result)
+{
+    helperPool_->Dump(result);
 }
 } // namespace Telephony
 } // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "cellular_data_settings_rdb_helper.h"
 
+#include <algorithm>
+
 #include "cellular_data_error.h"
 #include "cellular_data_hisysevent.h"
 #include "telephony_log_wrapper.h"
@@ -24,7 +26,11 @@ namespace OHOS {
 namespace Telephony {
 static constexpr const int32_t E_ERROR = -1;
 
-CellularDataSettingsRdbHelper::CellularDataSettingsRdbHelper() {}
+CellularDataSettingsRdbHelper::CellularDataSettingsRdbHelper()
+{
+    helperPool_ = std::make_shared<DataShareHelperPool>("CellularDataSettings",
+        [this](int) { return CreateDataShareHelper(); });
+}
 
 CellularDataSettingsRdbHelper::~CellularDataSettingsRdbHelper() {}
 
@@ -61,54 +67,57 @@ std::shared_ptr<DataShare::DataShareHelper> CellularDataSettingsRdbHelper::Creat
 void CellularDataSettingsRdbHelper::UnRegisterSettingsObserver(
     const Uri &uri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver)
 {
-    std::shared_ptr<DataShare::DataShareHelper> settingHelper = CreateDataShareHelper();
+    std::shared_ptr<DataShare::DataShareHelper> settingHelper = helperPool_->Acquire();
     if (settingHelper == nullptr) {
         TELEPHONY_LOGE("UnRegister settings observer failed by nullptr");
         return;
     }
     settingHelper->UnregisterObserver(uri, dataObserver);
-    settingHelper->Release();
     TELEPHONY_LOGE("UnRegisterSettingsObserver success");
 }
 
 void CellularDataSettingsRdbHelper::RegisterSettingsObserver(
     const Uri &uri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver)
 {
-    std::shared_ptr<DataShare::DataShareHelper> settingHelper = CreateDataShareHelper();
+    std::shared_ptr<DataShare::DataShareHelper> settingHelper = helperPool_->Acquire();
     if (settingHelper == nullptr) {
         TELEPHONY_LOGE("Register settings observer by nullptr");
         return;
     }
     settingHelper->RegisterObserver(uri, dataObserver);
-    settingHelper->Release();
     TELEPHONY_LOGE("RegisterSettingsObserver success");
 }
 
 void CellularDataSettingsRdbHelper::NotifyChange(const Uri &uri)
 {
-    std::shared_ptr<DataShare::DataShareHelper> settingHelper = CreateDataShareHelper();
+    std::shared_ptr<DataShare::DataShareHelper> settingHelper = helperPool_->Acquire();
     if (settingHelper == nullptr) {
         TELEPHONY_LOGE("notify settings changed fail by nullptr");
         return;
     }
     settingHelper->NotifyChange(uri);
-    settingHelper->Release();
 }
 
 int32_t CellularDataSettingsRdbHelper::GetValue(Uri &uri, const std::string &column, int32_t &value)
 {
-    std::shared_ptr<DataShare::DataShareHelper> settingHelper = CreateDataShareHelper();
+    std::shared_ptr<DataShare::DataShareHelper> settingHelper = helperPool_->Acquire();
     if (settingHelper == nullptr) {
         TELEPHONY_LOGE("helper_ is null");
         return TELEPHONY_ERR_LOCAL_PTR_NULL;
     }
+    return QueryValue(settingHelper, uri, column, value);
+}
+
+int32_t CellularDataSettingsRdbHelper::QueryValue(const std::shared_ptr<DataShare::DataShareHelper> &settingHelper,
+    Uri &uri, const std::string &column, int32_t &value)
+{
     DataShare::DataSharePredicates predicates;
     std::vector<std::string> columns;
     predicates.EqualTo(CELLULAR_DATA_COLUMN_KEYWORD, column);
     auto result = settingHelper->Query(uri, predicates, columns);
     if (result == nullptr) {
         TELEPHONY_LOGE("setting DB: query error");
-        settingHelper->Release();
+        helperPool_->Discard(settingHelper);
         return TELEPHONY_ERR_DATABASE_READ_FAIL;
     }
     result->GoToFirstRow();
@@ -118,7 +127,6 @@ int32_t CellularDataSettingsRdbHelper::GetValue(Uri &uri, const std::string &col
         result->GetString(columnIndex, resultValue);
     }
     result->Close();
-    settingHelper->Release();
     TELEPHONY_LOGD("Query end resultValue is %{public}s", resultValue.c_str());
     if (!CellularDataUtils::ConvertStrToInt(resultValue, value)) {
         TELEPHONY_LOGD("ConvertStrToInt fail");
@@ -129,13 +137,13 @@ int32_t CellularDataSettingsRdbHelper::GetValue(Uri &uri, const std::string &col
 
 int32_t CellularDataSettingsRdbHelper::PutValue(Uri &uri, const std::string &column, int value)
 {
-    std::shared_ptr<DataShare::DataShareHelper> settingHelper = CreateDataShareHelper();
+    std::shared_ptr<DataShare::DataShareHelper> settingHelper = helperPool_->Acquire();
     if (settingHelper == nullptr) {
         TELEPHONY_LOGE("helper_ is null");
         return TELEPHONY_ERR_LOCAL_PTR_NULL;
     }
     int32_t existValue = 0;
-    int32_t getValueRet = GetValue(uri, column, existValue);
+    int32_t getValueRet = QueryValue(settingHelper, uri, column, existValue);
     DataShare::DataShareValueObject keyObj(column);
     DataShare::DataShareValueObject valueObj(std::to_string(value));
     DataShare::DataShareValuesBucket bucket;
@@ -151,25 +159,175 @@ int32_t CellularDataSettingsRdbHelper::PutValue(Uri &uri, const std::string &col
     }
     TELEPHONY_LOGI("put value return %{public}d", result);
     if (result == E_ERROR) {
-        Uri userDataEnableUri(CELLULAR_DATA_SETTING_DATA_ENABLE_URI);
-        Uri userDataRoamingUri(CELLULAR_DATA_SETTING_DATA_ROAMING_URI);
-        if (uri == userDataEnableUri) {
-            CellularDataHiSysEvent::WriteDataActivateFaultEvent(INVALID_PARAMETER, value,
-                CellularDataErrorCode::DATA_ERROR_DATABASE_WRITE_ERROR,
-                "SetCellularDataEnable " + std::to_string(value) + " fail");
-        } else if (uri == userDataRoamingUri) {
-            CellularDataHiSysEvent::WriteDataActivateFaultEvent(INVALID_PARAMETER, value,
-                CellularDataErrorCode::DATA_ERROR_DATABASE_WRITE_ERROR,
-                "SetUserDataRoamingOn " + std::to_string(value) + " fail");
-        } else {
-            TELEPHONY_LOGI("result is %{public}d, do not handle.", result);
-        }
-        settingHelper->Release();
+        WritePutValueFaultEvent(uri, value);
         return TELEPHONY_ERR_DATABASE_WRITE_FAIL;
     }
     settingHelper->NotifyChange(uri);
-    settingHelper->Release();
     return TELEPHONY_ERR_SUCCESS;
 }
+
+int32_t CellularDataSettingsRdbHelper::PutValues(const std::vector<SettingsValueEntry> &entries)
+{
+    std::vector<SettingsValueEntry> mergedEntries;
+    for (const SettingsValueEntry &entry : entries) {
+        auto it = std::find_if(mergedEntries.begin(), mergedEntries.end(),
+            [&entry](const SettingsValueEntry &merged) { return merged.column == entry.column; });
+        if (it != mergedEntries.end()) {
+            *it = entry;
+        } else {
+            mergedEntries.push_back(entry);
+        }
+    }
+    if (mergedEntries.empty()) {
+        return TELEPHONY_ERR_SUCCESS;
+    }
+    std::shared_ptr<DataShare::DataShareHelper> settingHelper = helperPool_->Acquire();
+    if (settingHelper == nullptr) {
+        TELEPHONY_LOGE("helper_ is null");
+        return TELEPHONY_ERR_LOCAL_PTR_NULL;
+    }
+    std::vector<std::string> keys;
+    for (const SettingsValueEntry &entry : mergedEntries) {
+        keys.push_back(entry.column);
+    }
+    std::vector<std::string> existKeys;
+    int32_t ret = QueryExistKeys(settingHelper, keys, existKeys);
+    if (ret != TELEPHONY_ERR_SUCCESS) {
+        return ret;
+    }
+    std::vector<DataShare::OperationStatement> statements;
+    for (const SettingsValueEntry &entry : mergedEntries) {
+        DataShare::OperationStatement statement;
+        statement.uri = entry.uri;
+        DataShare::DataShareValueObject keyObj(entry.column);
+        DataShare::DataShareValueObject valueObj(std::to_string(entry.value));
+        statement.valuesBucket.Put(CELLULAR_DATA_COLUMN_VALUE, valueObj);
+        statement.valuesBucket.Put(CELLULAR_DATA_COLUMN_KEYWORD, keyObj);
+        if (std::find(existKeys.begin(), existKeys.end(), entry.column) != existKeys.end()) {
+            statement.operationType = DataShare::Operation::UPDATE;
+            statement.predicates.EqualTo(CELLULAR_DATA_COLUMN_KEYWORD, entry.column);
+        } else {
+            statement.operationType = DataShare::Operation::INSERT;
+        }
+        statements.push_back(statement);
+    }
+    DataShare::ExecResultSet resultSet;
+    int32_t batchRet = settingHelper->ExecuteBatch(statements, resultSet);
+    TELEPHONY_LOGI("put %{public}zu values in batch return %{public}d", statements.size(), batchRet);
+    std::vector<SettingsValueEntry> writtenEntries;
+    std::vector<SettingsValueEntry> pendingEntries;
+    if (batchRet == DataShare::E_OK && resultSet.results.size() == statements.size()) {
+        for (size_t i = 0; i < mergedEntries.size(); ++i) {
+            if (IsStatementWritten(resultSet.results[i])) {
+                writtenEntries.push_back(mergedEntries[i]);
+            } else {
+                pendingEntries.push_back(mergedEntries[i]);
+            }
+        }
+    } else {
+        // A provider without batch support still gets the keys one by one.
+        pendingEntries = mergedEntries;
+    }
+    ret = TELEPHONY_ERR_SUCCESS;
+    if (!pendingEntries.empty()) {
+        ret = WriteValuesOneByOne(settingHelper, pendingEntries, existKeys, writtenEntries);
+    }
+    for (const SettingsValueEntry &entry : writtenEntries) {
+        Uri uri(entry.uri);
+        settingHelper->NotifyChange(uri);
+    }
+    return ret;
+}
+
+bool CellularDataSettingsRdbHelper::IsStatementWritten(const DataShare::ExecResult &result)
+{
+    // An update of an existing key which changed no row wrote nothing either.
+    if (result.operationType == DataShare::Operation::UPDATE) {
+        return result.code > 0;
+    }
+    return result.code >= 0;
+}
+
+int32_t CellularDataSettingsRdbHelper::QueryExistKeys(const std::shared_ptr<DataShare::DataShareHelper> &settingHelper,
+    const std::vector<std::string> &keys, std::vector<std::string> &existKeys)
+{
+    Uri settingUri(CELLULAR_DATA_SETTING_URI);
+    DataShare::DataSharePredicates predicates;
+    std::vector<std::string> columns = { CELLULAR_DATA_COLUMN_KEYWORD };
+    predicates.In(CELLULAR_DATA_COLUMN_KEYWORD, keys);
+    auto result = settingHelper->Query(settingUri, predicates, columns);
+    if (result == nullptr) {
+        TELEPHONY_LOGE("setting DB: query keys error");
+        helperPool_->Discard(settingHelper);
+        return TELEPHONY_ERR_DATABASE_READ_FAIL;
+    }
+    int32_t rowCnt = 0;
+    int32_t columnIndex = 0;
+    result->GetRowCount(rowCnt);
+    if (result->GetColumnIndex(CELLULAR_DATA_COLUMN_KEYWORD, columnIndex) == DataShare::E_OK) {
+        for (int32_t i = 0; i < rowCnt; ++i) {
+            std::string key;
+            result->GoToRow(i);
+            result->GetString(columnIndex, key);
+            existKeys.push_back(key);
+        }
+    }
+    result->Close();
+    return TELEPHONY_ERR_SUCCESS;
+}
+
+int32_t CellularDataSettingsRdbHelper::WriteValuesOneByOne(
+    const std::shared_ptr<DataShare::DataShareHelper> &settingHelper, const std::vector<SettingsValueEntry> &entries,
+    const std::vector<std::string> &existKeys, std::vector<SettingsValueEntry> &writtenEntries)
+{
+    int32_t ret = TELEPHONY_ERR_SUCCESS;
+    for (const SettingsValueEntry &entry : entries) {
+        Uri uri(entry.uri);
+        DataShare::DataShareValuesBucket bucket;
+        DataShare::DataShareValueObject keyObj(entry.column);
+        DataShare::DataShareValueObject valueObj(std::to_string(entry.value));
+        bucket.Put(CELLULAR_DATA_COLUMN_VALUE, valueObj);
+        bucket.Put(CELLULAR_DATA_COLUMN_KEYWORD, keyObj);
+        bool written = false;
+        if (std::find(existKeys.begin(), existKeys.end(), entry.column) == existKeys.end()) {
+            written = settingHelper->Insert(uri, bucket) != E_ERROR;
+        } else {
+            // As in the batch, an update which matched no row wrote nothing.
+            DataShare::DataSharePredicates predicates;
+            predicates.EqualTo(CELLULAR_DATA_COLUMN_KEYWORD, entry.column);
+            written = settingHelper->Update(uri, predicates, bucket) > 0;
+        }
+        if (!written) {
+            TELEPHONY_LOGE("put value of %{public}s failed", entry.column.c_str());
+            WritePutValueFaultEvent(uri, entry.value);
+            ret = TELEPHONY_ERR_DATABASE_WRITE_FAIL;
+            continue;
+        }
+        writtenEntries.push_back(entry);
+    }
+    return ret;
+}
+
+void CellularDataSettingsRdbHelper::WritePutValueFaultEvent(const Uri &uri, int value)
+{
+    Uri userDataEnableUri(CELLULAR_DATA_SETTING_DATA_ENABLE_URI);
+    Uri userDataRoamingUri(CELLULAR_DATA_SETTING_DATA_ROAMING_URI);
+    if (uri == userDataEnableUri) {
+        CellularDataHiSysEvent::WriteDataActivateFaultEvent(INVALID_PARAMETER, value,
+            CellularDataErrorCode::DATA_ERROR_DATABASE_WRITE_ERROR,
+            "SetCellularDataEnable " + std::to_string(value) + " fail");
+    } else if (uri == userDataRoamingUri) {
+        CellularDataHiSysEvent::WriteDataActivateFaultEvent(INVALID_PARAMETER, value,
+            CellularDataErrorCode::DATA_ERROR_DATABASE_WRITE_ERROR,
+            "SetUserDataRoamingOn " + std::to_string(value) + " fail");
+    } else {
+        TELEPHONY_LOGI("put value %{public}d fail, do not handle.", value);
+    }
+}
+
+void CellularDataSettingsRdbHelper::DumpHelperPool(std::string &result)
+{
+    helperPool_->Dump(result);
+}
 } // namespace Telephony
 } // namespace OHOS
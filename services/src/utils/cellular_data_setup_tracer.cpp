@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cellular_data_setup_tracer.h"
+
+#include <algorithm>
+
+#include "apn_manager.h"
+#include "cellular_data_perf_stats.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr int64_t TRACE_TIME_UNSET = 0;
+static constexpr int64_t TRACE_COST_MISSING = -1;
+static constexpr uint32_t PERCENT_50 = 50;
+static constexpr uint32_t PERCENT_95 = 95;
+static constexpr uint32_t PERCENT_99 = 99;
+static constexpr uint32_t PERCENT_MAX = 100;
+static const char *SETUP_TRACE_STAGE_NAME[SETUP_TRACE_STAGE_NUM] = {
+    "RequestNet", "MsgRequestNetwork", "AttemptEstablish", "SmConnect",
+    "RilActivateDone", "EstablishComplete", "UpdateNetworkInfo"
+};
+
+CellularDataSetupTracer &CellularDataSetupTracer::GetInstance()
+{
+    static CellularDataSetupTracer instance;
+    return instance;
+}
+
+CellularDataSetupTracer::CellularDataSetupTracer()
+{
+    for (int32_t slotId = 0; slotId < SETUP_TRACE_SLOT_NUM; ++slotId) {
+        Reset(slotId);
+    }
+}
+
+void CellularDataSetupTracer::Mark(int32_t slotId, int32_t apnId, SetupTraceStage stage)
+{
+    size_t stageIndex = static_cast<size_t>(stage);
+    if (slotId < 0 || slotId >= SETUP_TRACE_SLOT_NUM || apnId < 0 || apnId >= SETUP_TRACE_APN_ID_NUM ||
+        stageIndex >= SETUP_TRACE_STAGE_NUM) {
+        return;
+    }
+    SlotSetupTrace &trace = slotTrace_[slotId];
+    auto &inflight = trace.inflightUs[apnId];
+    int64_t nowUs = CellularDataPerfStats::GetSteadyTimeUs();
+    if (stage == SetupTraceStage::REQUEST_NET) {
+        for (auto &stageUs : inflight) {
+            stageUs.store(TRACE_TIME_UNSET, std::memory_order_relaxed);
+        }
+        inflight[stageIndex].store(nowUs, std::memory_order_relaxed);
+        return;
+    }
+    bool isOpen = std::any_of(inflight.begin(), inflight.end(), [](const std::atomic<int64_t> &stageUs) {
+        return stageUs.load(std::memory_order_relaxed) != TRACE_TIME_UNSET;
+    });
+    if (!isOpen && stage > SetupTraceStage::SM_CONNECT) {
+        return;
+    }
+    // Keep the first occurrence so that retries are accounted to the stage which had to be retried.
+    int64_t expected = TRACE_TIME_UNSET;
+    inflight[stageIndex].compare_exchange_strong(expected, nowUs, std::memory_order_relaxed);
+    if (stage == SetupTraceStage::UPDATE_NETWORK_INFO) {
+        CommitSpan(trace, apnId);
+    }
+}
+
+void CellularDataSetupTracer::CommitSpan(SlotSetupTrace &trace, int32_t apnId)
+{
+    SetupSpan &span = trace.spans[trace.spanCount.fetch_add(1, std::memory_order_relaxed) % SETUP_TRACE_SPAN_NUM];
+    span.apnId.store(DATA_CONTEXT_ROLE_INVALID_ID, std::memory_order_relaxed);
+    auto &inflight = trace.inflightUs[apnId];
+    int64_t firstUs = TRACE_TIME_UNSET;
+    int64_t prevUs = TRACE_TIME_UNSET;
+    for (size_t i = 0; i < SETUP_TRACE_STAGE_NUM; ++i) {
+        int64_t stageUs = inflight[i].exchange(TRACE_TIME_UNSET, std::memory_order_relaxed);
+        if (stageUs == TRACE_TIME_UNSET) {
+            span.stageCostUs[i].store(TRACE_COST_MISSING, std::memory_order_relaxed);
+            continue;
+        }
+        if (firstUs == TRACE_TIME_UNSET) {
+            firstUs = stageUs;
+            prevUs = stageUs;
+        }
+        span.stageCostUs[i].store(std::max<int64_t>(stageUs - prevUs, 0), std::memory_order_relaxed);
+        prevUs = std::max(prevUs, stageUs);
+    }
+    span.totalCostUs.store(prevUs - firstUs, std::memory_order_relaxed);
+    span.apnId.store(apnId, std::memory_order_release);
+}
+
+void CellularDataSetupTracer::Reset(int32_t slotId)
+{
+    if (slotId < 0 || slotId >= SETUP_TRACE_SLOT_NUM) {
+        return;
+    }
+    SlotSetupTrace &trace = slotTrace_[slotId];
+    for (auto &inflight : trace.inflightUs) {
+        for (auto &stageUs : inflight) {
+            stageUs.store(TRACE_TIME_UNSET, std::memory_order_relaxed);
+        }
+    }
+    for (auto &span : trace.spans) {
+        span.apnId.store(DATA_CONTEXT_ROLE_INVALID_ID, std::memory_order_relaxed);
+        for (auto &costUs : span.stageCostUs) {
+            costUs.store(TRACE_COST_MISSING, std::memory_order_relaxed);
+        }
+        span.totalCostUs.store(0, std::memory_order_relaxed);
+    }
+    trace.spanCount.store(0, std::memory_order_relaxed);
+}
+
+int64_t CellularDataSetupTracer::GetPercentile(std::vector<int64_t> &samples, uint32_t percent)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+    // Nearest rank, the smallest sample which is not below percent of all samples.
+    size_t rank = (samples.size() * percent + PERCENT_MAX - 1) / PERCENT_MAX;
+    size_t index = rank > 0 ? rank - 1 : 0;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void CellularDataSetupTracer::AppendPercentiles(std::vector<int64_t> &samples, std::string &result)
+{
+    result.append("count=" + std::to_string(samples.size()));
+    result.append(" p50=" + std::to_string(GetPercentile(samples, PERCENT_50)));
+    result.append(" p95=" + std::to_string(GetPercentile(samples, PERCENT_95)));
+    result.append(" p99=" + std::to_string(GetPercentile(samples, PERCENT_99)) + "\n");
+}
+
+void CellularDataSetupTracer::Dump(int32_t slotId, std::string &result)
+{
+    if (slotId < 0 || slotId >= SETUP_TRACE_SLOT_NUM) {
+        return;
+    }
+    const SlotSetupTrace &trace = slotTrace_[slotId];
+    result.append("Slot" + std::to_string(slotId) + " data call setup trace(us), last " +
+        std::to_string(std::min<uint64_t>(trace.spanCount.load(), SETUP_TRACE_SPAN_NUM)) + " spans:\n");
+    for (int32_t apnId = 0; apnId < SETUP_TRACE_APN_ID_NUM; ++apnId) {
+        DumpApnStats(trace, apnId, result);
+    }
+}
+
+void CellularDataSetupTracer::DumpApnStats(const SlotSetupTrace &trace, int32_t apnId, std::string &result) const
+{
+    std::vector<int64_t> totalSamples;
+    std::array<std::vector<int64_t>, SETUP_TRACE_STAGE_NUM> stageSamples;
+    for (const auto &span : trace.spans) {
+        if (span.apnId.load(std::memory_order_acquire) != apnId) {
+            continue;
+        }
+        totalSamples.push_back(span.totalCostUs.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < SETUP_TRACE_STAGE_NUM; ++i) {
+            int64_t costUs = span.stageCostUs[i].load(std::memory_order_relaxed);
+            if (costUs != TRACE_COST_MISSING) {
+                stageSamples[i].push_back(costUs);
+            }
+        }
+    }
+    if (totalSamples.empty()) {
+        return;
+    }
+    result.append("  " + ApnManager::FindApnNameByApnId(apnId) + " total: ");
+    AppendPercentiles(totalSamples, result);
+    for (size_t i = 0; i < SETUP_TRACE_STAGE_NUM; ++i) {
+        if (stageSamples[i].empty()) {
+            continue;
+        }
+        result.append("    ");
+        result.append(SETUP_TRACE_STAGE_NAME[i]);
+        result.append(": ");
+        AppendPercentiles(stageSamples[i], result);
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cellular_data_startup.h"
+
+#include <chrono>
+#include <cinttypes>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+static const std::string STARTUP_IDLE_TIMEOUT_TASK = "StartupIdleTimeout";
+
+CellularDataStartup &CellularDataStartup::GetInstance()
+{
+    static CellularDataStartup instance;
+    return instance;
+}
+
+int64_t CellularDataStartup::GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::shared_ptr<AppExecFwk::EventHandler> CellularDataStartup::GetStartupHandler()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (startupHandler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("CellularDataStartup");
+        if (runner == nullptr) {
+            TELEPHONY_LOGE("create cellular data startup runner failed");
+            return nullptr;
+        }
+        startupHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    return startupHandler_;
+}
+
+void CellularDataStartup::Begin()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        beginMs_ = GetSteadyTimeMs();
+        released_ = false;
+        releaseTrigger_.clear();
+        releaseMs_ = 0;
+        pendingPhases_.clear();
+        records_.clear();
+    }
+    auto handler = GetStartupHandler();
+    if (handler != nullptr) {
+        handler->RemoveTask(STARTUP_IDLE_TIMEOUT_TASK);
+    }
+    if (handler == nullptr || !handler->PostTask([this]() { ReleaseDeferredPhases("idle timeout"); },
+        STARTUP_IDLE_TIMEOUT_TASK, STARTUP_DEFERRED_IDLE_TIMEOUT_MS)) {
+        TELEPHONY_LOGE("post startup idle timeout failed, run deferred phases now");
+        ReleaseDeferredPhases("no idle timer");
+    }
+}
+
+void CellularDataStartup::Record(const std::string &name, StartupPhaseType type, int64_t startMs, int64_t costMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.push_back({ name, type, startMs - beginMs_, costMs });
+}
+
+void CellularDataStartup::RunCriticalPhase(const std::string &name, const std::function<void()> &phase)
+{
+    int64_t startMs = GetSteadyTimeMs();
+    phase();
+    int64_t costMs = GetSteadyTimeMs() - startMs;
+    TELEPHONY_LOGI("startup phase %{public}s cost %{public}" PRId64 "ms", name.c_str(), costMs);
+    Record(name, StartupPhaseType::CRITICAL, startMs, costMs);
+}
+
+void CellularDataStartup::RunDeferredPhase(const std::string &name, const std::function<void()> &phase)
+{
+    int64_t startMs = GetSteadyTimeMs();
+    phase();
+    int64_t costMs = GetSteadyTimeMs() - startMs;
+    TELEPHONY_LOGI("deferred startup phase %{public}s cost %{public}" PRId64 "ms", name.c_str(), costMs);
+    Record(name, StartupPhaseType::DEFERRED, startMs, costMs);
+}
+
+void CellularDataStartup::AddDeferredPhase(const std::string &name, const std::function<void()> &phase)
+{
+    if (phase == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!released_) {
+            pendingPhases_.emplace_back(name, phase);
+            return;
+        }
+    }
+    auto handler = GetStartupHandler();
+    if (handler == nullptr || !handler->PostTask([this, name, phase]() { RunDeferredPhase(name, phase); })) {
+        RunDeferredPhase(name, phase);
+    }
+}
+
+void CellularDataStartup::OnDefaultApnConnected()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (released_) {
+            return;
+        }
+    }
+    ReleaseDeferredPhases("default apn connected");
+}
+
+void CellularDataStartup::ReleaseDeferredPhases(const std::string &trigger)
+{
+    std::vector<std::pair<std::string, std::function<void()>>> phases;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (released_) {
+            return;
+        }
+        released_ = true;
+        releaseTrigger_ = trigger;
+        releaseMs_ = GetSteadyTimeMs() - beginMs_;
+        phases.swap(pendingPhases_);
+    }
+    TELEPHONY_LOGI("run %{public}zu deferred startup phases, trigger: %{public}s", phases.size(), trigger.c_str());
+    auto handler = GetStartupHandler();
+    bool posted = handler != nullptr && handler->PostTask([this, phases]() {
+        for (const auto &[name, phase] : phases) {
+            RunDeferredPhase(name, phase);
+        }
+    });
+    if (!posted) {
+        for (const auto &[name, phase] : phases) {
+            RunDeferredPhase(name, phase);
+        }
+    }
+}
+
+std::string CellularDataStartup::GetCriticalPhaseTime()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string result;
+    for (const StartupPhaseRecord &record : records_) {
+        if (record.type != StartupPhaseType::CRITICAL) {
+            continue;
+        }
+        result.append(result.empty() ? "" : " ");
+        result.append(record.name + "=" + std::to_string(record.costMs) + "ms");
+    }
+    return result;
+}
+
+void CellularDataStartup::Dump(std::string &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.append("StartupDeferredRelease       : ");
+    if (released_) {
+        result.append(releaseTrigger_ + " at " + std::to_string(releaseMs_) + "ms\n");
+    } else {
+        result.append("pending, " + std::to_string(pendingPhases_.size()) + " phases queued\n");
+    }
+    for (const StartupPhaseRecord &record : records_) {
+        result.append("StartupPhase                 : ");
+        result.append(record.type == StartupPhaseType::CRITICAL ? "critical " : "deferred ");
+        result.append(record.name + " start=" + std::to_string(record.startMs) + "ms");
+        result.append(" cost=" + std::to_string(record.costMs) + "ms\n");
+    }
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "datashare_helper_pool.h"
+
+#include <chrono>
+
+#include "event_handler.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+static std::shared_ptr<AppExecFwk::EventHandler> GetIdleCheckHandler()
+{
+    static std::shared_ptr<AppExecFwk::EventHandler> handler = []() -> std::shared_ptr<AppExecFwk::EventHandler> {
+        auto runner = AppExecFwk::EventRunner::Create("DataShareHelperPool");
+        if (runner == nullptr) {
+            TELEPHONY_LOGE("create datashare helper pool runner failed");
+            return nullptr;
+        }
+        return std::make_shared<AppExecFwk::EventHandler>(runner);
+    }();
+    return handler;
+}
+
+DataShareHelperPool::DataShareHelperPool(const std::string &name, const Creator &creator, int64_t idleTimeoutMs)
+    : name_(name), creator_(creator), idleTimeoutMs_(idleTimeoutMs)
+{}
+
+DataShareHelperPool::~DataShareHelperPool()
+{
+    // Leases keep only a weak reference to the pool, a helper still leased here is left to the process exit.
+    if (helper_ != nullptr && leaseCounts_.find(helper_.get()) == leaseCounts_.end()) {
+        helper_->Release();
+    }
+}
+
+int64_t DataShareHelperPool::GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::shared_ptr<DataShare::DataShareHelper> DataShareHelperPool::Acquire(int waitTime)
+{
+    std::shared_ptr<DataShare::DataShareHelper> helper;
+    std::shared_ptr<DataShare::DataShareHelper> redundant;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (helper_ != nullptr) {
+            stats_.reuseCount++;
+            helper = helper_;
+            leaseCounts_[helper.get()]++;
+        }
+    }
+    if (helper == nullptr) {
+        // Connecting may block for waitTime seconds, do not hold the lock meanwhile.
+        std::shared_ptr<DataShare::DataShareHelper> created = creator_ ? creator_(waitTime) : nullptr;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (created == nullptr) {
+            stats_.createFailCount++;
+            TELEPHONY_LOGE("%{public}s: create datashare helper failed", name_.c_str());
+            return nullptr;
+        }
+        stats_.createCount++;
+        if (helper_ == nullptr) {
+            helper_ = created;
+        } else {
+            redundant = created;
+        }
+        helper = helper_;
+        leaseCounts_[helper.get()]++;
+    }
+    if (redundant != nullptr) {
+        redundant->Release();
+    }
+    std::weak_ptr<DataShareHelperPool> weakPool = weak_from_this();
+    return std::shared_ptr<DataShare::DataShareHelper>(helper.get(), [weakPool, helper](DataShare::DataShareHelper *) {
+        auto pool = weakPool.lock();
+        if (pool != nullptr) {
+            pool->ReturnLease(helper);
+        }
+    });
+}
+
+bool DataShareHelperPool::DropLeaseLocked(const std::shared_ptr<DataShare::DataShareHelper> &helper)
+{
+    auto it = leaseCounts_.find(helper.get());
+    if (it == leaseCounts_.end()) {
+        return false;
+    }
+    if (--it->second > 0) {
+        return false;
+    }
+    leaseCounts_.erase(it);
+    // A helper which has been discarded or replaced is released by its last lease.
+    return helper != helper_;
+}
+
+void DataShareHelperPool::ReturnLease(const std::shared_ptr<DataShare::DataShareHelper> &helper)
+{
+    bool needRelease = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        needRelease = DropLeaseLocked(helper);
+        if (helper == helper_ && leaseCounts_.find(helper.get()) == leaseCounts_.end()) {
+            lastReturnMs_ = GetSteadyTimeMs();
+            ScheduleIdleCheckLocked(idleTimeoutMs_);
+        }
+    }
+    if (needRelease) {
+        helper->Release();
+    }
+}
+
+void DataShareHelperPool::Discard(const std::shared_ptr<DataShare::DataShareHelper> &lease)
+{
+    if (lease == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (helper_ == nullptr || helper_.get() != lease.get()) {
+        return;
+    }
+    TELEPHONY_LOGI("%{public}s: discard datashare helper", name_.c_str());
+    stats_.discardCount++;
+    // The caller still holds the lease, so the helper is released when that lease is returned.
+    helper_.reset();
+}
+
+void DataShareHelperPool::Clear()
+{
+    std::shared_ptr<DataShare::DataShareHelper> idleHelper;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (helper_ != nullptr && leaseCounts_.find(helper_.get()) == leaseCounts_.end()) {
+            idleHelper = helper_;
+        }
+        helper_.reset();
+    }
+    if (idleHelper != nullptr) {
+        idleHelper->Release();
+    }
+}
+
+void DataShareHelperPool::ScheduleIdleCheckLocked(int64_t delayMs)
+{
+    if (idleCheckPending_ || idleTimeoutMs_ <= 0) {
+        return;
+    }
+    auto handler = GetIdleCheckHandler();
+    if (handler == nullptr) {
+        return;
+    }
+    std::weak_ptr<DataShareHelperPool> weakPool = weak_from_this();
+    idleCheckPending_ = handler->PostTask([weakPool]() {
+        auto pool = weakPool.lock();
+        if (pool != nullptr) {
+            pool->CheckIdle();
+        }
+    }, delayMs);
+}
+
+void DataShareHelperPool::CheckIdle()
+{
+    std::shared_ptr<DataShare::DataShareHelper> idleHelper;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idleCheckPending_ = false;
+        if (helper_ == nullptr || leaseCounts_.find(helper_.get()) != leaseCounts_.end()) {
+            return;
+        }
+        int64_t idleMs = GetSteadyTimeMs() - lastReturnMs_;
+        if (idleMs < idleTimeoutMs_) {
+            ScheduleIdleCheckLocked(idleTimeoutMs_ - idleMs);
+            return;
+        }
+        stats_.idleCloseCount++;
+        idleHelper = helper_;
+        helper_.reset();
+    }
+    TELEPHONY_LOGI("%{public}s: release idle datashare helper", name_.c_str());
+    idleHelper->Release();
+}
+
+DataShareHelperPoolStats DataShareHelperPool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void DataShareHelperPool::Dump(std::string &result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.append(name_ + " helper pool: connected=" + std::to_string(helper_ != nullptr));
+    result.append(" leased=" + std::to_string(helper_ != nullptr && leaseCounts_.count(helper_.get()) > 0));
+    result.append(" create=" + std::to_string(stats_.createCount));
+    result.append(" createFail=" + std::to_string(stats_.createFailCount));
+    result.append(" reuse=" + std::to_string(stats_.reuseCount));
+    result.append(" discard=" + std::to_string(stats_.discardCount));
+    result.append(" idleClose=" + std::to_string(stats_.idleCloseCount) + "\n");
+}
+} // namespace Telephony
+} // namespace OHOS
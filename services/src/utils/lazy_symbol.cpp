@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lazy_symbol.h"
+
+#include <chrono>
+#include <dlfcn.h>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+void LazySymbolStats::Record(bool found, int64_t costUs)
+{
+    if (found) {
+        resolvedCount_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        missingCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+    resolveTimeUs_.fetch_add(costUs, std::memory_order_relaxed);
+}
+
+uint32_t LazySymbolStats::GetResolvedCount() const
+{
+    return resolvedCount_.load(std::memory_order_relaxed);
+}
+
+uint32_t LazySymbolStats::GetMissingCount() const
+{
+    return missingCount_.load(std::memory_order_relaxed);
+}
+
+int64_t LazySymbolStats::GetResolveTimeUs() const
+{
+    return resolveTimeUs_.load(std::memory_order_relaxed);
+}
+
+void LazySymbolStats::Dump(const std::string &name, std::string &result) const
+{
+    result.append(name + " symbols: resolved=" + std::to_string(GetResolvedCount()));
+    result.append(" missing=" + std::to_string(GetMissingCount()));
+    result.append(" resolveTime=" + std::to_string(GetResolveTimeUs()) + "us\n");
+}
+
+void *ResolveLazySymbol(void *handle, const char *name, LazySymbolStats *stats)
+{
+    if (name == nullptr) {
+        return nullptr;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    void *symbol = dlsym(handle, name);
+    int64_t costUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+    if (symbol == nullptr) {
+        TELEPHONY_LOGE("ext wrapper symbol %{public}s failed, error: %{public}s", name, dlerror());
+    } else {
+        TELEPHONY_LOGD("ext wrapper symbol %{public}s resolved", name);
+    }
+    if (stats != nullptr) {
+        stats->Record(symbol != nullptr, costUs);
+    }
+    return symbol;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "link_stats_reader.h"
+
+#include <cerrno>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr size_t LINK_STATS_RECV_BUFFER_SIZE = 8192;
+static constexpr int32_t LINK_STATS_RECV_TIMEOUT_US = 200 * 1000;
+
+struct LinkStatsRequest {
+    struct nlmsghdr header;
+    struct if_stats_msg body;
+};
+
+static int32_t ParseStatsMessage(const struct nlmsghdr *header, std::map<int32_t, LinkStats> &stats)
+{
+    if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct if_stats_msg))) {
+        return EBADMSG;
+    }
+    const struct if_stats_msg *body = static_cast<const struct if_stats_msg *>(NLMSG_DATA(header));
+    int32_t attrLen = static_cast<int32_t>(header->nlmsg_len - NLMSG_LENGTH(sizeof(struct if_stats_msg)));
+    const struct rtattr *attr = reinterpret_cast<const struct rtattr *>(
+        reinterpret_cast<const uint8_t *>(body) + NLMSG_ALIGN(sizeof(struct if_stats_msg)));
+    for (; RTA_OK(attr, attrLen); attr = RTA_NEXT(attr, attrLen)) {
+        if (attr->rta_type != IFLA_STATS_LINK_64 || RTA_PAYLOAD(attr) < sizeof(struct rtnl_link_stats64)) {
+            continue;
+        }
+        const struct rtnl_link_stats64 *linkStats = static_cast<const struct rtnl_link_stats64 *>(RTA_DATA(attr));
+        LinkStats &entry = stats[static_cast<int32_t>(body->ifindex)];
+        entry.txPackets = static_cast<int64_t>(linkStats->tx_packets);
+        entry.rxPackets = static_cast<int64_t>(linkStats->rx_packets);
+        entry.txBytes = static_cast<int64_t>(linkStats->tx_bytes);
+        entry.rxBytes = static_cast<int64_t>(linkStats->rx_bytes);
+    }
+    return 0;
+}
+
+int32_t LinkStatsReader::ParseDump(const uint8_t *data, size_t size, uint32_t seq,
+    std::map<int32_t, LinkStats> &stats, bool &done)
+{
+    if (data == nullptr) {
+        return EINVAL;
+    }
+    int32_t len = static_cast<int32_t>(size);
+    for (const struct nlmsghdr *header = reinterpret_cast<const struct nlmsghdr *>(data); NLMSG_OK(header, len);
+        header = NLMSG_NEXT(header, len)) {
+        if (header->nlmsg_seq != seq) {
+            continue;
+        }
+        if (header->nlmsg_type == NLMSG_DONE) {
+            done = true;
+            return 0;
+        }
+        if (header->nlmsg_type == NLMSG_ERROR) {
+            if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct nlmsgerr))) {
+                return EBADMSG;
+            }
+            const struct nlmsgerr *err = static_cast<const struct nlmsgerr *>(NLMSG_DATA(header));
+            return err->error == 0 ? 0 : -err->error;
+        }
+        if (header->nlmsg_type != RTM_NEWSTATS) {
+            continue;
+        }
+        int32_t ret = ParseStatsMessage(header, stats);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+int32_t LinkStatsReader::ReadAll(std::map<int32_t, LinkStats> &stats)
+{
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        return errno;
+    }
+    struct timeval timeout = { 0, LINK_STATS_RECV_TIMEOUT_US };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    static uint32_t requestSeq = 0;
+    uint32_t seq = __atomic_add_fetch(&requestSeq, 1, __ATOMIC_RELAXED);
+    LinkStatsRequest request = {};
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct if_stats_msg));
+    request.header.nlmsg_type = RTM_GETSTATS;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = seq;
+    request.body.family = AF_UNSPEC;
+    request.body.filter_mask = IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64);
+    if (send(fd, &request, request.header.nlmsg_len, 0) < 0) {
+        int32_t sendErrno = errno;
+        close(fd);
+        return sendErrno;
+    }
+    uint8_t buffer[LINK_STATS_RECV_BUFFER_SIZE] __attribute__((aligned(NLMSG_ALIGNTO)));
+    bool done = false;
+    int32_t ret = 0;
+    while (!done && ret == 0) {
+        ssize_t size = recv(fd, buffer, sizeof(buffer), 0);
+        if (size < 0) {
+            ret = errno == EINTR ? 0 : errno;
+            continue;
+        }
+        if (size == 0) {
+            ret = EIO;
+            break;
+        }
+        ret = ParseDump(buffer, static_cast<size_t>(size), seq, stats, done);
+    }
+    close(fd);
+    if (ret != 0) {
+        TELEPHONY_LOGE("link stats dump failed, errno %{public}d", ret);
+    }
+    return ret;
+}
+} // namespace Telephony
+} // namespace OHOS
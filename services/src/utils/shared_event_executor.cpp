@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "shared_event_executor.h"
+
+#include <chrono>
+
+#include "parameters.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+static constexpr const char *SHARED_EXECUTOR_ENABLE = "persist.telephony.cellular_data.shared_executor";
+
+SharedEventExecutor &SharedEventExecutor::GetInstance()
+{
+    static SharedEventExecutor instance;
+    return instance;
+}
+
+SharedEventExecutor::SharedEventExecutor()
+{
+    enabled_ = system::GetBoolParameter(SHARED_EXECUTOR_ENABLE, false);
+    TELEPHONY_LOGI("shared event executor enabled: %{public}d", enabled_);
+}
+
+bool SharedEventExecutor::IsEnabled() const
+{
+    return enabled_;
+}
+
+std::shared_ptr<AppExecFwk::EventRunner> SharedEventExecutor::AcquireRunnerLocked()
+{
+    size_t index = 0;
+    for (size_t i = 1; i < runners_.size(); ++i) {
+        if (runnerLoads_[i] < runnerLoads_[index]) {
+            index = i;
+        }
+    }
+    if (runners_[index] == nullptr) {
+        runners_[index] = AppExecFwk::EventRunner::Create("StateMachineExecutor" + std::to_string(index));
+        if (runners_[index] == nullptr) {
+            TELEPHONY_LOGE("create state machine executor runner %{public}zu failed", index);
+            return nullptr;
+        }
+    }
+    runnerLoads_[index]++;
+    return runners_[index];
+}
+
+std::shared_ptr<AppExecFwk::EventRunner> SharedEventExecutor::AcquireRunner()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return nullptr;
+    }
+    std::shared_ptr<AppExecFwk::EventRunner> runner = AcquireRunnerLocked();
+    if (runner != nullptr) {
+        handlerCount_++;
+    }
+    return runner;
+}
+
+void SharedEventExecutor::ReleaseRunner(const std::shared_ptr<AppExecFwk::EventRunner> &runner)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < runners_.size(); ++i) {
+        if (runner != nullptr && runners_[i] == runner && runnerLoads_[i] > 0) {
+            runnerLoads_[i]--;
+            handlerCount_ = handlerCount_ > 0 ? handlerCount_ - 1 : 0;
+            break;
+        }
+    }
+}
+
+void SharedEventExecutor::RecordEvent(const AppExecFwk::InnerEvent::Pointer &event)
+{
+    if (event == nullptr) {
+        return;
+    }
+    int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t handleUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        event->GetHandleTime().time_since_epoch()).count();
+    int64_t waitUs = (handleUs > 0 && nowUs > handleUs) ? nowUs - handleUs : 0;
+    eventCount_.fetch_add(1, std::memory_order_relaxed);
+    totalWaitUs_.fetch_add(waitUs, std::memory_order_relaxed);
+    int64_t maxWaitUs = maxWaitUs_.load(std::memory_order_relaxed);
+    while (waitUs > maxWaitUs && !maxWaitUs_.compare_exchange_weak(maxWaitUs, waitUs, std::memory_order_relaxed)) {
+    }
+}
+
+SharedExecutorStats SharedEventExecutor::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    SharedExecutorStats stats;
+    stats.handlerCount = handlerCount_;
+    for (const std::shared_ptr<AppExecFwk::EventRunner> &runner : runners_) {
+        stats.sharedRunnerCount += (runner != nullptr) ? 1 : 0;
+    }
+    stats.eventCount = eventCount_.load(std::memory_order_relaxed);
+    stats.totalWaitUs = totalWaitUs_.load(std::memory_order_relaxed);
+    stats.maxWaitUs = maxWaitUs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SharedEventExecutor::ResetStats()
+{
+    eventCount_.store(0, std::memory_order_relaxed);
+    totalWaitUs_.store(0, std::memory_order_relaxed);
+    maxWaitUs_.store(0, std::memory_order_relaxed);
+}
+
+void SharedEventExecutor::Dump(std::string &result)
+{
+    SharedExecutorStats stats = GetStats();
+    int64_t count = static_cast<int64_t>(stats.eventCount);
+    result.append("State machine executor: shared=" + std::to_string(enabled_));
+    result.append(" handlers=" + std::to_string(stats.handlerCount));
+    result.append(" sharedRunners=" + std::to_string(stats.sharedRunnerCount));
+    result.append(" events=" + std::to_string(stats.eventCount));
+    result.append(" avgWaitUs=" + std::to_string(count > 0 ? stats.totalWaitUs / count : 0));
+    result.append(" maxWaitUs=" + std::to_string(stats.maxWaitUs) + "\n");
+}
+} // namespace Telephony
+} // namespace OHOS
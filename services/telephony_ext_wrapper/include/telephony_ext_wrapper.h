@@ -19,6 +19,7 @@
 #include "singleton.h"
 
 #include "apn_holder.h"
+#include "lazy_symbol.h"
 
 namespace OHOS {
 namespace Telephony {
@@ -28,6 +29,7 @@ DECLARE_DELAYED_REF_SINGLETON(TelephonyExtWrapper);
 public:
     DISALLOW_COPY_AND_MOVE(TelephonyExtWrapper);
     void InitTelephonyExtWrapper();
+    void DumpSymbolStats(std::string &result) const;
 
     typedef void (*DATA_EDN_SELF_CURE)(int32_t&, int32_t&);
     typedef void (*ReRegisterNetwork)(int32_t, bool&);
@@ -55,34 +57,35 @@ public:
     using IsDcCellularDataAllowedType = bool(*)();
     using IsVirtualModemSlotType = bool(*)(int32_t);
 
-    DATA_EDN_SELF_CURE dataEndSelfCure_ = nullptr;
-    ReRegisterNetwork reRegisterNetwork_ = nullptr;
-    IS_APN_ALLOWED_ACTIVE isApnAllowedActive_ = nullptr;
-    GET_VSIM_SLOT_ID getVSimSlotId_ = nullptr;
-    CREATE_ALL_APN_ITEM_EXT createAllApnItemExt_ = nullptr;
-    IS_CARD_ALLOW_DATA isCardAllowData_ = nullptr;
-    IS_VSIM_ENABLED isVSimEnabled_ = nullptr;
-    IS_VSIM_IN_DISABLE_PROCESS isVSimInDisableProcess_ = nullptr;
-    SEND_DATA_SWITCH_CHANGE_INFO sendDataSwitchChangeInfo_ = nullptr;
-    IS_DUAL_CELLULAR_CARD_ALLOWED isDualCellularCardAllowed_ = nullptr;
-    GET_USER_DATA_ROAMING_EXPEND getUserDataRoamingExpend_ = nullptr;
-    SEND_APN_NEED_RETRY_INFO sendApnNeedRetryInfo_ = nullptr;
-    HANDLE_DEND_FAILCAUSE handleDendFailcause_ = nullptr;
-    CONVERT_PDP_ERROR convertPdpError_ = nullptr;
-    RESTART_RADIO_IF_RQUIRED restartRadioIfRequired_ = nullptr;
-    DynamicLoadInit dynamicLoadInit_ = nullptr;
-    NotifyReqCellularData dynamicLoadNotifyReqCellularDataStatus_ = nullptr;
-    CREATE_DC_APN_ITEM_EXT createDcApnItemExt_ = nullptr;
-    IsVirtualModemConnectedType isVirtualModemConnected_ = nullptr;
-    IsDcCellularDataAllowedType isDcCellularDataAllowed_ = nullptr;
-    IsVirtualModemSlotType isVirtualModemSlot_ = nullptr;
-    REPORT_EVENT_TO_CHR reportEventToChr_ = nullptr;
-    SEND_CELLULAR_DATA_SLOT_CHANGE_INFO sendCellularDataSlotChangeInfo_ = nullptr;
+    LazySymbol<DATA_EDN_SELF_CURE> dataEndSelfCure_;
+    LazySymbol<ReRegisterNetwork> reRegisterNetwork_;
+    LazySymbol<IS_APN_ALLOWED_ACTIVE> isApnAllowedActive_;
+    LazySymbol<GET_VSIM_SLOT_ID> getVSimSlotId_;
+    LazySymbol<CREATE_ALL_APN_ITEM_EXT> createAllApnItemExt_;
+    LazySymbol<IS_CARD_ALLOW_DATA> isCardAllowData_;
+    LazySymbol<IS_VSIM_ENABLED> isVSimEnabled_;
+    LazySymbol<IS_VSIM_IN_DISABLE_PROCESS> isVSimInDisableProcess_;
+    LazySymbol<SEND_DATA_SWITCH_CHANGE_INFO> sendDataSwitchChangeInfo_;
+    LazySymbol<IS_DUAL_CELLULAR_CARD_ALLOWED> isDualCellularCardAllowed_;
+    LazySymbol<GET_USER_DATA_ROAMING_EXPEND> getUserDataRoamingExpend_;
+    LazySymbol<SEND_APN_NEED_RETRY_INFO> sendApnNeedRetryInfo_;
+    LazySymbol<HANDLE_DEND_FAILCAUSE> handleDendFailcause_;
+    LazySymbol<CONVERT_PDP_ERROR> convertPdpError_;
+    LazySymbol<RESTART_RADIO_IF_RQUIRED> restartRadioIfRequired_;
+    LazySymbol<DynamicLoadInit> dynamicLoadInit_;
+    LazySymbol<NotifyReqCellularData> dynamicLoadNotifyReqCellularDataStatus_;
+    LazySymbol<CREATE_DC_APN_ITEM_EXT> createDcApnItemExt_;
+    LazySymbol<IsVirtualModemConnectedType> isVirtualModemConnected_;
+    LazySymbol<IsDcCellularDataAllowedType> isDcCellularDataAllowed_;
+    LazySymbol<IsVirtualModemSlotType> isVirtualModemSlot_;
+    LazySymbol<REPORT_EVENT_TO_CHR> reportEventToChr_;
+    LazySymbol<SEND_CELLULAR_DATA_SLOT_CHANGE_INFO> sendCellularDataSlotChangeInfo_;
 
 private:
     void* telephonyExtWrapperHandle_ = nullptr;
     void* telephonyVSimWrapperHandle_ = nullptr;
     void* telephonyDynamicLoadWrapperHandle_ = nullptr;
+    LazySymbolStats symbolStats_;
 
     void InitTelephonyExtWrapperForCellularData();
     void InitDataEndSelfCure();
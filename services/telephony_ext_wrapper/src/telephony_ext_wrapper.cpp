@@ -53,6 +53,11 @@ void TelephonyExtWrapper::InitTelephonyExtWrapper()
     TELEPHONY_LOGI("telephony ext wrapper init success");
 }
 
+void TelephonyExtWrapper::DumpSymbolStats(std::string &result) const
+{
+    symbolStats_.Dump("TelephonyExtWrapper", result);
+}
+
 void TelephonyExtWrapper::InitTelephonyExtWrapperForCellularData()
 {
     telephonyExtWrapperHandle_ = dlopen(TELEPHONY_EXT_WRAPPER_PATH.c_str(), RTLD_NOW);
@@ -79,34 +84,18 @@ void TelephonyExtWrapper::InitTelephonyExtWrapperForCellularData()
 
 void TelephonyExtWrapper::InitDataEndSelfCure()
 {
-    dataEndSelfCure_ = (DATA_EDN_SELF_CURE)dlsym(telephonyExtWrapperHandle_, "DataEndSelfCure");
-    if (dataEndSelfCure_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol DataEndSelfCure failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init DataEndSelfCure success");
+    dataEndSelfCure_.Bind(telephonyExtWrapperHandle_, "DataEndSelfCure", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitReregisterNetwork()
 {
-    reRegisterNetwork_ = (ReRegisterNetwork)dlsym(telephonyExtWrapperHandle_, "ReregisterNetwork");
-    if (reRegisterNetwork_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol ReregisterNetwork failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init ReregisterNetwork success");
+    reRegisterNetwork_.Bind(telephonyExtWrapperHandle_, "ReregisterNetwork", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitTelephonyExtForCustomization()
 {
-    isApnAllowedActive_ = (IS_APN_ALLOWED_ACTIVE)dlsym(telephonyExtWrapperHandle_, "IsApnAllowedActive");
-    getUserDataRoamingExpend_ = (GET_USER_DATA_ROAMING_EXPEND)dlsym(telephonyExtWrapperHandle_,
-        "GetUserDataRoamingExpend");
-    if (isApnAllowedActive_ == nullptr || getUserDataRoamingExpend_ == nullptr) {
-        TELEPHONY_LOGE("InitTelephonyExtForCustomization failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init InitTelephonyExtForCustomization success");
+    isApnAllowedActive_.Bind(telephonyExtWrapperHandle_, "IsApnAllowedActive", &symbolStats_);
+    getUserDataRoamingExpend_.Bind(telephonyExtWrapperHandle_, "GetUserDataRoamingExpend", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitTelephonyExtWrapperForVSim()
@@ -117,77 +106,43 @@ void TelephonyExtWrapper::InitTelephonyExtWrapperForVSim()
         TELEPHONY_LOGE("libtel_vsim_symbol.z.so was not loaded, error: %{public}s", dlerror());
         return;
     }
-    getVSimSlotId_ = (GET_VSIM_SLOT_ID) dlsym(telephonyVSimWrapperHandle_, "GetVSimSlotId");
-    createAllApnItemExt_ = (CREATE_ALL_APN_ITEM_EXT) dlsym(telephonyVSimWrapperHandle_, "CreateAllApnItemExt");
-    isCardAllowData_ = (IS_CARD_ALLOW_DATA) dlsym(telephonyVSimWrapperHandle_, "IsCardAllowData");
-    isVSimEnabled_ = (IS_VSIM_ENABLED) dlsym(telephonyVSimWrapperHandle_, "IsVSimEnabled");
-    isVSimInDisableProcess_ = (IS_VSIM_IN_DISABLE_PROCESS) dlsym(telephonyVSimWrapperHandle_, "IsVSimInDisableProcess");
-
-    bool hasFuncNull = (getVSimSlotId_ == nullptr || createAllApnItemExt_ == nullptr || isCardAllowData_ == nullptr ||
-        isVSimEnabled_ == nullptr);
-    if (hasFuncNull) {
-        TELEPHONY_LOGE("[VSIM] telephony ext wrapper symbol failed, error: %{public}s", dlerror());
-        return;
-    }
+    // The vsim symbols are only used once a vsim is enabled, they are resolved on first use.
+    getVSimSlotId_.Bind(telephonyVSimWrapperHandle_, "GetVSimSlotId", &symbolStats_);
+    createAllApnItemExt_.Bind(telephonyVSimWrapperHandle_, "CreateAllApnItemExt", &symbolStats_);
+    isCardAllowData_.Bind(telephonyVSimWrapperHandle_, "IsCardAllowData", &symbolStats_);
+    isVSimEnabled_.Bind(telephonyVSimWrapperHandle_, "IsVSimEnabled", &symbolStats_);
+    isVSimInDisableProcess_.Bind(telephonyVSimWrapperHandle_, "IsVSimInDisableProcess", &symbolStats_);
     TELEPHONY_LOGI("[VSIM] telephony ext wrapper init success");
 }
 
 void TelephonyExtWrapper::InitSendDataSwitchChangeInfo()
 {
-    sendDataSwitchChangeInfo_ =
-        (SEND_DATA_SWITCH_CHANGE_INFO)dlsym(telephonyExtWrapperHandle_, "SendDataSwitchChangeInfo");
-    if (sendDataSwitchChangeInfo_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol SendDataSwitchChangeInfo failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init SendDataSwitchChangeInfo success");
+    sendDataSwitchChangeInfo_.Bind(telephonyExtWrapperHandle_, "SendDataSwitchChangeInfo", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitIsDualCellularCardAllowed()
 {
-    isDualCellularCardAllowed_ =
-        (IS_DUAL_CELLULAR_CARD_ALLOWED)dlsym(telephonyExtWrapperHandle_, "IsDualCellularCardAllowed");
-    if (isDualCellularCardAllowed_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol IsDualCellularCardAllowed failed,\
-            error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init IsDualCellularCardAllowed success");
+    isDualCellularCardAllowed_.Bind(telephonyExtWrapperHandle_, "IsDualCellularCardAllowed", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitHandleDendFailcause()
 {
-    handleDendFailcause_ = (HANDLE_DEND_FAILCAUSE)dlsym(telephonyExtWrapperHandle_, "HandleDendFailcause");
-    if (handleDendFailcause_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol HandleDendFailcause failed, error: %{public}s", dlerror());
-    }
+    handleDendFailcause_.Bind(telephonyExtWrapperHandle_, "HandleDendFailcause", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitConvertPdpError()
 {
-    convertPdpError_ = (CONVERT_PDP_ERROR)dlsym(telephonyExtWrapperHandle_, "ConvertPdpError");
-    if (convertPdpError_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol ConvertPdpError failed, error: %{public}s", dlerror());
-    }
+    convertPdpError_.Bind(telephonyExtWrapperHandle_, "ConvertPdpError", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitRestartRadioIfRequired()
 {
-    restartRadioIfRequired_ = (RESTART_RADIO_IF_RQUIRED)dlsym(telephonyExtWrapperHandle_, "RestartRadioIfRequired");
-    if (restartRadioIfRequired_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol RestartRadioIfRequired failed, error: %{public}s", dlerror());
-    }
+    restartRadioIfRequired_.Bind(telephonyExtWrapperHandle_, "RestartRadioIfRequired", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitSendApnNeedRetryInfo()
 {
-    sendApnNeedRetryInfo_ =
-        (SEND_APN_NEED_RETRY_INFO)dlsym(telephonyExtWrapperHandle_, "SendApnNeedRetryInfo");
-    if (sendApnNeedRetryInfo_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol SendApnNeedRetryInfo failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init SendApnNeedRetryInfo success");
+    sendApnNeedRetryInfo_.Bind(telephonyExtWrapperHandle_, "SendApnNeedRetryInfo", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitTelephonyExtWrapperForDynamicLoad()
@@ -198,30 +153,20 @@ void TelephonyExtWrapper::InitTelephonyExtWrapperForDynamicLoad()
         TELEPHONY_LOGE("[DynamicLoad] libtel_dynamic_load_service.z.so was not loaded, error: %{public}s", dlerror());
         return;
     }
-    dynamicLoadInit_ = (DynamicLoadInit)dlsym(telephonyDynamicLoadWrapperHandle_, "InitDynamicLoadHandle");
+    dynamicLoadInit_.Bind(telephonyDynamicLoadWrapperHandle_, "InitDynamicLoadHandle", &symbolStats_);
+    // A library without the init entry is not a dynamic load service, do not hand out its other symbols.
     if (dynamicLoadInit_ == nullptr) {
-        TELEPHONY_LOGE("[DynamicLoad] telephony ext wrapper symbol failed, error: %{public}s", dlerror());
-        return;
-    }
-    dynamicLoadNotifyReqCellularDataStatus_ =
-        (NotifyReqCellularData)dlsym(telephonyDynamicLoadWrapperHandle_, "InformReqCellularDataStatus");
-    if (dynamicLoadNotifyReqCellularDataStatus_ == nullptr) {
-        TELEPHONY_LOGE("[DynamicLoad] telephony ext wrapper dynamicLoadNotifyReqCellularDataStatus_ symbol failed,\
-            error: %{public}s", dlerror());
+        TELEPHONY_LOGE("[DynamicLoad] telephony ext wrapper symbol failed");
         return;
     }
+    dynamicLoadNotifyReqCellularDataStatus_.Bind(telephonyDynamicLoadWrapperHandle_, "InformReqCellularDataStatus",
+        &symbolStats_);
     TELEPHONY_LOGI("[DynamicLoad]telephony ext wrapper dynamic load init success");
 }
 
 void TelephonyExtWrapper::InitCreateDcApnItemExt()
 {
-    createDcApnItemExt_ =
-        (CREATE_DC_APN_ITEM_EXT)dlsym(telephonyExtWrapperHandle_, "CreateDcApnItemExt");
-    if (createDcApnItemExt_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol CreateDcApnItemExt failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGI("telephony ext wrapper init CreateDcApnItemExt success");
+    createDcApnItemExt_.Bind(telephonyExtWrapperHandle_, "CreateDcApnItemExt", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitIsVirtualModemConnected()
@@ -231,13 +176,7 @@ void TelephonyExtWrapper::InitIsVirtualModemConnected()
         isVirtualModemConnected_ = nullptr;
         return;
     }
-    isVirtualModemConnected_ =
-        (IsDcCellularDataAllowedType)dlsym(telephonyExtWrapperHandle_, "IsVirtualModemConnected");
-    if (isVirtualModemConnected_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol IsVirtualModemConnected failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGI("telephony ext wrapper init IsVirtualModemConnected success");
+    isVirtualModemConnected_.Bind(telephonyExtWrapperHandle_, "IsVirtualModemConnected", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitIsDcCellularDataAllowed()
@@ -247,13 +186,7 @@ void TelephonyExtWrapper::InitIsDcCellularDataAllowed()
         isDcCellularDataAllowed_ = nullptr;
         return;
     }
-    isDcCellularDataAllowed_ =
-        (IsDcCellularDataAllowedType)dlsym(telephonyExtWrapperHandle_, "IsDcCellularDataAllowed");
-    if (isDcCellularDataAllowed_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol IsDcCellularDataAllowed failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGI("telephony ext wrapper init IsDcCellularDataAllowed success");
+    isDcCellularDataAllowed_.Bind(telephonyExtWrapperHandle_, "IsDcCellularDataAllowed", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitIsVirtualModemSlot()
@@ -263,35 +196,17 @@ void TelephonyExtWrapper::InitIsVirtualModemSlot()
         isVirtualModemSlot_ = nullptr;
         return;
     }
-    isVirtualModemSlot_ =
-        (IsVirtualModemSlotType)dlsym(telephonyExtWrapperHandle_, "IsVirtualModemSlot");
-    if (isVirtualModemSlot_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol IsVirtualModemSlot failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGI("telephony ext wrapper init IsVirtualModemSlot success");
+    isVirtualModemSlot_.Bind(telephonyExtWrapperHandle_, "IsVirtualModemSlot", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitReportEventToChr()
 {
-    reportEventToChr_ = (REPORT_EVENT_TO_CHR)dlsym(telephonyExtWrapperHandle_, "ReportEventToChr");
-    if (reportEventToChr_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol ReportEventToChr failed, error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init ReportEventToChr success");
+    reportEventToChr_.Bind(telephonyExtWrapperHandle_, "ReportEventToChr", &symbolStats_);
 }
 
 void TelephonyExtWrapper::InitSendCellularDataSlotChangeInfo()
 {
-    sendCellularDataSlotChangeInfo_ =
-        (SEND_CELLULAR_DATA_SLOT_CHANGE_INFO)dlsym(telephonyExtWrapperHandle_, "SendCellularDataSlotChangeInfo");
-    if (sendCellularDataSlotChangeInfo_ == nullptr) {
-        TELEPHONY_LOGE("telephony ext wrapper symbol InitSendCellularDataSlotChangeInfo failed,\
-            error: %{public}s", dlerror());
-        return;
-    }
-    TELEPHONY_LOGD("telephony ext wrapper init SendCellularDataSlotChangeInfo success");
+    sendCellularDataSlotChangeInfo_.Bind(telephonyExtWrapperHandle_, "SendCellularDataSlotChangeInfo", &symbolStats_);
 }
 } // namespace Telephony
 } // namespace OHOS
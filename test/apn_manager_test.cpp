@@ -15,6 +15,9 @@
 #define private public
 #define protected public
 
+#include <chrono>
+#include <random>
+
 #include "apn_holder.h"
 #include "apn_manager.h"
 #include "cellular_data_state_machine.h"
@@ -392,7 +395,7 @@ HWTEST_F(ApnManagerTest, IsPreferredApnUserEdited_001, Function | MediumTest | L
     sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
     defaultApnItem->attr_.profileId_ = preferId;
     defaultApnItem->attr_.isEdited_ = true;
-    apnManager->allApnItem_.push_back(defaultApnItem);
+    apnManager->UpdateApnCatalog({ defaultApnItem });
     apnManager->preferId_ = preferId;
     ASSERT_TRUE(apnManager->IsPreferredApnUserEdited());
 }
@@ -408,7 +411,7 @@ HWTEST_F(ApnManagerTest, IsPreferredApnUserEdited_002, Function | MediumTest | L
     sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
     defaultApnItem->attr_.profileId_ = preferId;
     defaultApnItem->attr_.isEdited_ = false;
-    apnManager->allApnItem_.push_back(defaultApnItem);
+    apnManager->UpdateApnCatalog({ defaultApnItem });
     apnManager->preferId_ = preferId;
     ASSERT_FALSE(apnManager->IsPreferredApnUserEdited());
 }
@@ -424,7 +427,7 @@ HWTEST_F(ApnManagerTest, IsPreferredApnUserEdited_003, Function | MediumTest | L
     sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
     defaultApnItem->attr_.profileId_ = 3;
     defaultApnItem->attr_.isEdited_ = true;
-    apnManager->allApnItem_.push_back(defaultApnItem);
+    apnManager->UpdateApnCatalog({ defaultApnItem });
     apnManager->preferId_ = preferId;
     ASSERT_FALSE(apnManager->IsPreferredApnUserEdited());
 }
@@ -630,7 +633,7 @@ HWTEST_F(ApnManagerTest, HasAnyConnectedState_004, Function | MediumTest | Level
 HWTEST_F(ApnManagerTest, GetRilAttachApn_001, Function | MediumTest | Level1)
 {
     std::vector<sptr<ApnItem>> allApnItem;
-    apnManager->allApnItem_ = allApnItem;
+    apnManager->UpdateApnCatalog(allApnItem);
     ASSERT_EQ(apnManager->GetRilAttachApn(), nullptr);
 }
 
@@ -644,7 +647,7 @@ HWTEST_F(ApnManagerTest, GetRilAttachApn_002, Function | MediumTest | Level1)
     std::vector<sptr<ApnItem>> allApnItem;
     sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
     allApnItem.push_back(defaultApnItem);
-    apnManager->allApnItem_ = allApnItem;
+    apnManager->UpdateApnCatalog(allApnItem);
     ASSERT_NE(apnManager->GetRilAttachApn(), nullptr);
 }
 
@@ -658,7 +661,7 @@ HWTEST_F(ApnManagerTest, GetRilAttachApn_003, Function | MediumTest | Level1)
     std::vector<sptr<ApnItem>> allApnItem;
     sptr<ApnItem> apnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_IA);
     allApnItem.push_back(apnItem);
-    apnManager->allApnItem_ = allApnItem;
+    apnManager->UpdateApnCatalog(allApnItem);
     ASSERT_NE(apnManager->GetRilAttachApn(), nullptr);
 }
 
@@ -672,7 +675,7 @@ HWTEST_F(ApnManagerTest, GetRilAttachApn_004, Function | MediumTest | Level1)
     std::vector<sptr<ApnItem>> allApnItem;
     sptr<ApnItem> apnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_MMS);
     allApnItem.push_back(apnItem);
-    apnManager->allApnItem_ = allApnItem;
+    apnManager->UpdateApnCatalog(allApnItem);
     ASSERT_NE(apnManager->GetRilAttachApn(), nullptr);
 }
 
@@ -1223,7 +1226,7 @@ HWTEST_F(ApnManagerTest, UpdateDefaultCellularDataSlotId_001, TestSize.Level0)
 HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_001, TestSize.Level0)
 {
     ApnItem apnItem;
-    apnItem.apnTypes_.push_back("default");
+    apnItem.SetApnTypes("default");
     EXPECT_TRUE(apnItem.CanDealWithType("default"));
 }
 
@@ -1236,7 +1239,7 @@ HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_001, TestSize.Level0)
 HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_002, TestSize.Level0)
 {
     ApnItem apnItem;
-    apnItem.apnTypes_.push_back(DATA_CONTEXT_ROLE_DEFAULT);
+    apnItem.SetApnTypes(DATA_CONTEXT_ROLE_DEFAULT);
     EXPECT_TRUE(apnItem.CanDealWithType(DATA_CONTEXT_ROLE_INTERNAL_DEFAULT));
 }
 
@@ -1249,7 +1252,7 @@ HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_002, TestSize.Level0)
 HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_003, TestSize.Level0)
 {
     ApnItem apnItem;
-    apnItem.apnTypes_.push_back(DATA_CONTEXT_ROLE_ALL);
+    apnItem.SetApnTypes(DATA_CONTEXT_ROLE_ALL);
     EXPECT_TRUE(apnItem.CanDealWithType("not_ia"));
 }
 
@@ -1261,7 +1264,7 @@ HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_003, TestSize.Level0)
 HWTEST_F(ApnManagerTest, ApnItem_CanDealWithType_004, TestSize.Level0)
 {
     ApnItem apnItem;
-    apnItem.apnTypes_.push_back("default");
+    apnItem.SetApnTypes("default");
     EXPECT_FALSE(apnItem.CanDealWithType("other"));
 }
 
@@ -1470,12 +1473,12 @@ HWTEST_F(ApnManagerTest, ApnItem_IsSimilarProperty_001, TestSize.Level0)
 HWTEST_F(ApnManagerTest, FetchBipApns_001, TestSize.Level0)
 {
     sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
-    apnManager->allApnItem_.push_back(defaultApnItem);
+    apnManager->UpdateApnCatalog({ defaultApnItem });
     std::vector<sptr<ApnItem>> bipApnList;
     apnManager->FetchBipApns(bipApnList);
     EXPECT_GE(bipApnList.size(), 0);
     sptr<ApnItem> bipApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_BIP);
-    apnManager->allApnItem_.push_back(bipApnItem);
+    apnManager->UpdateApnCatalog({ defaultApnItem, bipApnItem });
     bipApnList.clear();
     apnManager->FetchBipApns(bipApnList);
     EXPECT_GE(bipApnList.size(), 0);
@@ -1700,5 +1703,341 @@ HWTEST_F(ApnManagerTest, ApnItem_GetPreferId_001, TestSize.Level0)
     bool ret = apnManager->GetPreferId(slotId, errMsg);
     EXPECT_FALSE(ret);
 }
+
+/**
+ * @tc.number   ApnItem_CompactAttribute_001
+ * @tc.name     test memory of a large synthetic apn set
+ * @tc.desc     Function test
+ */
+HWTEST_F(ApnManagerTest, ApnItem_CompactAttribute_001, TestSize.Level0)
+{
+    const int32_t profileNum = 2000;
+    const int32_t apnNameNum = 50;
+    std::vector<sptr<ApnItem>> apnItems;
+    PdpProfile pdpProfile;
+    pdpProfile.apnTypes = "default,mms,supl";
+    pdpProfile.mcc = "460";
+    pdpProfile.mnc = "00";
+    pdpProfile.pdpProtocol = "IPV4V6";
+    pdpProfile.roamPdpProtocol = "IPV4V6";
+    pdpProfile.mmsIpAddress = "10.0.0.172:80";
+    for (int32_t i = 0; i < profileNum; i++) {
+        pdpProfile.profileId = i;
+        pdpProfile.apn = "synthetic" + std::to_string(i % apnNameNum);
+        pdpProfile.profileName = "SYNTHETIC" + std::to_string(i % apnNameNum);
+        apnItems.push_back(ApnItem::MakeApn(pdpProfile));
+    }
+    size_t stringCount = ApnStringPool::GetInstance().GetStringCount();
+    size_t stringBytes = ApnStringPool::GetInstance().GetStringBytes();
+    for (int32_t i = 0; i < profileNum; i++) {
+        pdpProfile.profileId = i;
+        pdpProfile.apn = "synthetic" + std::to_string(i % apnNameNum);
+        pdpProfile.profileName = "SYNTHETIC" + std::to_string(i % apnNameNum);
+        apnItems.push_back(ApnItem::MakeApn(pdpProfile));
+    }
+    EXPECT_EQ(ApnStringPool::GetInstance().GetStringCount(), stringCount);
+    size_t compactBytes = apnItems.size() * sizeof(ApnItem::CompactAttribute) + stringBytes;
+    EXPECT_LT(compactBytes, apnItems.size() * sizeof(ApnItem::Attribute) / 10);
+    EXPECT_EQ(apnItems[0]->attr_.types_.c_str(), apnItems[profileNum]->attr_.types_.c_str());
+
+    ApnItem::Attribute attr;
+    apnItems[1]->attr_.ToAttribute(attr);
+    EXPECT_STREQ(attr.types_, "default,mms,supl");
+    EXPECT_STREQ(attr.numeric_, "46000");
+    EXPECT_STREQ(attr.apn_, "synthetic1");
+    EXPECT_STREQ(attr.apnName_, "SYNTHETIC1");
+    EXPECT_STREQ(attr.user_, "");
+    EXPECT_EQ(attr.profileId_, 1);
+}
+
+/**
+ * @tc.number   ApnItem_CompactAttribute_002
+ * @tc.name     test credentials stay out of the string pool and unused strings are evicted
+ * @tc.desc     Function test
+ */
+HWTEST_F(ApnManagerTest, ApnItem_CompactAttribute_002, TestSize.Level0)
+{
+    ApnStringPool &pool = ApnStringPool::GetInstance();
+    PdpProfile pdpProfile;
+    pdpProfile.apnTypes = "default";
+    pdpProfile.apn = "credential";
+    pdpProfile.authUser = "pool_test_user";
+    pdpProfile.authPwd = "pool_test_password";
+    sptr<ApnItem> apnItem = ApnItem::MakeApn(pdpProfile);
+    size_t stringCount = pool.GetStringCount();
+    sptr<ApnItem> sameApnItem = ApnItem::MakeApn(pdpProfile);
+    pdpProfile.authUser = "pool_test_other_user";
+    pdpProfile.authPwd = "pool_test_other_password";
+    sptr<ApnItem> otherApnItem = ApnItem::MakeApn(pdpProfile);
+    EXPECT_EQ(pool.GetStringCount(), stringCount);
+    EXPECT_STREQ(apnItem->attr_.password_.c_str(), "pool_test_password");
+    EXPECT_TRUE(apnItem->attr_.password_.IsSame(sameApnItem->attr_.password_));
+    EXPECT_TRUE(apnItem->HasSameAttr(*sameApnItem));
+    EXPECT_FALSE(apnItem->attr_.password_.IsSame(otherApnItem->attr_.password_));
+
+    const int32_t stringNum = static_cast<int32_t>(APN_STRING_POOL_MAX_SIZE);
+    {
+        std::vector<ApnString> strings;
+        for (int32_t i = 0; i < stringNum; i++) {
+            strings.emplace_back("pool_test_" + std::to_string(i));
+        }
+        EXPECT_LE(pool.GetStringCount(), APN_STRING_POOL_MAX_SIZE);
+    }
+    // The strings above are no longer referenced, the next new value sweeps them away.
+    ApnString other("pool_test_other");
+    EXPECT_LT(pool.GetStringCount(), stringCount + stringNum / 2);
+    EXPECT_STREQ(other.c_str(), "pool_test_other");
+}
+
+/**
+ * @tc.number   ApnCatalog_001
+ * @tc.name     test lookups of the indexed apn catalog
+ * @tc.desc     Function test
+ */
+HWTEST_F(ApnManagerTest, ApnCatalog_001, TestSize.Level0)
+{
+    sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn("default,mms");
+    defaultApnItem->attr_.profileId_ = 1;
+    sptr<ApnItem> allTypeApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_ALL);
+    allTypeApnItem->attr_.profileId_ = 2;
+    sptr<ApnItem> iaApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_IA);
+    iaApnItem->attr_.profileId_ = 3;
+    sptr<ApnItem> sameIdApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_MMS);
+    sameIdApnItem->attr_.profileId_ = 1;
+    apnManager->UpdateApnCatalog({ defaultApnItem, allTypeApnItem, iaApnItem, sameIdApnItem });
+    apnManager->preferId_ = INVALID_PROFILE_ID;
+
+    std::vector<sptr<ApnItem>> mmsApns = apnManager->FilterMatchedApns(DATA_CONTEXT_ROLE_MMS, 0);
+    ASSERT_EQ(mmsApns.size(), 3);
+    EXPECT_EQ(mmsApns[0], defaultApnItem);
+    EXPECT_EQ(mmsApns[1], allTypeApnItem);
+    EXPECT_EQ(mmsApns[2], sameIdApnItem);
+    EXPECT_EQ(apnManager->FilterMatchedApns(DATA_CONTEXT_ROLE_INTERNAL_DEFAULT, 0).size(), 2);
+    EXPECT_EQ(apnManager->FilterMatchedApns(DATA_CONTEXT_ROLE_IA, 0).size(), 1);
+    EXPECT_EQ(apnManager->FilterMatchedApns("hipri", 0).size(), 1);
+    EXPECT_EQ(apnManager->GetApnItemById(1), defaultApnItem);
+    EXPECT_EQ(apnManager->GetApnItemById(4), nullptr);
+    EXPECT_EQ(apnManager->GetRilAttachApn(), iaApnItem);
+    apnManager->preferId_ = 2;
+    EXPECT_EQ(apnManager->GetRilAttachApn(), defaultApnItem);
+
+    apnManager->UpdateApnCatalog({ sameIdApnItem });
+    EXPECT_EQ(apnManager->GetApnItemById(1), sameIdApnItem);
+    EXPECT_EQ(apnManager->GetRilAttachApn(), sameIdApnItem);
+}
+
+/**
+ * @tc.number   ApnItem_DerivedFields_001
+ * @tc.name     test fields derived from the apn attributes at load
+ * @tc.desc     Function test
+ */
+HWTEST_F(ApnManagerTest, ApnItem_DerivedFields_001, TestSize.Level0)
+{
+    PdpProfile pdpProfile;
+    pdpProfile.apnTypes = "default,MMS";
+    pdpProfile.pdpProtocol = "IPV4V6";
+    pdpProfile.roamPdpProtocol = "IP";
+    pdpProfile.proxyIpAddress = "10.0.0.172:8080";
+    sptr<ApnItem> apnItem = ApnItem::MakeApn(pdpProfile);
+    ASSERT_NE(apnItem, nullptr);
+    EXPECT_EQ(apnItem->GetTypesMask(), static_cast<uint32_t>(ApnTypes::DEFAULT) |
+        static_cast<uint32_t>(ApnTypes::MMS) | static_cast<uint32_t>(ApnTypes::INTERNAL_DEFAULT));
+    EXPECT_EQ(apnItem->GetProtocolType(false), ApnProtocolType::PROTOCOL_IPV4V6);
+    EXPECT_EQ(apnItem->GetProtocolType(true), ApnProtocolType::PROTOCOL_IPV4);
+    EXPECT_EQ(apnItem->GetProxyHost(), "10.0.0.172");
+    EXPECT_EQ(apnItem->GetProxyPort(), 8080);
+
+    sptr<ApnItem> sameApnItem = ApnItem::MakeApn(pdpProfile);
+    EXPECT_EQ(apnItem->GetFingerprint(), sameApnItem->GetFingerprint());
+    EXPECT_TRUE(ApnHolder::IsSameApnItem(apnItem, sameApnItem, true));
+    pdpProfile.homeUrl = "http://mms";
+    sptr<ApnItem> otherApnItem = ApnItem::MakeApn(pdpProfile);
+    EXPECT_NE(apnItem->GetFingerprint(), otherApnItem->GetFingerprint());
+    EXPECT_FALSE(ApnHolder::IsSameApnItem(apnItem, otherApnItem, false));
+    EXPECT_TRUE(ApnHolder::IsCompatibleApnItem(apnItem, otherApnItem, false));
+}
+
+static std::vector<PdpProfile> MakeSyntheticPdpProfiles(size_t profileNum)
+{
+    static const std::vector<std::string> apns = { "cmnet", "cmwap", "ims", "3gnet", "ctnet", "" };
+    static const std::vector<std::string> types = { "default", "mms", "supl", "dun", "ia", "default,supl", "" };
+    static const std::vector<std::string> protocols = { "IP", "IPV6", "IPV4V6", "" };
+    static const std::vector<std::string> mvnoTypes = { "", "spn", "imsi", "gid1" };
+    static const std::vector<std::string> urls = { "", "http://mmsc", "10.0.0.172:80" };
+    std::mt19937 random(static_cast<uint32_t>(profileNum));
+    auto pick = [&random](const std::vector<std::string> &values) {
+        return values[random() % values.size()];
+    };
+    std::vector<PdpProfile> apnVec(profileNum);
+    for (size_t i = 0; i < profileNum; i++) {
+        apnVec[i].profileId = static_cast<int32_t>(i + 1);
+        apnVec[i].apn = pick(apns) + std::to_string(random() % (profileNum / 10 + 1));
+        apnVec[i].apnTypes = pick(types);
+        apnVec[i].pdpProtocol = pick(protocols);
+        apnVec[i].roamPdpProtocol = pick(protocols);
+        apnVec[i].mvnoType = pick(mvnoTypes);
+        apnVec[i].mvnoMatchData = apnVec[i].mvnoType.empty() ? "" : std::to_string(random() % 2);
+        apnVec[i].homeUrl = pick(urls);
+        apnVec[i].mmsIpAddress = pick(urls);
+        apnVec[i].proxyIpAddress = pick(urls);
+    }
+    return apnVec;
+}
+
+static void TryMergeSimilarPdpProfileByPairs(ApnManager &apnManager, std::vector<PdpProfile> &apnVec)
+{
+    std::vector<PdpProfile> newApnVec;
+    for (size_t i = 0; i < apnVec.size(); i++) {
+        if (apnVec[i].profileId == -1) {
+            continue;
+        }
+        for (size_t j = i + 1; j < apnVec.size(); j++) {
+            if (ApnItem::IsSimilarPdpProfile(apnVec[i], apnVec[j])) {
+                apnManager.MergePdpProfile(apnVec[i], apnVec[j]);
+                apnVec[j].profileId = -1;
+            }
+        }
+        newApnVec.push_back(apnVec[i]);
+    }
+    apnVec.assign(newApnVec.begin(), newApnVec.end());
+}
+
+static void CheckMergeSimilarPdpProfile(size_t profileNum)
+{
+    std::vector<PdpProfile> expectVec = MakeSyntheticPdpProfiles(profileNum);
+    std::vector<PdpProfile> apnVec = expectVec;
+    ApnManager expectManager;
+    ApnManager apnManager;
+    expectManager.preferId_ = INVALID_PROFILE_ID;
+    apnManager.preferId_ = INVALID_PROFILE_ID;
+    auto beginTime = std::chrono::steady_clock::now();
+    TryMergeSimilarPdpProfileByPairs(expectManager, expectVec);
+    auto pairTime = std::chrono::steady_clock::now();
+    apnManager.TryMergeSimilarPdpProfile(apnVec);
+    auto bucketTime = std::chrono::steady_clock::now();
+    TELEPHONY_LOGI("merge %{public}zu profiles: pairs %{public}lld us, buckets %{public}lld us", profileNum,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(pairTime - beginTime).count()),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(bucketTime - pairTime).count()));
+    EXPECT_LT(apnVec.size(), profileNum);
+    ASSERT_EQ(apnVec.size(), expectVec.size());
+    EXPECT_EQ(apnManager.preferId_, expectManager.preferId_);
+    for (size_t i = 0; i < apnVec.size(); i++) {
+        EXPECT_EQ(apnVec[i].profileId, expectVec[i].profileId);
+        EXPECT_EQ(apnVec[i].apn, expectVec[i].apn);
+        EXPECT_EQ(apnVec[i].apnTypes, expectVec[i].apnTypes);
+        EXPECT_EQ(apnVec[i].pdpProtocol, expectVec[i].pdpProtocol);
+        EXPECT_EQ(apnVec[i].roamPdpProtocol, expectVec[i].roamPdpProtocol);
+        EXPECT_EQ(apnVec[i].homeUrl, expectVec[i].homeUrl);
+        EXPECT_EQ(apnVec[i].mmsIpAddress, expectVec[i].mmsIpAddress);
+        EXPECT_EQ(apnVec[i].proxyIpAddress, expectVec[i].proxyIpAddress);
+    }
+}
+
+/**
+ * @tc.name  : ApnManager_TryMergeSimilarPdpProfile_003
+ * @tc.number: ApnManagerTest_005
+ * @tc.desc  : The bucketed merge gives the same result as comparing every pair
+ */
+HWTEST_F(ApnManagerTest, ApnManager_TryMergeSimilarPdpProfile_003, TestSize.Level0)
+{
+    CheckMergeSimilarPdpProfile(1000);
+}
+
+/**
+ * @tc.name  : ApnManager_TryMergeSimilarPdpProfile_004
+ * @tc.number: ApnManagerTest_005
+ * @tc.desc  : Same as 003 on a large database, the elapsed time of both merges is logged
+ */
+HWTEST_F(ApnManagerTest, ApnManager_TryMergeSimilarPdpProfile_004, TestSize.Level1)
+{
+    CheckMergeSimilarPdpProfile(10000);
+}
+
+/**
+ * @tc.name  : ApnSnapshotCache_001
+ * @tc.number: ApnManagerTest_006
+ * @tc.desc  : A snapshot only deserializes with the key of the sim it was made for and with an intact payload
+ */
+HWTEST_F(ApnManagerTest, ApnSnapshotCache_001, TestSize.Level0)
+{
+    ApnQueryParam param;
+    param.simId = 1;
+    param.mcc = "460";
+    param.mnc = "00";
+    param.imsi = "460001234567890";
+    ApnSnapshot snapshot;
+    snapshot.preferId = 2;
+    snapshot.profiles = MakeSyntheticPdpProfiles(10);
+    std::string buffer;
+    ApnSnapshotCache::Serialize(ApnSnapshotCache::MakeKey(param), snapshot, buffer);
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(buffer.data());
+    ApnSnapshot result;
+    ASSERT_TRUE(ApnSnapshotCache::Deserialize(data, buffer.size(), ApnSnapshotCache::MakeKey(param), result));
+    EXPECT_TRUE(ApnSnapshotCache::IsSameSnapshot(snapshot, result));
+    ApnQueryParam otherParam = param;
+    otherParam.imsi = "460001234567891";
+    EXPECT_FALSE(ApnSnapshotCache::Deserialize(data, buffer.size(), ApnSnapshotCache::MakeKey(otherParam), result));
+    EXPECT_FALSE(ApnSnapshotCache::Deserialize(data, buffer.size() - 1, ApnSnapshotCache::MakeKey(param), result));
+    buffer.back() ^= 1;
+    data = reinterpret_cast<const uint8_t *>(buffer.data());
+    EXPECT_FALSE(ApnSnapshotCache::Deserialize(data, buffer.size(), ApnSnapshotCache::MakeKey(param), result));
+}
+
+/**
+ * @tc.name  : ApnSnapshotCache_002
+ * @tc.number: ApnManagerTest_006
+ * @tc.desc  : A stored snapshot is loaded back until invalidated, a store racing an invalidation is dropped
+ */
+HWTEST_F(ApnManagerTest, ApnSnapshotCache_002, TestSize.Level0)
+{
+    ApnSnapshotCache &cache = ApnSnapshotCache::GetInstance();
+    cache.SetSnapshotDir("/data/local/tmp");
+    ApnQueryParam param;
+    param.simId = 1;
+    param.mcc = "460";
+    param.mnc = "00";
+    ApnSnapshot snapshot;
+    snapshot.preferId = 1;
+    snapshot.profiles = MakeSyntheticPdpProfiles(5);
+    uint64_t generation = cache.GetGeneration(0);
+    ASSERT_TRUE(cache.Store(0, param, snapshot, generation));
+    ApnSnapshot result;
+    ASSERT_TRUE(cache.Load(0, param, result));
+    EXPECT_TRUE(ApnSnapshotCache::IsSameSnapshot(snapshot, result));
+    cache.Invalidate(0);
+    EXPECT_FALSE(cache.Load(0, param, result));
+    EXPECT_FALSE(cache.Store(0, param, snapshot, generation));
+    EXPECT_FALSE(cache.Store(-1, param, snapshot, generation));
+    cache.SetSnapshotDir("");
+}
+
+/**
+ * @tc.name  : ApnSnapshotCache_003
+ * @tc.number: ApnManagerTest_006
+ * @tc.desc  : Credentials never reach the snapshot file, missing parent directories are created
+ */
+HWTEST_F(ApnManagerTest, ApnSnapshotCache_003, TestSize.Level0)
+{
+    ApnSnapshotCache &cache = ApnSnapshotCache::GetInstance();
+    cache.SetSnapshotDir("/data/local/tmp/apn_snapshot_test/nested");
+    ApnQueryParam param;
+    param.simId = 1;
+    param.mcc = "460";
+    param.mnc = "00";
+    ApnSnapshot snapshot;
+    snapshot.profiles = MakeSyntheticPdpProfiles(5);
+    std::string buffer;
+    snapshot.profiles[0].authPwd = "snapshot_secret";
+    ApnSnapshotCache::Serialize(ApnSnapshotCache::MakeKey(param), snapshot, buffer);
+    EXPECT_EQ(buffer.find("snapshot_secret"), std::string::npos);
+    EXPECT_TRUE(ApnSnapshotCache::HasCredential(snapshot));
+    EXPECT_FALSE(cache.Store(0, param, snapshot, cache.GetGeneration(0)));
+    snapshot.profiles[0].authPwd.clear();
+    EXPECT_TRUE(cache.Store(0, param, snapshot, cache.GetGeneration(0)));
+    ApnSnapshot emptySnapshot;
+    EXPECT_FALSE(ApnSnapshotCache::IsSameSnapshot(snapshot, emptySnapshot));
+    cache.Invalidate(0);
+    cache.SetSnapshotDir("");
+}
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
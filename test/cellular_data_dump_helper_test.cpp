@@ -19,6 +19,8 @@
 #include <gtest/gtest.h>
 
 #include "cellular_data_dump_helper.h"
+#include "cellular_data_perf_stats.h"
+#include "cellular_data_setup_tracer.h"
 #include "core_service_client.h"
 #include "mock/mock_core_service.h"
 #include "telephony_types.h"
@@ -149,5 +151,72 @@ HWTEST_F(CellularDataDumpHelperTest, CellularDataDumpHelper_04, Function | Mediu
     maxSlotCount_ = 0;
 }
 
+HWTEST_F(CellularDataDumpHelperTest, CellularDataDumpHelper_05, Function | MediumTest | Level1)
+{
+    CellularDataPerfStats &perfStats = CellularDataPerfStats::GetInstance();
+    perfStats.Reset(0);
+    perfStats.RecordEvent(0, PerfComponent::CELLULAR_DATA_HANDLER, 1, 10, 200);
+    perfStats.RecordEvent(0, PerfComponent::CELLULAR_DATA_HANDLER, 1, 30, 2000000);
+    perfStats.RecordSetupLatency(0, 100);
+    perfStats.RecordSetupLatency(0, 300);
+    perfStats.IncreaseRetryCount(0);
+    perfStats.IncreaseStallRecoveryCount(0, RecoveryState::STATE_CLEANUP_CONNECTIONS);
+    perfStats.RecordEvent(-1, PerfComponent::CELLULAR_DATA_HANDLER, 1, 0, 0);
+    perfStats.RecordEvent(0, PerfComponent::PERF_COMPONENT_BUTT, 1, 0, 0);
+    CellularDataDumpHelper help;
+    std::vector<std::string> args = {"-perf_dump"};
+    std::string result = "";
+    ASSERT_TRUE(help.Dump(args, result));
+    ASSERT_FALSE(result.find("Slot0 performance statistics") == std::string::npos);
+    ASSERT_FALSE(result.find("event=1 count=2 avgCost=1000100 maxCost=2000000 avgQueueWait=20") ==
+        std::string::npos);
+    ASSERT_FALSE(result.find("hist=[0,1,0,0,0,0,0,0,0,1]") == std::string::npos);
+    ASSERT_FALSE(result.find("count=2 p50=100 p90=300 p99=300 max=300") == std::string::npos);
+    ASSERT_FALSE(result.find("RetryCount                 : 1") == std::string::npos);
+    ASSERT_FALSE(result.find("cleanupConnections=1") == std::string::npos);
+    ASSERT_TRUE(result.find("Ohos cellular data service") == std::string::npos);
+    perfStats.Reset(0);
+}
+
+HWTEST_F(CellularDataDumpHelperTest, CellularDataDumpHelper_06, Function | MediumTest | Level1)
+{
+    CellularDataSetupTracer &tracer = CellularDataSetupTracer::GetInstance();
+    tracer.Reset(0);
+    tracer.Mark(0, DATA_CONTEXT_ROLE_MMS_ID, SetupTraceStage::ESTABLISH_COMPLETE);
+    tracer.Mark(0, DATA_CONTEXT_ROLE_MMS_ID, SetupTraceStage::UPDATE_NETWORK_INFO);
+    for (int32_t stage = 0; stage < static_cast<int32_t>(SETUP_TRACE_STAGE_NUM); ++stage) {
+        tracer.Mark(0, DATA_CONTEXT_ROLE_DEFAULT_ID, static_cast<SetupTraceStage>(stage));
+    }
+    tracer.Mark(0, DATA_CONTEXT_ROLE_INTERNAL_DEFAULT_ID, SetupTraceStage::ATTEMPT_ESTABLISH);
+    tracer.Mark(0, DATA_CONTEXT_ROLE_INTERNAL_DEFAULT_ID, SetupTraceStage::UPDATE_NETWORK_INFO);
+    tracer.Mark(-1, DATA_CONTEXT_ROLE_DEFAULT_ID, SetupTraceStage::REQUEST_NET);
+    tracer.Mark(0, SETUP_TRACE_APN_ID_NUM, SetupTraceStage::REQUEST_NET);
+    CellularDataDumpHelper help;
+    std::vector<std::string> args = {"-perf_dump"};
+    std::string result = "";
+    ASSERT_TRUE(help.Dump(args, result));
+    ASSERT_FALSE(result.find("Slot0 data call setup trace(us), last 2 spans") == std::string::npos);
+    ASSERT_FALSE(result.find("  default total: count=1") == std::string::npos);
+    ASSERT_FALSE(result.find("RilActivateDone: count=1") == std::string::npos);
+    ASSERT_FALSE(result.find("internal_default total: count=1") == std::string::npos);
+    ASSERT_TRUE(result.find("mms total") == std::string::npos);
+    tracer.Reset(0);
+}
+
+HWTEST_F(CellularDataDumpHelperTest, CellularDataDumpHelper_07, Function | MediumTest | Level1)
+{
+    std::vector<int64_t> samples = { 100, 30, 90, 10, 70, 50, 20, 80, 40, 60 };
+    EXPECT_EQ(CellularDataPerfStats::GetPercentile(samples, 50), 50);
+    EXPECT_EQ(CellularDataPerfStats::GetPercentile(samples, 90), 90);
+    EXPECT_EQ(CellularDataPerfStats::GetPercentile(samples, 99), 100);
+    EXPECT_EQ(CellularDataSetupTracer::GetPercentile(samples, 50), 50);
+    EXPECT_EQ(CellularDataSetupTracer::GetPercentile(samples, 95), 100);
+    std::vector<int64_t> single = { 7 };
+    EXPECT_EQ(CellularDataPerfStats::GetPercentile(single, 50), 7);
+    EXPECT_EQ(CellularDataSetupTracer::GetPercentile(single, 99), 7);
+    std::vector<int64_t> empty;
+    EXPECT_EQ(CellularDataPerfStats::GetPercentile(empty, 50), 0);
+}
+
 }  // namespace Telephony
 }  // namespace OHOS
\ No newline at end of file
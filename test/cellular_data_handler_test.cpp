@@ -15,11 +15,17 @@
 #define private public
 #define protected public
 
+#include <chrono>
+#include <future>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "common_event_manager.h"
 #include "common_event_support.h"
 #include "cellular_data_handler.h"
 #include "cellular_data_controller.h"
+#include "cellular_data_io_worker.h"
+#include "pdp_profile_data.h"
 #ifdef BASE_POWER_IMPROVEMENT
 #include "cellular_data_power_save_mode_subscriber.h"
 #endif
@@ -352,13 +358,13 @@ HWTEST_F(CellularDataHandlerTest, ClearConnectionsOnUpdateApns_002, Function | M
     cellularDataHandler->ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_RETRY_CONNECTION);
     EXPECT_NE(cellularDataHandler->connectionManager_, nullptr);
     EXPECT_NE(cellularDataHandler->apnManager_, nullptr);
-    cellularDataHandler->apnManager_->allApnItem_.clear();
+    cellularDataHandler->apnManager_->UpdateApnCatalog({});
     cellularDataHandler->ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_RETRY_CONNECTION);
     EXPECT_NE(cellularDataHandler->apnManager_, nullptr);
     std::vector<sptr<ApnItem>> allApnItem;
     sptr<ApnItem> defaultApnItem = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
     allApnItem.push_back(defaultApnItem);
-    cellularDataHandler->apnManager_->allApnItem_ = allApnItem;
+    cellularDataHandler->apnManager_->UpdateApnCatalog(allApnItem);
     EXPECT_NE(cellularDataHandler->apnManager_->GetRilAttachApn(), nullptr);
     cellularDataHandler->ClearConnectionsOnUpdateApns(DisConnectionReason::REASON_RETRY_CONNECTION);
     EXPECT_NE(cellularDataHandler->apnManager_, nullptr);
@@ -576,7 +582,7 @@ HWTEST_F(CellularDataHandlerTest, SetRilAttachApnTest001, Function | MediumTest
     cellularDataHandler->Init();
     EXPECT_NE(cellularDataHandler->apnManager_, nullptr);
     sptr<ApnItem> attachApn = ApnItem::MakeDefaultApn(DATA_CONTEXT_ROLE_DEFAULT);
-    cellularDataHandler->apnManager_->allApnItem_.push_back(attachApn);
+    cellularDataHandler->apnManager_->UpdateApnCatalog({ attachApn });
     cellularDataHandler->SetRilAttachApn();
 }
 
@@ -853,7 +859,7 @@ HWTEST_F(CellularDataHandlerTest, DataConnCompleteUpdateStateTest001, Function |
     apnHolder->cellularDataStateMachine_->netLinkInfo_ = new NetLinkInfo();
     apnHolder->cellularDataStateMachine_->netSupplierInfo_ = nullptr;
     cellularDataHandler->apnManager_ = std::make_unique<ApnManager>().release();
-    cellularDataHandler->apnManager_->allApnItem_.clear();
+    cellularDataHandler->apnManager_->UpdateApnCatalog({});
     cellularDataHandler->connectionManager_ = std::make_shared<DataConnectionManager>(slotId);
     cellularDataHandler->physicalConnectionActiveState_ = false;
     cellularDataHandler->incallDataStateMachine_ =
@@ -863,7 +869,7 @@ HWTEST_F(CellularDataHandlerTest, DataConnCompleteUpdateStateTest001, Function |
     cellularDataHandler->DataConnCompleteUpdateState(apnHolder, resultInfo);
 
     cellularDataHandler->apnManager_->preferId_ = 1;
-    cellularDataHandler->apnManager_->allApnItem_.push_back(new ApnItem());
+    cellularDataHandler->apnManager_->UpdateApnCatalog({ new ApnItem() });
     cellularDataHandler->DataConnCompleteUpdateState(apnHolder, resultInfo);
     EXPECT_FALSE(cellularDataHandler->isRilApnAttached_);
 }
@@ -902,6 +908,117 @@ HWTEST_F(CellularDataHandlerTest, CreateApnItemTest002, Function | MediumTest |
     EXPECT_NE(cellularDataHandler->apnManager_, nullptr);
 }
 
+HWTEST_F(CellularDataHandlerTest, HandleApnLoadedTest001, Function | MediumTest | Level1)
+{
+    int32_t slotId = 0;
+    auto cellularDataHandler = std::make_shared<CellularDataHandler>(slotId);
+    cellularDataHandler->Init();
+    PdpProfile profile;
+    profile.profileId = 7;
+    profile.apn = "cmnet";
+    profile.apnTypes = "default";
+    auto result = std::make_shared<ApnLoadResult>();
+    result->loaded = true;
+    result->snapshot.preferId = profile.profileId;
+    result->snapshot.profiles.push_back(profile);
+
+    // A newer load has been requested meanwhile, the outdated result is dropped.
+    result->generation = cellularDataHandler->apnLoadGeneration_;
+    cellularDataHandler->apnLoadGeneration_++;
+    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_APN_LOADED, result);
+    cellularDataHandler->HandleApnLoaded(event);
+    EXPECT_EQ(cellularDataHandler->apnManager_->GetApnItemById(profile.profileId), nullptr);
+    EXPECT_EQ(cellularDataHandler->GetCurrentApnId(), 0);
+
+    result->generation = cellularDataHandler->apnLoadGeneration_;
+    result->apnIdGeneration = cellularDataHandler->currentApnIdGeneration_;
+    event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_APN_LOADED, result);
+    cellularDataHandler->HandleApnLoaded(event);
+    EXPECT_NE(cellularDataHandler->apnManager_->GetApnItemById(profile.profileId), nullptr);
+    EXPECT_EQ(cellularDataHandler->GetCurrentApnId(), profile.profileId);
+    EXPECT_EQ(cellularDataHandler->retryCreateApnTimes_, 0);
+}
+
+HWTEST_F(CellularDataHandlerTest, HandleApnLoadedTest002, Function | MediumTest | Level1)
+{
+    int32_t slotId = 0;
+    auto cellularDataHandler = std::make_shared<CellularDataHandler>(slotId);
+    cellularDataHandler->Init();
+    PdpProfile profile;
+    profile.profileId = 7;
+    profile.apn = "cmnet";
+    profile.apnTypes = "default";
+    auto result = std::make_shared<ApnLoadResult>();
+    result->loaded = true;
+    result->snapshot.preferId = profile.profileId;
+    result->snapshot.profiles.push_back(profile);
+    result->generation = cellularDataHandler->apnLoadGeneration_;
+    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_APN_LOADED, result);
+    cellularDataHandler->HandleApnLoaded(event);
+    ASSERT_NE(cellularDataHandler->apnManager_->GetApnItemById(profile.profileId), nullptr);
+
+    // The apns of a previous sim are parked until the next load.
+    cellularDataHandler->apnManager_->ClearApnItems();
+    EXPECT_EQ(cellularDataHandler->apnManager_->GetApnItemById(profile.profileId), nullptr);
+    EXPECT_TRUE(cellularDataHandler->apnManager_->FilterMatchedApns(DATA_CONTEXT_ROLE_DEFAULT, slotId).empty());
+    EXPECT_EQ(cellularDataHandler->apnManager_->preferId_, INVALID_PROFILE_ID);
+
+    // A failed load does not keep the prefer id of an earlier load.
+    cellularDataHandler->apnManager_->preferId_ = profile.profileId;
+    auto failedResult = std::make_shared<ApnLoadResult>();
+    failedResult->generation = cellularDataHandler->apnLoadGeneration_;
+    event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_APN_LOADED, failedResult);
+    cellularDataHandler->HandleApnLoaded(event);
+    EXPECT_EQ(cellularDataHandler->apnManager_->preferId_, INVALID_PROFILE_ID);
+}
+
+HWTEST_F(CellularDataHandlerTest, HandleCurrentApnIdLoadedTest001, Function | MediumTest | Level1)
+{
+    int32_t slotId = 0;
+    auto cellularDataHandler = std::make_shared<CellularDataHandler>(slotId);
+    auto result = std::make_shared<CurrentApnIdResult>();
+    result->apnId = 7;
+
+    // The prefer apn has been set meanwhile, the id read before is dropped.
+    result->apnIdGeneration = cellularDataHandler->currentApnIdGeneration_;
+    cellularDataHandler->currentApnIdGeneration_++;
+    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_CURRENT_APN_ID_LOADED, result);
+    cellularDataHandler->HandleCurrentApnIdLoaded(event);
+    EXPECT_EQ(cellularDataHandler->GetCurrentApnId(), 0);
+
+    result->apnIdGeneration = cellularDataHandler->currentApnIdGeneration_;
+    event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_CURRENT_APN_ID_LOADED, result);
+    cellularDataHandler->HandleCurrentApnIdLoaded(event);
+    EXPECT_EQ(cellularDataHandler->GetCurrentApnId(), result->apnId);
+}
+
+HWTEST_F(CellularDataHandlerTest, IoWorkerDumpTest001, Function | MediumTest | Level1)
+{
+    int32_t slotId = CELLDATA_SLOT_ID_3;
+    auto &worker = CellularDataIoWorker::GetInstance();
+    auto readStats = [&worker, slotId]() {
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        return worker.stats_[slotId];
+    };
+    IoWorkerStats before = readStats();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    ASSERT_TRUE(worker.PostTask(slotId, [released]() { released.wait(); }));
+    EXPECT_EQ(readStats().pendingCount, before.pendingCount + 1);
+
+    release.set_value();
+    for (int32_t i = 0; i < 100 && readStats().taskCount == before.taskCount; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    IoWorkerStats after = readStats();
+    EXPECT_EQ(after.taskCount, before.taskCount + 1);
+    EXPECT_EQ(after.pendingCount, before.pendingCount);
+    std::string result;
+    worker.Dump(result);
+    EXPECT_NE(result.find("Slot3 io worker: tasks="), std::string::npos);
+    EXPECT_NE(result.find(" pending="), std::string::npos);
+}
+
 /**
 @tc.number Telephony_IsCellularDataEnabled
 @tc.name IsCellularDataEnabled
@@ -949,10 +1066,15 @@ HWTEST_F(CellularDataHandlerTest, CheckApnActivate001, Function | MediumTest | L
     resultInfo4->flag = DATA_CONTEXT_ROLE_DEFAULT_ID;
     resultInfo4->reason = 2;
     cellularDataHandler->SetApnActivateEnd(resultInfo4);
-    cellularDataHandler->GetApnActReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID);
-    cellularDataHandler->GetApnActReportInfo(DATA_CONTEXT_ROLE_INTERNAL_DEFAULT_ID);
-    int32_t listLen = 4;
-    EXPECT_EQ(cellularDataHandler->apnActivateChrList_.size(), listLen);
+    ApnActivateReportInfo defaultInfo = cellularDataHandler->GetApnActReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID);
+    EXPECT_EQ(defaultInfo.actTimes, 2);
+    EXPECT_EQ(defaultInfo.actSuccTimes, 0);
+    EXPECT_EQ(defaultInfo.topReason, 2);
+    ApnActivateReportInfo internalInfo =
+        cellularDataHandler->GetApnActReportInfo(DATA_CONTEXT_ROLE_INTERNAL_DEFAULT_ID);
+    EXPECT_EQ(internalInfo.actTimes, 2);
+    EXPECT_EQ(internalInfo.actSuccTimes, 1);
+    EXPECT_EQ(internalInfo.topReason, 1);
 }
 
 /**
@@ -970,9 +1092,40 @@ HWTEST_F(CellularDataHandlerTest, CheckApnActivate002, Function | MediumTest | L
     info1.actSuccTime = 0;
     info1.apnId = 1;
     info1.duration = 0;
-    cellularDataHandler->apnActivateChrList_.push_back(info1);
-    cellularDataHandler->EraseApnActivateList();
-    EXPECT_EQ(cellularDataHandler->apnActivateChrList_.size(), 0);
+    cellularDataHandler->apnActivateStats_.Record(info1);
+    EXPECT_EQ(cellularDataHandler->GetApnActReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID).actTimes, 0);
+}
+
+/**
+@tc.number Telephony_CheckApnActivate003
+@tc.name CheckApnActivate003
+@tc.desc Function test
+*/
+HWTEST_F(CellularDataHandlerTest, CheckApnActivate003, Function | MediumTest | Level1)
+{
+    const uint32_t activateCount = 10000;
+    const uint32_t intervalMs = 10;
+    const uint32_t duration = 100;
+    const uint64_t beginMs = 1000000;
+    const uint32_t keepPeriodMs = 2 * activateCount * intervalMs;
+    ApnActivateStats stats;
+    stats.SetKeepPeriod(keepPeriodMs);
+    EXPECT_EQ(stats.GetKeepPeriod(), keepPeriodMs);
+    for (uint32_t i = 0; i < activateCount; ++i) {
+        uint64_t actTime = beginMs + i * intervalMs;
+        ApnActivateInfo info = { actTime, duration, i % 2, DATA_CONTEXT_ROLE_DEFAULT_ID };
+        stats.Record(info);
+        stats.GetReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID, static_cast<int64_t>(actTime));
+    }
+    int64_t nowMs = static_cast<int64_t>(beginMs + activateCount * intervalMs);
+    ApnActivateReportInfo info = stats.GetReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID, nowMs);
+    EXPECT_EQ(info.actTimes, activateCount);
+    EXPECT_EQ(info.actSuccTimes, activateCount / 2);
+    EXPECT_EQ(info.averDuration, duration * 2);
+    EXPECT_EQ(info.topReason, 1);
+    EXPECT_EQ(stats.GetReportInfo(DATA_CONTEXT_ROLE_INTERNAL_DEFAULT_ID, nowMs).actTimes, 0);
+    EXPECT_LT(stats.GetReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID, nowMs + keepPeriodMs / 2).actTimes, activateCount);
+    EXPECT_EQ(stats.GetReportInfo(DATA_CONTEXT_ROLE_DEFAULT_ID, nowMs + keepPeriodMs).actTimes, 0);
 }
 
 /**
@@ -1350,5 +1503,42 @@ HWTEST_F(CellularDataHandlerTest, IsBlockSetRilAttachApn_001, Function | MediumT
     EXPECT_FALSE(cellularDataHandler->IsBlockSetRilAttachApn());
 }
 
+HWTEST_F(CellularDataHandlerTest, FindEventFun_001, Function | MediumTest | Level3)
+{
+    EXPECT_EQ(CellularDataHandler::FindEventFun(CellularDataEventCode::MSG_REQUEST_NETWORK),
+        &CellularDataHandler::MsgRequestNetwork);
+    EXPECT_EQ(CellularDataHandler::FindEventFun(RadioEvent::RADIO_PS_CONNECTION_ATTACHED),
+        &CellularDataHandler::RadioPsConnectionAttached);
+    EXPECT_EQ(CellularDataHandler::FindEventFun(RadioEvent::RADIO_SIM_RECORDS_LOADED),
+        &CellularDataHandler::HandleSimEvent);
+    EXPECT_EQ(CellularDataHandler::FindEventFun(CellularDataEventCode::MSG_RETRY_TO_CREATE_APN),
+        CellularDataHandler::FindEventFun(CellularDataEventCode::MSG_APN_CHANGED));
+    EXPECT_EQ(CellularDataHandler::FindEventFun(CellularDataEventCode::MSG_MCC_CHANGE_ACTIVATE_DELAY),
+        &CellularDataHandler::HandleMccChangeDelay);
+    EXPECT_EQ(CellularDataHandler::FindEventFun(CellularDataEventCode::MSG_SM_CONNECT), nullptr);
+    EXPECT_EQ(CellularDataHandler::FindEventFun(UINT32_MAX), nullptr);
+}
+
+HWTEST_F(CellularDataHandlerTest, ProcessEvent_001, Function | MediumTest | Level3)
+{
+    auto cellularDataHandler = std::make_shared<CellularDataHandler>(0);
+    cellularDataHandler->apnManager_ = sptr<ApnManager>::MakeSptr();
+    cellularDataHandler->apnManager_->InitApnHolders();
+    std::unique_ptr<NetRequest> netRequest = std::make_unique<NetRequest>();
+    netRequest->capability = NetManagerStandard::NetCap::NET_CAPABILITY_INTERNET;
+    sptr<ApnHolder> apnHolder = cellularDataHandler->apnManager_->FindApnHolderById(DATA_CONTEXT_ROLE_DEFAULT_ID);
+    ASSERT_NE(apnHolder, nullptr);
+    apnHolder->dataCallEnabled_ = true;
+    AppExecFwk::InnerEvent::Pointer event =
+        AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_REQUEST_NETWORK, netRequest, TYPE_RELEASE_NET);
+    cellularDataHandler->ProcessEvent(event);
+    EXPECT_FALSE(apnHolder->dataCallEnabled_);
+    AppExecFwk::InnerEvent::Pointer unknownEvent = AppExecFwk::InnerEvent::Get(UINT32_MAX);
+    cellularDataHandler->ProcessEvent(unknownEvent);
+    AppExecFwk::InnerEvent::Pointer nullEvent(nullptr, nullptr);
+    cellularDataHandler->ProcessEvent(nullEvent);
+    EXPECT_FALSE(apnHolder->dataCallEnabled_);
+}
+
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
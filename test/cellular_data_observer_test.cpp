@@ -18,6 +18,8 @@
 
 #include <gtest/gtest.h>
 
+#include "mock/mock_data_share_result_set.h"
+#include "mock/mock_datashare_helper.h"
 #include "mock/mock_sim_manager.h"
 #include "core_manager_inner.h"
 #include "cellular_data_handler.h"
@@ -32,8 +34,11 @@ namespace OHOS {
 namespace Telephony {
 using namespace testing::ext;
 using ::testing::_;
+using ::testing::DoAll;
 using ::testing::Mock;
+using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::SetArgReferee;
 
 class CellularDataObserverTest : public testing::Test {
 public:
@@ -168,5 +173,109 @@ HWTEST_F(CellularDataObserverTest, CellularDataAirplaneObserver_05, Function | M
     settingHelper->NotifyChange(uri);
 }
 
+static void PutIncallValues(std::shared_ptr<CellularDataSettingsRdbHelper> &settingHelper, int32_t times,
+    bool reconnect)
+{
+    Uri uri(CELLULAR_DATA_SETTING_DATA_INCALL_URI);
+    for (int32_t i = 0; i < times; i++) {
+        if (reconnect) {
+            settingHelper->helperPool_->Clear();
+        }
+        EXPECT_EQ(settingHelper->PutValue(uri, CELLULAR_DATA_COLUMN_INCALL, i % 2), TELEPHONY_ERR_SUCCESS);
+    }
+}
+
+HWTEST_F(CellularDataObserverTest, CellularDataSettingsRdbHelper_HelperPool_06, Function | MediumTest | Level1)
+{
+    const int32_t times = 50;
+    std::shared_ptr<CellularDataSettingsRdbHelper> settingHelper = CellularDataSettingsRdbHelper::GetInstance();
+    ASSERT_NE(settingHelper, nullptr);
+    std::shared_ptr<DataShareHelperPool> savedPool = settingHelper->helperPool_;
+    // Each creation stands for a connect to the settings provider, the mock keeps the test off the live database.
+    int32_t creatorCalls = 0;
+    settingHelper->helperPool_ = std::make_shared<DataShareHelperPool>("HelperPoolTest",
+        [&creatorCalls](int waitTime) -> std::shared_ptr<DataShare::DataShareHelper> {
+            creatorCalls++;
+            auto helper = std::make_shared<NiceMock<DataShareHelperMock>>();
+            // A null query result is taken for a dead provider and discards the helper, answer with an empty set.
+            ON_CALL(*helper, Query(_, _, _, _))
+                .WillByDefault(Return(std::make_shared<NiceMock<DataShareResultSetMock>>()));
+            return helper;
+        });
+    PutIncallValues(settingHelper, times, true);
+    DataShareHelperPoolStats beginStats = settingHelper->helperPool_->GetStats();
+    PutIncallValues(settingHelper, times, false);
+    DataShareHelperPoolStats endStats = settingHelper->helperPool_->GetStats();
+    settingHelper->helperPool_ = savedPool;
+    EXPECT_EQ(beginStats.createCount, static_cast<uint64_t>(times));
+    EXPECT_EQ(beginStats.reuseCount, 0u);
+    // The helper created by the last reconnecting write stays pooled and serves all the following writes.
+    EXPECT_EQ(endStats.createCount, beginStats.createCount);
+    EXPECT_EQ(endStats.reuseCount - beginStats.reuseCount, static_cast<uint64_t>(times));
+    EXPECT_EQ(creatorCalls, times);
+}
+
+HWTEST_F(CellularDataObserverTest, CellularDataSettingsRdbHelper_PutValues_07, Function | MediumTest | Level1)
+{
+    std::shared_ptr<CellularDataSettingsRdbHelper> settingHelper = CellularDataSettingsRdbHelper::GetInstance();
+    ASSERT_NE(settingHelper, nullptr);
+    EXPECT_EQ(settingHelper->PutValues({}), TELEPHONY_ERR_SUCCESS);
+
+    Uri incallUri(CELLULAR_DATA_SETTING_DATA_INCALL_URI);
+    Uri airplaneUri(CELLULAR_DATA_AIRPLANE_MODE_URI);
+    int32_t savedIncall = 0;
+    int32_t savedAirplane = 0;
+    // The keys are real device settings, only touch them when they can be put back afterwards.
+    if (settingHelper->GetValue(incallUri, CELLULAR_DATA_COLUMN_INCALL, savedIncall) != TELEPHONY_ERR_SUCCESS ||
+        settingHelper->GetValue(airplaneUri, CELLULAR_DATA_COLUMN_AIRPLANE, savedAirplane) != TELEPHONY_ERR_SUCCESS) {
+        return;
+    }
+    // The incall key is listed twice, the last value wins.
+    std::vector<SettingsValueEntry> entries = {
+        { CELLULAR_DATA_SETTING_DATA_INCALL_URI, CELLULAR_DATA_COLUMN_INCALL, 0 },
+        { CELLULAR_DATA_AIRPLANE_MODE_URI, CELLULAR_DATA_COLUMN_AIRPLANE, 0 },
+        { CELLULAR_DATA_SETTING_DATA_INCALL_URI, CELLULAR_DATA_COLUMN_INCALL, 1 },
+    };
+    int32_t putRet = settingHelper->PutValues(entries);
+    int32_t incall = 0;
+    int32_t airplane = 1;
+    int32_t incallRet = settingHelper->GetValue(incallUri, CELLULAR_DATA_COLUMN_INCALL, incall);
+    int32_t airplaneRet = settingHelper->GetValue(airplaneUri, CELLULAR_DATA_COLUMN_AIRPLANE, airplane);
+    std::vector<SettingsValueEntry> savedEntries = {
+        { CELLULAR_DATA_SETTING_DATA_INCALL_URI, CELLULAR_DATA_COLUMN_INCALL, savedIncall },
+        { CELLULAR_DATA_AIRPLANE_MODE_URI, CELLULAR_DATA_COLUMN_AIRPLANE, savedAirplane },
+    };
+    EXPECT_EQ(settingHelper->PutValues(savedEntries), TELEPHONY_ERR_SUCCESS);
+    EXPECT_EQ(putRet, TELEPHONY_ERR_SUCCESS);
+    EXPECT_EQ(incallRet, TELEPHONY_ERR_SUCCESS);
+    EXPECT_EQ(airplaneRet, TELEPHONY_ERR_SUCCESS);
+    EXPECT_EQ(incall, 1);
+    EXPECT_EQ(airplane, 0);
+}
+
+HWTEST_F(CellularDataObserverTest, CellularDataSettingsRdbHelper_PutValues_08, Function | MediumTest | Level1)
+{
+    std::shared_ptr<CellularDataSettingsRdbHelper> settingHelper = CellularDataSettingsRdbHelper::GetInstance();
+    ASSERT_NE(settingHelper, nullptr);
+    std::shared_ptr<DataShareHelperPool> savedPool = settingHelper->helperPool_;
+    auto helper = std::make_shared<NiceMock<DataShareHelperMock>>();
+    auto resultSet = std::make_shared<NiceMock<DataShareResultSetMock>>();
+    ON_CALL(*resultSet, GetRowCount(_)).WillByDefault(DoAll(SetArgReferee<0>(0), Return(0)));
+    EXPECT_CALL(*helper, Query(_, _, _, _)).WillOnce(Return(resultSet));
+    // Without batch support the keys go one by one, the first is written and the second fails.
+    EXPECT_CALL(*helper, ExecuteBatch(_, _)).WillOnce(Return(-1));
+    EXPECT_CALL(*helper, Insert(_, _)).WillOnce(Return(1)).WillOnce(Return(-1));
+    EXPECT_CALL(*helper, NotifyChange(_)).Times(1);
+    settingHelper->helperPool_ = std::make_shared<DataShareHelperPool>("PutValuesTest",
+        [helper](int waitTime) -> std::shared_ptr<DataShare::DataShareHelper> { return helper; });
+    std::vector<SettingsValueEntry> entries = {
+        { CELLULAR_DATA_SETTING_DATA_INCALL_URI, CELLULAR_DATA_COLUMN_INCALL, 1 },
+        { CELLULAR_DATA_AIRPLANE_MODE_URI, CELLULAR_DATA_COLUMN_AIRPLANE, 0 },
+    };
+    int32_t putRet = settingHelper->PutValues(entries);
+    settingHelper->helperPool_ = savedPool;
+    EXPECT_EQ(putRet, TELEPHONY_ERR_DATABASE_WRITE_FAIL);
+}
+
 }  // namespace Telephony
 }  // namespace OHOS
\ No newline at end of file
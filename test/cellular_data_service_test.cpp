@@ -15,15 +15,21 @@
 #define private public
 #define protected public
 
+#include <chrono>
+#include <functional>
 #include <gmock/gmock.h>
+#include <thread>
 
 #include "cellular_data_error.h"
 #include "cellular_data_service.h"
+#include "cellular_data_startup.h"
 #include "core_manager_inner.h"
 #include "data_access_token.h"
 #include "data_connection_monitor.h"
+#include "data_flow_type_filter.h"
 #include "gtest/gtest.h"
 #include "tel_ril_network_parcel.h"
+#include "state_notification.h"
 #include "traffic_management.h"
 #include "apn_attribute.h"
 #include "mock/mock_network_search.h"
@@ -36,6 +42,8 @@ using namespace testing;
 using namespace testing::ext;
 
 static const int32_t SLEEP_TIME = 3;
+static const int32_t WAIT_RETRY = 100;
+static const int32_t WAIT_STEP_MS = 10;
 
 class CellularDataServiceTest : public testing::Test {
 public:
@@ -49,6 +57,15 @@ public:
     static void TearDownTestCase();
     void SetUp();
     void TearDown();
+
+    static bool WaitUntil(const std::function<bool()> &done)
+    {
+        for (int32_t i = 0; i < WAIT_RETRY && !done(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP_MS));
+        }
+        return done();
+    }
+
     std::shared_ptr<CellularDataService> service = DelayedSingleton<CellularDataService>::GetInstance();
     MockNetworkSearchManager *mockNetworkSearchManager;
 };
@@ -258,9 +275,9 @@ HWTEST_F(CellularDataServiceTest, DataConnectionMonitor_HandleRecovery_002, Test
 HWTEST_F(CellularDataServiceTest, DataConnectionMonitor_EndNetStatistics_001, TestSize.Level0)
 {
     std::shared_ptr<DataConnectionMonitor> dataConnectionMonitor = std::make_shared<DataConnectionMonitor>(0);
-    dataConnectionMonitor->dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_DOWN;
+    dataConnectionMonitor->dataFlowTypeFilter_.Force(CellDataFlowType::DATA_FLOW_TYPE_DOWN, 0);
     dataConnectionMonitor->EndNetStatistics();
-    ASSERT_EQ(dataConnectionMonitor->dataFlowType_, CellDataFlowType::DATA_FLOW_TYPE_NONE);
+    ASSERT_EQ(dataConnectionMonitor->GetDataFlowType(), CellDataFlowType::DATA_FLOW_TYPE_NONE);
 }
 
 /**
@@ -276,7 +293,7 @@ HWTEST_F(CellularDataServiceTest, DataConnectionMonitor_UpdateNetTrafficState_00
     std::shared_ptr<PreferredNetworkTypeInfo> preferredTypeInfo = std::make_shared<PreferredNetworkTypeInfo>();
     auto event = AppExecFwk::InnerEvent::Get(0, preferredTypeInfo);
     dataConnectionMonitor->SetPreferredNetworkPara(event);
-    ASSERT_EQ(dataConnectionMonitor->dataFlowType_, CellDataFlowType::DATA_FLOW_TYPE_NONE);
+    ASSERT_EQ(dataConnectionMonitor->GetDataFlowType(), CellDataFlowType::DATA_FLOW_TYPE_NONE);
 }
 
 /**
@@ -287,11 +304,14 @@ HWTEST_F(CellularDataServiceTest, DataConnectionMonitor_UpdateNetTrafficState_00
 HWTEST_F(CellularDataServiceTest, DataConnectionMonitor_UpdateDataFlowType_001, TestSize.Level0)
 {
     std::shared_ptr<DataConnectionMonitor> dataConnectionMonitor = std::make_shared<DataConnectionMonitor>(0);
-    dataConnectionMonitor->dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_DOWN;
+    dataConnectionMonitor->dataFlowTypeFilter_.Force(CellDataFlowType::DATA_FLOW_TYPE_DOWN, 0);
     dataConnectionMonitor->trafficManager_->sendPackets_ = 200;
     dataConnectionMonitor->trafficManager_->recvPackets_ = 100;
     dataConnectionMonitor->UpdateDataFlowType();
-    ASSERT_EQ(static_cast<int32_t>(dataConnectionMonitor->dataFlowType_),
+    ASSERT_EQ(static_cast<int32_t>(dataConnectionMonitor->GetDataFlowType()),
+        static_cast<int32_t>(CellDataFlowType::DATA_FLOW_TYPE_DOWN));
+    dataConnectionMonitor->UpdateDataFlowType();
+    ASSERT_EQ(static_cast<int32_t>(dataConnectionMonitor->GetDataFlowType()),
         static_cast<int32_t>(CellDataFlowType::DATA_FLOW_TYPE_NONE));
 }
 
@@ -317,9 +337,9 @@ HWTEST_F(CellularDataServiceTest, DataConnectionMonitor_SetDataFlowType_001, Tes
     dataConnectionMonitor->ProcessEvent(event);
     event = AppExecFwk::InnerEvent::Get(RadioEvent::RADIO_ON);
     dataConnectionMonitor->ProcessEvent(event);
-    dataConnectionMonitor->dataFlowType_ = CellDataFlowType::DATA_FLOW_TYPE_NONE;
+    dataConnectionMonitor->dataFlowTypeFilter_.Force(CellDataFlowType::DATA_FLOW_TYPE_NONE, 0);
     dataConnectionMonitor->SetDataFlowType(CellDataFlowType::DATA_FLOW_TYPE_DOWN);
-    ASSERT_EQ(static_cast<int32_t>(dataConnectionMonitor->dataFlowType_),
+    ASSERT_EQ(static_cast<int32_t>(dataConnectionMonitor->GetDataFlowType()),
         static_cast<int32_t>(CellDataFlowType::DATA_FLOW_TYPE_DOWN));
 }
 
@@ -478,6 +498,19 @@ HWTEST_F(CellularDataServiceTest, GetActiveApnName002, TestSize.Level0)
     EXPECT_EQ(service->GetActiveApnName(apnName), 0);
 }
 
+/**
+ * @tc.number   GetConnectionTrafficInfo001
+ * @tc.name     test GetConnectionTrafficInfo
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataServiceTest, GetConnectionTrafficInfo001, TestSize.Level0)
+{
+    std::vector<ConnectionTrafficInfo> infoList;
+    EXPECT_EQ(service->GetConnectionTrafficInfo(DEFAULT_SIM_SLOT_ID, infoList), TELEPHONY_ERR_PERMISSION_ERR);
+    DataAccessToken token;
+    EXPECT_EQ(service->GetConnectionTrafficInfo(INVALID_SLOT_ID, infoList), CELLULAR_DATA_INVALID_PARAM);
+}
+
 /**
  * @tc.number   ReleaseNet_001
  * @tc.name     test function branch
@@ -647,5 +680,139 @@ HWTEST_F(CellularDataServiceTest, SetDefaultCellularDataSlotId_SendSlotChangeInf
     TELEPHONY_EXT_WRAPPER.sendCellularDataSlotChangeInfo_ = nullptr;
     EXPECT_TRUE(g_callbackInvoked);
 }
+
+/**
+ * @tc.number   CellularDataService_RegisterControllers_001
+ * @tc.name     test every slot records its register begin time and joins before returning
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataServiceTest, CellularDataService_RegisterControllers_001, TestSize.Level1)
+{
+    service->InitModule();
+    service->slotInitTime_.clear();
+    service->RegisterControllers();
+    std::string phaseTime = service->GetInitPhaseTime();
+    bool coreInited = CoreManagerInner::GetInstance().IsInitFinished();
+    for (const auto &[slotId, controller] : service->cellularDataControllers_) {
+        ASSERT_NE(controller, nullptr);
+        EXPECT_NE(service->GetBeginTime(slotId), "0");
+        EXPECT_NE(phaseTime.find("slot" + std::to_string(slotId) + "="), std::string::npos);
+        if (coreInited) {
+            EXPECT_NE(service->GetEndTime(slotId), "0");
+            EXPECT_GE(service->GetSpendTime(slotId), 0);
+        }
+    }
+    EXPECT_EQ(service->GetSpendTime(-1), -1);
+}
+
+/**
+ * @tc.number   CellularDataService_RegisterControllers_002
+ * @tc.name     test the registered callback records the slot end time once
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataServiceTest, CellularDataService_RegisterControllers_002, TestSize.Level1)
+{
+    std::shared_ptr<CellularDataController> controller = std::make_shared<CellularDataController>(0);
+    int32_t callCount = 0;
+    int32_t notifiedSlot = -1;
+    controller->SetRegisteredCallback([&callCount, &notifiedSlot](int32_t slotId) {
+        callCount++;
+        notifiedSlot = slotId;
+    });
+    controller->NotifyRegistered();
+    controller->NotifyRegistered();
+    EXPECT_EQ(callCount, 1);
+    EXPECT_EQ(notifiedSlot, 0);
+}
+
+/**
+ * @tc.number   CellularDataStartup_DeferredPhase_001
+ * @tc.name     test deferred startup phases wait for the release
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataServiceTest, CellularDataStartup_DeferredPhase_001, TestSize.Level1)
+{
+    CellularDataStartup &startup = CellularDataStartup::GetInstance();
+    startup.Begin();
+    std::atomic<int32_t> runCount = 0;
+    startup.RunCriticalPhase("critical", []() {});
+    startup.AddDeferredPhase("deferred", [&runCount]() { runCount++; });
+    // Nothing is posted before the release, the phase only waits in the queue.
+    EXPECT_EQ(startup.pendingPhases_.size(), 1u);
+    EXPECT_EQ(runCount, 0);
+    startup.OnDefaultApnConnected();
+    EXPECT_TRUE(startup.pendingPhases_.empty());
+    startup.AddDeferredPhase("late", [&runCount]() { runCount++; });
+    std::string result;
+    // The phase is recorded after it has run, wait for the record rather than for the counter alone.
+    EXPECT_TRUE(WaitUntil([&startup, &runCount, &result]() {
+        result.clear();
+        startup.Dump(result);
+        return runCount == 2 && result.find("deferred late") != std::string::npos;
+    }));
+    EXPECT_EQ(runCount, 2);
+    EXPECT_NE(startup.GetCriticalPhaseTime().find("critical="), std::string::npos);
+    EXPECT_NE(result.find("default apn connected"), std::string::npos);
+
+    // A new startup drops the phases a previous one left queued.
+    startup.Begin();
+    startup.AddDeferredPhase("stale", [&runCount]() { runCount++; });
+    startup.Begin();
+    EXPECT_TRUE(startup.pendingPhases_.empty());
+    EXPECT_EQ(runCount, 2);
+}
+
+/**
+ * @tc.number   DataFlowTypeFilter_001
+ * @tc.name     test flow type hysteresis and dwell time
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataServiceTest, DataFlowTypeFilter_001, TestSize.Level0)
+{
+    EXPECT_EQ(DataFlowTypeFilter::Classify(1, 0), CellDataFlowType::DATA_FLOW_TYPE_UP);
+    EXPECT_EQ(DataFlowTypeFilter::Classify(0, 1), CellDataFlowType::DATA_FLOW_TYPE_DOWN);
+    EXPECT_EQ(DataFlowTypeFilter::Classify(1, 1), CellDataFlowType::DATA_FLOW_TYPE_UP_DOWN);
+    EXPECT_EQ(DataFlowTypeFilter::Classify(0, 0), CellDataFlowType::DATA_FLOW_TYPE_NONE);
+    DataFlowTypeConfig config;
+    config.hysteresisSamples = 2;
+    config.minDwellMs = 3000;
+    DataFlowTypeFilter filter(config);
+    EXPECT_FALSE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_UP, 10000));
+    EXPECT_FALSE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_NONE, 11000));
+    EXPECT_FALSE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_UP, 12000));
+    EXPECT_TRUE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_UP, 13000));
+    EXPECT_EQ(filter.GetFlowType(), CellDataFlowType::DATA_FLOW_TYPE_UP);
+    EXPECT_FALSE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_DOWN, 14000));
+    EXPECT_FALSE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_DOWN, 15000));
+    EXPECT_TRUE(filter.Update(CellDataFlowType::DATA_FLOW_TYPE_DOWN, 16000));
+    EXPECT_TRUE(filter.Force(CellDataFlowType::DATA_FLOW_TYPE_NONE, 16500));
+    EXPECT_FALSE(filter.Force(CellDataFlowType::DATA_FLOW_TYPE_NONE, 17000));
+}
+
+/**
+ * @tc.number   StateNotification_Coalesce_001
+ * @tc.name     test transient and duplicate states are not published
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataServiceTest, StateNotification_Coalesce_001, TestSize.Level0)
+{
+    StateNotification &notification = StateNotification::GetInstance();
+    int32_t networkType = static_cast<int32_t>(RadioTech::RADIO_TECHNOLOGY_LTE);
+    notification.SetDebounceWindow(60 * 1000);
+    StateNotificationStats before = notification.GetStats();
+    notification.UpdateCellularDataConnectState(DEFAULT_SIM_SLOT_ID, PROFILE_STATE_CONNECTING, networkType);
+    notification.UpdateCellularDataConnectState(DEFAULT_SIM_SLOT_ID, PROFILE_STATE_CONNECTED, networkType);
+    notification.Flush();
+    notification.UpdateCellularDataConnectState(DEFAULT_SIM_SLOT_ID, PROFILE_STATE_CONNECTED, networkType);
+    StateNotificationStats after = notification.GetStats();
+    EXPECT_GE(after.suppressedCount - before.suppressedCount, 2u);
+    EXPECT_GE(after.publishedCount - before.publishedCount, 1u);
+    EXPECT_EQ(notification.slots_[DEFAULT_SIM_SLOT_ID].connectState,
+        static_cast<int32_t>(DataConnectState::DATA_STATE_CONNECTED));
+    notification.SetDebounceWindow(STATE_NOTIFICATION_DEBOUNCE_MS);
+    std::string result;
+    notification.Dump(result);
+    EXPECT_NE(result.find("suppressed="), std::string::npos);
+}
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define private public
+#define protected public
+
+#include "cellular_data_state_machine.h"
+#include "cellular_data_state_machine_pool.h"
+#include "data_connection_manager.h"
+#include "gtest/gtest.h"
+#include "tel_event_handler.h"
+
+namespace OHOS {
+namespace Telephony {
+using namespace testing::ext;
+
+static constexpr int32_t POOL_CYCLE_COUNT = 100;
+
+class StateMachinePoolTestHandler : public TelEventHandler {
+public:
+    StateMachinePoolTestHandler() : TelEventHandler("StateMachinePoolTestHandler") {}
+    ~StateMachinePoolTestHandler() = default;
+};
+
+class CellularDataStateMachinePoolTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        handler_ = std::make_shared<StateMachinePoolTestHandler>();
+        connectionManager_ = std::make_shared<DataConnectionManager>(0);
+    }
+
+    std::shared_ptr<CellularDataStateMachinePool> CreatePool(size_t warmCount, size_t maxIdleCount)
+    {
+        return std::make_shared<CellularDataStateMachinePool>(0, [this]() {
+            return std::make_shared<CellularDataStateMachine>(
+                connectionManager_, std::static_pointer_cast<TelEventHandler>(handler_));
+        }, warmCount, maxIdleCount);
+    }
+
+    static bool AlwaysIdle(const std::shared_ptr<CellularDataStateMachine> &stateMachine)
+    {
+        return true;
+    }
+
+    std::shared_ptr<StateMachinePoolTestHandler> handler_;
+    std::shared_ptr<DataConnectionManager> connectionManager_;
+};
+
+/**
+ * @tc.number   StateMachinePool_001
+ * @tc.name     test setups are served from the pre-warmed pool without creating machines
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataStateMachinePoolTest, StateMachinePool_001, Function | MediumTest | Level1)
+{
+    auto pool = CreatePool(STATE_MACHINE_POOL_WARM_COUNT, STATE_MACHINE_POOL_MAX_IDLE_COUNT);
+    EXPECT_TRUE(pool->NeedPreWarm());
+    EXPECT_EQ(pool->PreWarm(), STATE_MACHINE_POOL_WARM_COUNT);
+    EXPECT_FALSE(pool->NeedPreWarm());
+    for (int32_t i = 0; i < POOL_CYCLE_COUNT; i++) {
+        auto stateMachine = pool->Acquire(AlwaysIdle);
+        ASSERT_NE(stateMachine, nullptr);
+        EXPECT_TRUE(pool->Release(stateMachine));
+    }
+    StateMachinePoolStats stats = pool->GetStats();
+    EXPECT_EQ(stats.acquireCount, POOL_CYCLE_COUNT);
+    EXPECT_EQ(stats.hitCount, POOL_CYCLE_COUNT);
+    EXPECT_EQ(stats.createCount, STATE_MACHINE_POOL_WARM_COUNT);
+    EXPECT_EQ(pool->GetIdleCount(), STATE_MACHINE_POOL_WARM_COUNT);
+}
+
+/**
+ * @tc.number   StateMachinePool_002
+ * @tc.name     test busy machines are skipped and a full pool retires released machines
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularDataStateMachinePoolTest, StateMachinePool_002, Function | MediumTest | Level1)
+{
+    const size_t maxIdleCount = 2;
+    auto pool = CreatePool(1, maxIdleCount);
+    pool->PreWarm();
+    auto busy = pool->Acquire([](const std::shared_ptr<CellularDataStateMachine> &stateMachine) { return false; });
+    EXPECT_EQ(busy, nullptr);
+    EXPECT_EQ(pool->GetIdleCount(), 0);
+
+    auto first = pool->Create();
+    auto second = pool->Create();
+    auto third = pool->Create();
+    EXPECT_TRUE(pool->Release(first));
+    EXPECT_TRUE(pool->Release(first));
+    EXPECT_TRUE(pool->Release(second));
+    EXPECT_FALSE(pool->Release(third));
+    EXPECT_EQ(pool->GetIdleCount(), maxIdleCount);
+    StateMachinePoolStats stats = pool->GetStats();
+    EXPECT_EQ(stats.retireCount, 1);
+    EXPECT_EQ(stats.hitCount, 0);
+    EXPECT_EQ(pool->Acquire(AlwaysIdle), second);
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -2119,5 +2119,28 @@ HWTEST_F(CellularDataTest, InitSendCellularDataSlotChangeInfo_WhenSymbolFound, F
     delete mockDlsym;
     mockDlsym = nullptr;
 }
+
+/**
+ * @tc.number   InitSendCellularDataSlotChangeInfo_ResolveOnFirstUse
+ * @tc.name     Ext wrapper symbols are looked up on first use only.
+ * @tc.desc     Function test - verify the lookup is deferred and a missing symbol is cached
+ */
+HWTEST_F(CellularDataTest, InitSendCellularDataSlotChangeInfo_ResolveOnFirstUse, Function | MediumTest | Level1)
+{
+    mockDlsym = new NiceMock<MockDlsym>();
+    EXPECT_CALL(*mockDlsym, dlsym(_, StrEq("SendCellularDataSlotChangeInfo"))).Times(0);
+    TELEPHONY_EXT_WRAPPER.InitSendCellularDataSlotChangeInfo();
+    Mock::VerifyAndClearExpectations(mockDlsym);
+    EXPECT_CALL(*mockDlsym, dlsym(_, StrEq("SendCellularDataSlotChangeInfo"))).Times(1).WillOnce(Return(nullptr));
+    uint32_t missingCount = TELEPHONY_EXT_WRAPPER.symbolStats_.GetMissingCount();
+    ASSERT_EQ(TELEPHONY_EXT_WRAPPER.sendCellularDataSlotChangeInfo_, nullptr);
+    ASSERT_EQ(TELEPHONY_EXT_WRAPPER.sendCellularDataSlotChangeInfo_, nullptr);
+    EXPECT_EQ(TELEPHONY_EXT_WRAPPER.symbolStats_.GetMissingCount(), missingCount + 1);
+    std::string result;
+    TELEPHONY_EXT_WRAPPER.DumpSymbolStats(result);
+    EXPECT_NE(result.find("TelephonyExtWrapper symbols"), std::string::npos);
+    delete mockDlsym;
+    mockDlsym = nullptr;
+}
 } // namespace Telephony
 } // namespace OHOS
@@ -45,6 +45,9 @@ using ::testing::Mock;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 
+// Owned by no state, so StateProcess finds no handler for it.
+static constexpr uint32_t UNHANDLED_STATE_EVENT = CellularDataEventCode::BASE + 0xFFFF;
+
 class CellularStateMachineTest : public testing::Test {
 public:
     CellularStateMachineTest()
@@ -132,6 +135,66 @@ std::shared_ptr<CellularDataStateMachine> CellularMachineTest::CreateCellularDat
     return cellularDataStateMachine_;
 }
 
+class TransitionRecordState : public State {
+public:
+    TransitionRecordState(std::string &&name, std::vector<std::string> &records)
+        : State(std::move(name)), records_(records)
+    {}
+    void StateBegin() override
+    {
+        isActive_ = true;
+        records_.push_back("Begin " + name_);
+    }
+    void StateEnd() override
+    {
+        isActive_ = false;
+        records_.push_back("End " + name_);
+    }
+    bool StateProcess(const AppExecFwk::InnerEvent::Pointer &event) override
+    {
+        return NOT_PROCESSED;
+    }
+
+private:
+    std::vector<std::string> &records_;
+};
+
+class DeferReplayState : public State {
+public:
+    DeferReplayState(std::string &&name, std::vector<std::string> &records) : State(std::move(name)), records_(records)
+    {}
+    void StateBegin() override
+    {
+        isActive_ = true;
+    }
+    void StateEnd() override
+    {
+        isActive_ = false;
+    }
+    bool StateProcess(const AppExecFwk::InnerEvent::Pointer &event) override
+    {
+        uint32_t eventId = event->GetInnerEventId();
+        if (eventId == deferEventId_) {
+            handler_->DeferEvent(std::move(const_cast<AppExecFwk::InnerEvent::Pointer &>(event)));
+            return PROCESSED;
+        }
+        if (eventId == transitionEventId_) {
+            handler_->TransitionTo(nextState_);
+            return PROCESSED;
+        }
+        records_.push_back(name_ + " " + std::to_string(eventId));
+        return PROCESSED;
+    }
+
+    std::shared_ptr<StateMachineEventHandler> handler_;
+    std::shared_ptr<State> nextState_;
+    uint32_t deferEventId_ = 0;
+    uint32_t transitionEventId_ = 0;
+
+private:
+    std::vector<std::string> &records_;
+};
+
 /**
  * @tc.number   HasAnyConnectedState_001
  * @tc.name     test function branch
@@ -250,8 +313,7 @@ HWTEST_F(CellularStateMachineTest, IdleState_StateProcess_002, Function | Medium
     incallStateMachine->TransitionTo(incallStateMachine->idleState_);
     auto idleState = std::static_pointer_cast<IdleState>(incallStateMachine->idleState_);
     idleState->stateMachine_ = incallStateMachine;
-    idleState->eventIdFunMap_.clear();
-    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_INCALL_DATA_CALL_STARTED);
+    auto event = AppExecFwk::InnerEvent::Get(UNHANDLED_STATE_EVENT);
     idleState->StateProcess(event);
     ASSERT_EQ(idleState->isActive_, NOT_PROCESSED);
 }
@@ -502,12 +564,11 @@ HWTEST_F(CellularStateMachineTest, SecondaryActiveStateProcess_003, Function | M
     if (incallStateMachineTest->Init(TelCallStatus::CALL_STATUS_DIALING, 0) < 0) {
         incallStateMachine = nullptr;
     }
-    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_INCALL_DATA_DATA_CONNECTED);
+    auto event = AppExecFwk::InnerEvent::Get(UNHANDLED_STATE_EVENT);
     incallStateMachine->TransitionTo(incallStateMachine->secondaryActiveState_);
     auto secondaryActiveState =
         std::static_pointer_cast<SecondaryActiveState>(incallStateMachine->secondaryActiveState_);
     secondaryActiveState->stateMachine_ = incallStateMachine;
-    secondaryActiveState->eventIdFunMap_.clear();
     bool result = secondaryActiveState->StateProcess(event);
     EXPECT_EQ(result, NOT_PROCESSED);
 }
@@ -678,8 +739,7 @@ HWTEST_F(CellularStateMachineTest, DefaultStateProcess_001, Function | MediumTes
     }
     auto mDefault = std::static_pointer_cast<Default>(cellularMachine->defaultState_);
     mDefault->stateMachine_ = cellularMachine;
-    mDefault->eventIdFunMap_.clear();
-    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
+    auto event = AppExecFwk::InnerEvent::Get(UNHANDLED_STATE_EVENT);
     bool result = mDefault->StateProcess(event);
     EXPECT_EQ(result, false);
 }
@@ -699,8 +759,7 @@ HWTEST_F(CellularStateMachineTest, DefaultStateProcess_002, Function | MediumTes
     auto mDefault = std::static_pointer_cast<Default>(cellularMachine->defaultState_);
     cellularMachine = nullptr;
     mDefault->stateMachine_ = cellularMachine;
-    mDefault->eventIdFunMap_.clear();
-    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
+    auto event = AppExecFwk::InnerEvent::Get(UNHANDLED_STATE_EVENT);
     bool result = mDefault->StateProcess(event);
     EXPECT_EQ(result, false);
 }
@@ -719,7 +778,6 @@ HWTEST_F(CellularStateMachineTest, DefaultProcessDisconnectDone_001, Function |
     }
     auto mDefault = std::static_pointer_cast<Default>(cellularMachine->defaultState_);
     mDefault->stateMachine_ = cellularMachine;
-    mDefault->eventIdFunMap_.clear();
     auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
     bool result = mDefault->ProcessDisconnectDone(event);
     EXPECT_EQ(result, true);
@@ -740,7 +798,6 @@ HWTEST_F(CellularStateMachineTest, DefaultProcessDisconnectDone_002, Function |
     auto mDefault = std::static_pointer_cast<Default>(cellularMachine->defaultState_);
     cellularMachine = nullptr;
     mDefault->stateMachine_ = cellularMachine;
-    mDefault->eventIdFunMap_.clear();
     auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
     bool result = mDefault->ProcessDisconnectDone(event);
     EXPECT_EQ(result, false);
@@ -2309,8 +2366,44 @@ HWTEST_F(CellularStateMachineTest, FillRSDFromNetCap_001, Function | MediumTest
     }
     EXPECT_NE(cellularMachine, nullptr);
     std::map<std::string, std::string> networkSliceParas;
+    DataProfile dataProfile;
+    cellularMachine->FillRSDFromNetCap(networkSliceParas, dataProfile);
+    networkSliceParas["sscmode"] = "1";
+    networkSliceParas["snssai"] = "01-000001";
+    networkSliceParas["dnn"] = "slice.dnn";
+    networkSliceParas["pdusessiontype"] = "IPV4V6";
     sptr<ApnItem> apn = new ApnItem();
-    cellularMachine->FillRSDFromNetCap(networkSliceParas, apn);
+    apn->attr_.apn_ = "cmnet";
+    dataProfile.apn = apn->attr_.apn_;
+    cellularMachine->FillRSDFromNetCap(networkSliceParas, dataProfile);
+    EXPECT_EQ(dataProfile.sscMode, 1);
+    EXPECT_EQ(dataProfile.snssai, "01-000001");
+    EXPECT_EQ(dataProfile.apn, "slice.dnn");
+    EXPECT_EQ(dataProfile.protocol, "IPV4V6");
+    EXPECT_EQ(std::string(apn->attr_.apn_.c_str()), "cmnet");
+}
+
+/**
+ * @tc.number   GetTrafficSnapshot_001
+ * @tc.name     test the traffic snapshot follows the state, cid and capability
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularStateMachineTest, GetTrafficSnapshot_001, Function | MediumTest | Level1)
+{
+    std::shared_ptr<CellularMachineTest> machine = std::make_shared<CellularMachineTest>();
+    std::shared_ptr<CellularDataStateMachine> stateMachine = machine->CreateCellularDataConnect(0);
+    ASSERT_NE(stateMachine, nullptr);
+    stateMachine->Init();
+    stateMachine->SetCid(3);
+    stateMachine->SetCapability(NetManagerStandard::NetCap::NET_CAPABILITY_MMS);
+    stateMachine->ifName_ = "rmnet0";
+    CellularDataStateMachine::TrafficSnapshot snapshot = stateMachine->GetTrafficSnapshot();
+    EXPECT_FALSE(snapshot.isActive);
+    EXPECT_EQ(snapshot.ifName, "rmnet0");
+    EXPECT_EQ(snapshot.cid, 3);
+    EXPECT_EQ(snapshot.capability, NetManagerStandard::NetCap::NET_CAPABILITY_MMS);
+    stateMachine->SetCurrentState(stateMachine->activeState_);
+    EXPECT_TRUE(stateMachine->GetTrafficSnapshot().isActive);
 }
 
 /**
@@ -2401,5 +2494,118 @@ HWTEST_F(CellularStateMachineTest, DoConnect_001, Function | MediumTest | Level0
     cellularMachine->DoConnect(*dataConnectionParams);
     EXPECT_NE(cellularMachine->netInterfaceCallback_, nullptr);
 }
+
+/**
+ * @tc.number   ProcessTransitions_001
+ * @tc.name     test transitions only leave and enter the states below the common ancestor
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularStateMachineTest, ProcessTransitions_001, Function | MediumTest | Level1)
+{
+    std::vector<std::string> records;
+    std::shared_ptr<State> root = std::make_shared<TransitionRecordState>("Root", records);
+    std::shared_ptr<State> middle = std::make_shared<TransitionRecordState>("Middle", records);
+    std::shared_ptr<State> leafA = std::make_shared<TransitionRecordState>("LeafA", records);
+    std::shared_ptr<State> leafB = std::make_shared<TransitionRecordState>("LeafB", records);
+    std::shared_ptr<State> other = std::make_shared<TransitionRecordState>("Other", records);
+    middle->SetParentState(root);
+    leafA->SetParentState(middle);
+    leafB->SetParentState(middle);
+    other->SetParentState(root);
+    auto handler = std::make_shared<StateMachineEventHandler>("ProcessTransitions_001");
+    handler->SetOriginalState(leafA);
+    auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_STATE_MACHINE_INIT);
+    handler->ProcessEvent(event);
+    EXPECT_EQ(records, std::vector<std::string>({ "Begin Root", "Begin Middle", "Begin LeafA" }));
+
+    records.clear();
+    handler->TransitionTo(leafB);
+    handler->ProcessTransitions(event);
+    EXPECT_EQ(records, std::vector<std::string>({ "End LeafA", "Begin LeafB" }));
+
+    records.clear();
+    handler->TransitionTo(other);
+    handler->ProcessTransitions(event);
+    EXPECT_EQ(records, std::vector<std::string>({ "End LeafB", "End Middle", "Begin Other" }));
+
+    records.clear();
+    handler->TransitionTo(leafA);
+    handler->ProcessTransitions(event);
+    EXPECT_EQ(records, std::vector<std::string>({ "End Other", "Begin Middle", "Begin LeafA" }));
+    EXPECT_TRUE(root->isActive_);
+}
+
+/**
+ * @tc.number   DeferEvent_001
+ * @tc.name     test deferred events are replayed against the new state within the same turn
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularStateMachineTest, DeferEvent_001, Function | MediumTest | Level1)
+{
+    std::vector<std::string> records;
+    auto handler = std::make_shared<StateMachineEventHandler>("DeferEvent_001");
+    auto waiting = std::make_shared<DeferReplayState>("Waiting", records);
+    auto ready = std::make_shared<DeferReplayState>("Ready", records);
+    std::shared_ptr<State> waitingState = waiting;
+    waiting->handler_ = handler;
+    waiting->nextState_ = ready;
+    waiting->deferEventId_ = CellularDataEventCode::MSG_SM_CONNECT;
+    waiting->transitionEventId_ = CellularDataEventCode::MSG_SM_DISCONNECT;
+    handler->SetOriginalState(waitingState);
+    auto initEvent = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_STATE_MACHINE_INIT);
+    handler->ProcessEvent(initEvent);
+    records.clear();
+
+    auto connectEvent = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
+    handler->ProcessEvent(connectEvent);
+    EXPECT_TRUE(records.empty());
+    EXPECT_EQ(handler->GetDeferStats().deferredCount, 1);
+
+    auto disconnectEvent = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_DISCONNECT);
+    handler->ProcessEvent(disconnectEvent);
+    EXPECT_EQ(handler->curState_, ready);
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0], "Ready " + std::to_string(CellularDataEventCode::MSG_SM_CONNECT));
+    EXPECT_EQ(handler->GetDeferStats().replayedCount, 1);
+    EXPECT_EQ(handler->deferEvents_.Size(), 0);
+}
+
+/**
+ * @tc.number   DeferEvent_002
+ * @tc.name     test events beyond the defer queue capacity are kept and re-posted after the transition
+ * @tc.desc     Function test
+ */
+HWTEST_F(CellularStateMachineTest, DeferEvent_002, Function | MediumTest | Level1)
+{
+    std::vector<std::string> records;
+    auto handler = std::make_shared<StateMachineEventHandler>("DeferEvent_002");
+    auto waiting = std::make_shared<DeferReplayState>("Waiting", records);
+    auto ready = std::make_shared<DeferReplayState>("Ready", records);
+    std::shared_ptr<State> waitingState = waiting;
+    waiting->handler_ = handler;
+    waiting->nextState_ = ready;
+    waiting->deferEventId_ = CellularDataEventCode::MSG_SM_CONNECT;
+    waiting->transitionEventId_ = CellularDataEventCode::MSG_SM_DISCONNECT;
+    handler->SetOriginalState(waitingState);
+    auto initEvent = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_STATE_MACHINE_INIT);
+    handler->ProcessEvent(initEvent);
+    records.clear();
+
+    for (size_t i = 0; i <= STATE_MACHINE_DEFER_EVENT_CAPACITY; i++) {
+        auto connectEvent = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
+        handler->ProcessEvent(connectEvent);
+    }
+    StateMachineDeferStats stats = handler->GetDeferStats();
+    EXPECT_EQ(stats.deferredCount, STATE_MACHINE_DEFER_EVENT_CAPACITY + 1);
+    EXPECT_EQ(stats.overflowCount, 1);
+    EXPECT_EQ(handler->deferEvents_.Size(), STATE_MACHINE_DEFER_EVENT_CAPACITY);
+    EXPECT_EQ(handler->overflowEvents_.size(), 1);
+
+    auto disconnectEvent = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_DISCONNECT);
+    handler->ProcessEvent(disconnectEvent);
+    EXPECT_EQ(records.size(), STATE_MACHINE_DEFER_EVENT_CAPACITY);
+    EXPECT_EQ(handler->deferEvents_.Size(), 0);
+    EXPECT_TRUE(handler->overflowEvents_.empty());
+}
 } // namespace Telephony
 } // namespace OHOS
\ No newline at end of file
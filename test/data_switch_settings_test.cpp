@@ -138,6 +138,20 @@ HWTEST_F(DataSwitchSettingTest, DataSwitchSetting_07, Function | MediumTest | Le
     ASSERT_TRUE(sets1.QueryAnySimDetectedStatus(simDetected) == TELEPHONY_ERR_SUCCESS);
 }
 
+HWTEST_F(DataSwitchSettingTest, DataSwitchSetting_08, Function | MediumTest | Level1)
+{
+    DataSwitchSettings sets(2);
+    ASSERT_EQ(sets.ResetUserDataSwitches(false), TELEPHONY_ERR_SUCCESS);
+
+    // The data switch is already on and no sim holds a roaming key, so nothing is written and the cache is kept.
+    DataSwitchSettings sets1(0);
+    sets1.userDataOn_ = true;
+    sets1.userDataOnCached_ = true;
+    EXPECT_CALL(*mockSimManager, GetSimId(_)).WillOnce(Return(0));
+    ASSERT_EQ(sets1.ResetUserDataSwitches(false), TELEPHONY_ERR_SUCCESS);
+    EXPECT_TRUE(sets1.userDataOnCached_);
+}
+
 static bool IsVirtualModemSlot(int32_t slotId)
 {
     return true;
@@ -161,5 +175,24 @@ HWTEST_F(DataSwitchSettingTest, DataSwitchSetting_08, Function | MediumTest | Le
     TELEPHONY_EXT_WRAPPER.isVirtualModemSlot_ = nullptr;
     TELEPHONY_EXT_WRAPPER.isDcCellularDataAllowed_ = nullptr;
 }
+HWTEST_F(DataSwitchSettingTest, DataSwitchSetting_09, Function | MediumTest | Level1)
+{
+    DataSwitchSettings sets(0);
+    sets.userDataOn_ = false;
+    sets.userDataOnCached_ = true;
+    bool dataEnabled = true;
+    EXPECT_EQ(sets.QueryUserDataStatus(dataEnabled), TELEPHONY_ERR_SUCCESS);
+    EXPECT_FALSE(dataEnabled);
+
+    uint32_t generation = sets.userDataOnGeneration_;
+    sets.InvalidateUserDataStatus();
+    EXPECT_FALSE(sets.userDataOnCached_);
+    EXPECT_NE(sets.userDataOnGeneration_, generation);
+
+    sets.userDataRoaming_ = true;
+    sets.userDataRoamingSimId_ = 1;
+    sets.InvalidateUserDataRoamingStatus();
+    EXPECT_EQ(sets.userDataRoamingSimId_, INVALID_SIM_ID);
+}
 }  // namespace Telephony
 }  // namespace OHOS
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define private public
+#define protected public
+
+#include <chrono>
+#include <cinttypes>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "cellular_data_state_machine.h"
+#include "data_connection_manager.h"
+#include "gtest/gtest.h"
+#include "shared_event_executor.h"
+#include "tel_event_handler.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+using namespace testing::ext;
+
+static constexpr int32_t EXECUTOR_SLOT_NUM = 2;
+static constexpr int32_t EXECUTOR_APN_TYPE_NUM = 10;
+static constexpr int32_t EXECUTOR_EVENTS_PER_HANDLER = 200;
+static constexpr int32_t EXECUTOR_ORDER_HANDLER_NUM = SHARED_EXECUTOR_THREAD_NUM + 1;
+static constexpr int32_t EXECUTOR_WAIT_RETRY = 500;
+static constexpr int32_t EXECUTOR_WAIT_STEP_MS = 10;
+// Handled by none of the states, so it only walks the state hierarchy.
+static constexpr uint32_t EXECUTOR_UNHANDLED_EVENT = CellularDataEventCode::BASE + 0xFFFF;
+
+class ExecutorOrderHandler : public AppExecFwk::EventHandler {
+public:
+    ExecutorOrderHandler()
+        : AppExecFwk::EventHandler(SharedEventExecutor::GetInstance().AcquireRunner())
+    {}
+
+    ~ExecutorOrderHandler()
+    {
+        SharedEventExecutor::GetInstance().ReleaseRunner(GetEventRunner());
+    }
+
+    void ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sequence_.push_back(event->GetParam());
+    }
+
+    std::vector<int64_t> GetSequence()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sequence_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int64_t> sequence_;
+};
+
+class ExecutorTestHandler : public TelEventHandler {
+public:
+    ExecutorTestHandler() : TelEventHandler("ExecutorTestHandler") {}
+    ~ExecutorTestHandler() = default;
+};
+
+struct ExecutorSlotHandlers {
+    std::shared_ptr<DataConnectionManager> connectionManager;
+    std::vector<std::shared_ptr<CellularDataStateMachine>> stateMachines;
+};
+
+class SharedEventExecutorTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        enabled_ = SharedEventExecutor::GetInstance().enabled_;
+        handler_ = std::make_shared<ExecutorTestHandler>();
+    }
+
+    void TearDown()
+    {
+        SharedEventExecutor::GetInstance().enabled_ = enabled_;
+        handler_ = nullptr;
+    }
+
+    static bool WaitUntil(const std::function<bool()> &done)
+    {
+        for (int32_t i = 0; i < EXECUTOR_WAIT_RETRY && !done(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(EXECUTOR_WAIT_STEP_MS));
+        }
+        return done();
+    }
+
+    std::vector<ExecutorSlotHandlers> CreateSlots()
+    {
+        std::vector<ExecutorSlotHandlers> slots(EXECUTOR_SLOT_NUM);
+        for (int32_t slotId = 0; slotId < EXECUTOR_SLOT_NUM; slotId++) {
+            slots[slotId].connectionManager = std::make_shared<DataConnectionManager>(slotId);
+            slots[slotId].connectionManager->Init();
+            for (int32_t i = 0; i < EXECUTOR_APN_TYPE_NUM; i++) {
+                auto stateMachine = std::make_shared<CellularDataStateMachine>(
+                    slots[slotId].connectionManager, std::static_pointer_cast<TelEventHandler>(handler_));
+                stateMachine->Init();
+                slots[slotId].stateMachines.push_back(stateMachine);
+            }
+        }
+        return slots;
+    }
+
+    // Sends the same burst to every state machine of both slots and reports the runners they use and event wait.
+    void RunReport(bool shared, size_t &runnerCount)
+    {
+        SharedEventExecutor &executor = SharedEventExecutor::GetInstance();
+        executor.enabled_ = shared;
+        std::vector<ExecutorSlotHandlers> slots = CreateSlots();
+        std::set<std::shared_ptr<AppExecFwk::EventRunner>> runners;
+        for (auto &slot : slots) {
+            for (auto &stateMachine : slot.stateMachines) {
+                ASSERT_TRUE(WaitUntil([&stateMachine]() { return stateMachine->GetCurrentState() != nullptr; }));
+                runners.insert(stateMachine->stateMachineEventHandler_->GetEventRunner());
+            }
+        }
+        runnerCount = runners.size();
+        executor.ResetStats();
+        uint64_t expected = 0;
+        for (int32_t i = 0; i < EXECUTOR_EVENTS_PER_HANDLER; i++) {
+            for (auto &slot : slots) {
+                for (auto &stateMachine : slot.stateMachines) {
+                    stateMachine->stateMachineEventHandler_->SendEvent(EXECUTOR_UNHANDLED_EVENT);
+                    expected++;
+                }
+            }
+        }
+        if (!shared) {
+            // The default mode records no wait, so there is nothing to wait for either.
+            EXPECT_EQ(executor.GetStats().eventCount, 0);
+            return;
+        }
+        EXPECT_TRUE(WaitUntil([&executor, expected]() { return executor.GetStats().eventCount >= expected; }));
+        SharedExecutorStats stats = executor.GetStats();
+        int64_t avgWaitUs = stats.eventCount > 0 ? stats.totalWaitUs / static_cast<int64_t>(stats.eventCount) : 0;
+        TELEPHONY_LOGI("slots=%{public}d apnTypes=%{public}d handlers=%{public}u runners=%{public}zu "
+            "events=%{public}" PRIu64 " avgWaitUs=%{public}" PRId64 " maxWaitUs=%{public}" PRId64,
+            EXECUTOR_SLOT_NUM, EXECUTOR_APN_TYPE_NUM, stats.handlerCount, runnerCount, stats.eventCount,
+            avgWaitUs, stats.maxWaitUs);
+        EXPECT_GE(stats.eventCount, expected);
+        EXPECT_LE(stats.sharedRunnerCount, static_cast<uint32_t>(SHARED_EXECUTOR_THREAD_NUM));
+    }
+
+    bool enabled_ = false;
+    std::shared_ptr<ExecutorTestHandler> handler_;
+};
+
+/**
+ * @tc.number   SharedEventExecutor_001
+ * @tc.name     test handlers sharing a runner keep the order of their own events
+ * @tc.desc     Function test
+ */
+HWTEST_F(SharedEventExecutorTest, SharedEventExecutor_001, Function | MediumTest | Level1)
+{
+    SharedEventExecutor &executor = SharedEventExecutor::GetInstance();
+    executor.enabled_ = true;
+    uint32_t handlerCount = executor.GetStats().handlerCount;
+    std::vector<std::shared_ptr<ExecutorOrderHandler>> handlers;
+    for (int32_t i = 0; i < EXECUTOR_ORDER_HANDLER_NUM; i++) {
+        handlers.push_back(std::make_shared<ExecutorOrderHandler>());
+    }
+    // More handlers than runners, at least two of them share one.
+    EXPECT_EQ(handlers[0]->GetEventRunner(), handlers[SHARED_EXECUTOR_THREAD_NUM]->GetEventRunner());
+    for (int64_t i = 0; i < EXECUTOR_EVENTS_PER_HANDLER; i++) {
+        for (auto &handler : handlers) {
+            handler->SendEvent(EXECUTOR_UNHANDLED_EVENT, i);
+        }
+    }
+    for (auto &handler : handlers) {
+        ASSERT_TRUE(WaitUntil([&handler]() {
+            return handler->GetSequence().size() == static_cast<size_t>(EXECUTOR_EVENTS_PER_HANDLER);
+        }));
+        std::vector<int64_t> sequence = handler->GetSequence();
+        for (int64_t i = 0; i < EXECUTOR_EVENTS_PER_HANDLER; i++) {
+            EXPECT_EQ(sequence[i], i);
+        }
+    }
+    EXPECT_EQ(executor.GetStats().handlerCount, handlerCount + EXECUTOR_ORDER_HANDLER_NUM);
+    handlers.clear();
+    EXPECT_EQ(executor.GetStats().handlerCount, handlerCount);
+    for (uint32_t load : executor.runnerLoads_) {
+        EXPECT_EQ(load, 0);
+    }
+}
+
+/**
+ * @tc.number   SharedEventExecutor_002
+ * @tc.name     test two slots with ten apn types keep a runner each by default and share a few once enabled
+ * @tc.desc     Function test
+ */
+HWTEST_F(SharedEventExecutorTest, SharedEventExecutor_002, Function | MediumTest | Level2)
+{
+    size_t ownRunners = 0;
+    size_t sharedRunners = 0;
+    RunReport(false, ownRunners);
+    RunReport(true, sharedRunners);
+    EXPECT_EQ(ownRunners, static_cast<size_t>(EXECUTOR_SLOT_NUM * EXECUTOR_APN_TYPE_NUM));
+    EXPECT_LE(sharedRunners, static_cast<size_t>(SHARED_EXECUTOR_THREAD_NUM));
+}
+
+/**
+ * @tc.number   SharedEventExecutor_003
+ * @tc.name     test a disabled executor hands out no runner and keeps no handler
+ * @tc.desc     Function test
+ */
+HWTEST_F(SharedEventExecutorTest, SharedEventExecutor_003, Function | MediumTest | Level1)
+{
+    SharedEventExecutor &executor = SharedEventExecutor::GetInstance();
+    executor.enabled_ = false;
+    uint32_t handlerCount = executor.GetStats().handlerCount;
+    EXPECT_EQ(executor.AcquireRunner(), nullptr);
+    auto handler = std::make_shared<StateMachineEventHandler>("ExecutorDisabledHandler");
+    EXPECT_EQ(handler->sharedRunner_, nullptr);
+    EXPECT_NE(handler->GetEventRunner(), nullptr);
+    EXPECT_EQ(executor.GetStats().handlerCount, handlerCount);
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cellular_data_constant.h"
+#include "gtest/gtest.h"
+#include "stall_detection_scheduler.h"
+#include "stall_detection_simulator.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+using namespace testing::ext;
+
+static constexpr int64_t TRACE_STEP_MS = 1000;
+static constexpr int64_t STALL_START_MS = 61 * 1000;
+static constexpr int64_t STALL_TRACE_DURATION_MS = 100 * 1000;
+static constexpr int64_t IDLE_TRACE_DURATION_MS = 600 * 1000;
+static constexpr int64_t SCREEN_OFF_TRACE_DURATION_MS = 1800 * 1000;
+static constexpr int64_t SCREEN_OFF_DEGRADE_DIVISOR = 4;
+
+class StallDetectionSchedulerTest : public testing::Test {
+public:
+    static StallTrace MakeStallTrace(int32_t slotId)
+    {
+        StallTrace trace;
+        trace.slotId = slotId;
+        trace.screenOn = true;
+        trace.stallStartMs = STALL_START_MS;
+        int64_t rxPackets = 0;
+        for (int64_t timeMs = 0; timeMs <= STALL_TRACE_DURATION_MS; timeMs += TRACE_STEP_MS) {
+            if (timeMs <= STALL_START_MS) {
+                rxPackets = timeMs / TRACE_STEP_MS;
+            }
+            trace.samples.push_back({ timeMs, timeMs / TRACE_STEP_MS, rxPackets });
+        }
+        return trace;
+    }
+
+    static StallTrace MakeScreenOffTrafficTrace(int32_t slotId, bool degrading)
+    {
+        StallTrace trace;
+        trace.slotId = slotId;
+        trace.screenOn = false;
+        for (int64_t timeMs = 0; timeMs <= SCREEN_OFF_TRACE_DURATION_MS; timeMs += TRACE_STEP_MS) {
+            int64_t txPackets = timeMs / TRACE_STEP_MS;
+            int64_t rxPackets = degrading ? txPackets / SCREEN_OFF_DEGRADE_DIVISOR : txPackets;
+            trace.samples.push_back({ timeMs, txPackets, rxPackets });
+        }
+        return trace;
+    }
+
+    static StallTrace MakeIdleTrace(int32_t slotId)
+    {
+        StallTrace trace;
+        trace.slotId = slotId;
+        trace.screenOn = true;
+        trace.samples.push_back({ 0, 0, 0 });
+        return trace;
+    }
+};
+
+/**
+ * @tc.number   StallDetectionPolicy_001
+ * @tc.name     test the period follows the traffic
+ * @tc.desc     Function test
+ */
+HWTEST_F(StallDetectionSchedulerTest, StallDetectionPolicy_001, Function | MediumTest | Level1)
+{
+    StallDetectionPolicy policy;
+    EXPECT_EQ(policy.Reset(DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT),
+        DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    StallDetectionSample sample;
+    sample.screenOn = true;
+    sample.sentPackets = 10;
+    sample.recvPackets = 10;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    sample.recvPackets = 1;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT / 2);
+    sample.recvPackets = 0;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_MIN_DELAY_IN_MS);
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_MIN_DELAY_IN_MS);
+    sample.aggressiveRecovery = true;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    sample.aggressiveRecovery = false;
+    sample.sentPackets = 0;
+    int32_t periodMs = DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+    while (periodMs < DATA_STALL_ALARM_IDLE_MAX_DELAY_IN_MS) {
+        int32_t nextPeriodMs = policy.NextPeriod(sample);
+        EXPECT_GT(nextPeriodMs, periodMs);
+        periodMs = nextPeriodMs;
+    }
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_IDLE_MAX_DELAY_IN_MS);
+    sample.screenOn = false;
+    policy.Reset(DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    sample.sentPackets = 10;
+    sample.recvPackets = 10;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    sample.recvPackets = 0;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+    sample.aggressiveRecovery = true;
+    EXPECT_EQ(policy.NextPeriod(sample), DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT);
+}
+
+/**
+ * @tc.number   StallDetectionTimerQueue_001
+ * @tc.name     test nearly due ticks join an earlier wakeup
+ * @tc.desc     Function test
+ */
+HWTEST_F(StallDetectionSchedulerTest, StallDetectionTimerQueue_001, Function | MediumTest | Level1)
+{
+    StallDetectionTimerQueue queue;
+    EXPECT_EQ(queue.GetNextFireTime(), -1);
+    queue.Schedule(0, 0, 10000);
+    queue.Schedule(1, 1000, 10000);
+    queue.Schedule(2, 0, 60000);
+    EXPECT_EQ(queue.GetNextFireTime(), 10000);
+    std::vector<int32_t> dueSlots = queue.PopDue(10000);
+    ASSERT_EQ(dueSlots.size(), 2u);
+    EXPECT_EQ(dueSlots[0], 0);
+    EXPECT_EQ(dueSlots[1], 1);
+    EXPECT_TRUE(queue.IsScheduled(2));
+    queue.Cancel(2);
+    EXPECT_EQ(queue.GetNextFireTime(), -1);
+}
+
+/**
+ * @tc.number   StallDetectionSimulator_001
+ * @tc.name     test a slow stall is detected sooner than with the fixed period
+ * @tc.desc     Function test
+ */
+HWTEST_F(StallDetectionSchedulerTest, StallDetectionSimulator_001, Function | MediumTest | Level1)
+{
+    StallDetectionSimulator fixed(false);
+    StallDetectionSimulator adaptive(true);
+    fixed.AddTrace(MakeStallTrace(0));
+    adaptive.AddTrace(MakeStallTrace(0));
+    StallSimulationResult fixedResult = fixed.Run(STALL_TRACE_DURATION_MS);
+    StallSimulationResult adaptiveResult = adaptive.Run(STALL_TRACE_DURATION_MS);
+    TELEPHONY_LOGI("detection latency fixed=%{public}lldms adaptive=%{public}lldms",
+        static_cast<long long>(fixedResult.detectionLatencyMs[0]),
+        static_cast<long long>(adaptiveResult.detectionLatencyMs[0]));
+    ASSERT_GE(fixedResult.detectionLatencyMs[0], 0);
+    ASSERT_GE(adaptiveResult.detectionLatencyMs[0], 0);
+    EXPECT_LT(adaptiveResult.detectionLatencyMs[0], fixedResult.detectionLatencyMs[0]);
+}
+
+/**
+ * @tc.number   StallDetectionSimulator_002
+ * @tc.name     test idle slots back off and share their wakeups
+ * @tc.desc     Function test
+ */
+HWTEST_F(StallDetectionSchedulerTest, StallDetectionSimulator_002, Function | MediumTest | Level1)
+{
+    StallDetectionSimulator fixed(false);
+    StallDetectionSimulator adaptive(true);
+    for (int32_t slotId = 0; slotId < CELLDATA_SLOT_ID_2; slotId++) {
+        fixed.AddTrace(MakeIdleTrace(slotId));
+        adaptive.AddTrace(MakeIdleTrace(slotId));
+    }
+    StallSimulationResult fixedResult = fixed.Run(IDLE_TRACE_DURATION_MS);
+    StallSimulationResult adaptiveResult = adaptive.Run(IDLE_TRACE_DURATION_MS);
+    TELEPHONY_LOGI("wakeups fixed=%{public}llu adaptive=%{public}llu adaptive ticks=%{public}llu",
+        static_cast<unsigned long long>(fixedResult.wakeups), static_cast<unsigned long long>(adaptiveResult.wakeups),
+        static_cast<unsigned long long>(adaptiveResult.ticks));
+    EXPECT_LT(adaptiveResult.wakeups, fixedResult.wakeups);
+    EXPECT_LT(adaptiveResult.wakeups, adaptiveResult.ticks);
+}
+
+/**
+ * @tc.number   StallDetectionSimulator_003
+ * @tc.name     test background traffic with the screen off keeps the screen off period
+ * @tc.desc     Function test
+ */
+HWTEST_F(StallDetectionSchedulerTest, StallDetectionSimulator_003, Function | MediumTest | Level1)
+{
+    StallDetectionSimulator fixed(false);
+    StallDetectionSimulator adaptive(true);
+    fixed.AddTrace(MakeScreenOffTrafficTrace(0, false));
+    adaptive.AddTrace(MakeScreenOffTrafficTrace(0, false));
+    fixed.AddTrace(MakeScreenOffTrafficTrace(1, true));
+    adaptive.AddTrace(MakeScreenOffTrafficTrace(1, true));
+    StallSimulationResult fixedResult = fixed.Run(SCREEN_OFF_TRACE_DURATION_MS);
+    StallSimulationResult adaptiveResult = adaptive.Run(SCREEN_OFF_TRACE_DURATION_MS);
+    EXPECT_EQ(adaptiveResult.ticks, fixedResult.ticks);
+    EXPECT_LE(adaptiveResult.wakeups, fixedResult.wakeups);
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stall_detection_simulator.h"
+
+#include "cellular_data_constant.h"
+#include "stall_detection_scheduler.h"
+
+namespace OHOS {
+namespace Telephony {
+struct StallDetectionSimulator::SlotState {
+    const StallTrace *trace = nullptr;
+    StallDetectionPolicy policy;
+    int64_t lastTxPackets = 0;
+    int64_t lastRxPackets = 0;
+    int64_t noRecvPackets = 0;
+    int64_t nextTickMs = 0;
+};
+
+StallDetectionSimulator::StallDetectionSimulator(bool adaptive) : adaptive_(adaptive) {}
+
+void StallDetectionSimulator::AddTrace(const StallTrace &trace)
+{
+    traces_.push_back(trace);
+}
+
+void StallDetectionSimulator::GetCounters(
+    const StallTrace &trace, int64_t timeMs, int64_t &txPackets, int64_t &rxPackets)
+{
+    for (const PacketCounterSample &sample : trace.samples) {
+        if (sample.timeMs > timeMs) {
+            break;
+        }
+        txPackets = sample.txPackets;
+        rxPackets = sample.rxPackets;
+    }
+}
+
+int32_t StallDetectionSimulator::Tick(SlotState &state, int64_t nowMs, StallSimulationResult &result)
+{
+    result.ticks++;
+    int64_t txPackets = state.lastTxPackets;
+    int64_t rxPackets = state.lastRxPackets;
+    GetCounters(*state.trace, nowMs, txPackets, rxPackets);
+    StallDetectionSample sample;
+    sample.sentPackets = txPackets - state.lastTxPackets;
+    sample.recvPackets = rxPackets - state.lastRxPackets;
+    sample.screenOn = state.trace->screenOn;
+    state.lastTxPackets = txPackets;
+    state.lastRxPackets = rxPackets;
+    if (sample.sentPackets > 0 && sample.recvPackets == 0) {
+        state.noRecvPackets += sample.sentPackets;
+    } else if (sample.recvPackets > 0) {
+        state.noRecvPackets = 0;
+    }
+    int32_t slotId = state.trace->slotId;
+    if (state.noRecvPackets > RECOVERY_TRIGGER_PACKET && state.trace->stallStartMs >= 0 &&
+        nowMs >= state.trace->stallStartMs && result.detectionLatencyMs[slotId] < 0) {
+        result.detectionLatencyMs[slotId] = nowMs - state.trace->stallStartMs;
+    }
+    if (adaptive_) {
+        return state.policy.NextPeriod(sample);
+    }
+    return state.trace->screenOn ? DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT :
+        DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+}
+
+StallSimulationResult StallDetectionSimulator::Run(int64_t durationMs)
+{
+    return adaptive_ ? RunAdaptive(durationMs) : RunFixed(durationMs);
+}
+
+StallSimulationResult StallDetectionSimulator::RunAdaptive(int64_t durationMs)
+{
+    StallSimulationResult result;
+    std::map<int32_t, SlotState> states;
+    StallDetectionTimerQueue queue;
+    for (const StallTrace &trace : traces_) {
+        SlotState &state = states[trace.slotId];
+        state.trace = &trace;
+        GetCounters(trace, 0, state.lastTxPackets, state.lastRxPackets);
+        result.detectionLatencyMs[trace.slotId] = -1;
+        int32_t basePeriodMs = trace.screenOn ? DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT :
+            DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+        queue.Schedule(trace.slotId, 0, state.policy.Reset(basePeriodMs));
+    }
+    for (int64_t nowMs = queue.GetNextFireTime(); nowMs >= 0 && nowMs <= durationMs;
+        nowMs = queue.GetNextFireTime()) {
+        result.wakeups++;
+        for (int32_t slotId : queue.PopDue(nowMs)) {
+            queue.Schedule(slotId, nowMs, Tick(states[slotId], nowMs, result));
+        }
+    }
+    return result;
+}
+
+StallSimulationResult StallDetectionSimulator::RunFixed(int64_t durationMs)
+{
+    StallSimulationResult result;
+    for (const StallTrace &trace : traces_) {
+        SlotState state;
+        state.trace = &trace;
+        GetCounters(trace, 0, state.lastTxPackets, state.lastRxPackets);
+        result.detectionLatencyMs[trace.slotId] = -1;
+        state.nextTickMs = trace.screenOn ? DATA_STALL_ALARM_AGGRESSIVE_DELAY_IN_MS_DEFAULT :
+            DATA_STALL_ALARM_NON_AGGRESSIVE_DELAY_IN_MS_DEFAULT;
+        while (state.nextTickMs <= durationMs) {
+            // Every slot arms its own timer, so each tick is a wakeup of its own.
+            result.wakeups++;
+            state.nextTickMs += Tick(state, state.nextTickMs, result);
+        }
+    }
+    return result;
+}
+} // namespace Telephony
+} // namespace OHOS
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STALL_DETECTION_SIMULATOR_H
+#define STALL_DETECTION_SIMULATOR_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace OHOS {
+namespace Telephony {
+/**
+ * Cumulative packet counters of an interface at a point of the trace
+ */
+struct PacketCounterSample {
+    int64_t timeMs = 0;
+    int64_t txPackets = 0;
+    int64_t rxPackets = 0;
+};
+
+struct StallTrace {
+    int32_t slotId = 0;
+    bool screenOn = true;
+    int64_t stallStartMs = -1;
+    std::vector<PacketCounterSample> samples;
+};
+
+struct StallSimulationResult {
+    uint64_t wakeups = 0;
+    uint64_t ticks = 0;
+    std::map<int32_t, int64_t> detectionLatencyMs;
+};
+
+/**
+ * Replays packet counter traces through the stall detection in virtual time
+ *
+ * The adaptive mode runs StallDetectionPolicy on the shared StallDetectionTimerQueue. The fixed mode ticks every
+ * slot on its own timer with the aggressive or non-aggressive period, as the monitor did before. A stall counts as
+ * detected at the first tick after its start which brings the unanswered packets over RECOVERY_TRIGGER_PACKET.
+ */
+class StallDetectionSimulator {
+public:
+    explicit StallDetectionSimulator(bool adaptive);
+    void AddTrace(const StallTrace &trace);
+    StallSimulationResult Run(int64_t durationMs);
+
+private:
+    struct SlotState;
+    static void GetCounters(const StallTrace &trace, int64_t timeMs, int64_t &txPackets, int64_t &rxPackets);
+    int32_t Tick(SlotState &state, int64_t nowMs, StallSimulationResult &result);
+    StallSimulationResult RunAdaptive(int64_t durationMs);
+    StallSimulationResult RunFixed(int64_t durationMs);
+
+private:
+    bool adaptive_ = false;
+    std::vector<StallTrace> traces_;
+};
+} // namespace Telephony
+} // namespace OHOS
+#endif // STALL_DETECTION_SIMULATOR_H
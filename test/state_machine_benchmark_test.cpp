@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define private public
+#define protected public
+
+#include <chrono>
+#include <cinttypes>
+#include <functional>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "activating.h"
+#include "cellular_data_handler.h"
+#include "cellular_data_state_machine.h"
+#include "data_connection_manager.h"
+#include "default.h"
+#include "disconnecting.h"
+#include "gtest/gtest.h"
+#include "tel_event_handler.h"
+#include "telephony_log_wrapper.h"
+
+namespace OHOS {
+namespace Telephony {
+using namespace testing::ext;
+
+static constexpr int32_t BENCHMARK_EVENT_COUNT = 200000;
+static constexpr int32_t BENCHMARK_TRANSITION_COUNT = 20000;
+static constexpr int32_t BENCHMARK_INIT_WAIT_RETRY = 100;
+static constexpr int32_t BENCHMARK_INIT_WAIT_STEP_MS = 10;
+static constexpr int32_t BENCHMARK_DISPATCH_ROUNDS = 20000;
+// Replays every CellularDataEventCode id plus a tail of ids that no handler owns.
+static constexpr uint32_t BENCHMARK_EVENT_CODE_SPAN = 80;
+// Handled by none of the states, so every dispatch walks the whole parent chain.
+static constexpr uint32_t BENCHMARK_UNHANDLED_EVENT = CellularDataEventCode::BASE + 0xFFFF;
+
+class StateMachineBenchmarkHandler : public TelEventHandler {
+public:
+    StateMachineBenchmarkHandler() : TelEventHandler("StateMachineBenchmarkHandler") {}
+    ~StateMachineBenchmarkHandler() = default;
+
+    std::shared_ptr<CellularDataStateMachine> CreateStateMachine(int32_t slotId)
+    {
+        auto connectionManager = std::make_shared<DataConnectionManager>(slotId);
+        connectionManager->Init();
+        auto stateMachine = std::make_shared<CellularDataStateMachine>(
+            connectionManager, std::static_pointer_cast<TelEventHandler>(shared_from_this()));
+        stateMachine->Init();
+        // Init() enters the original state asynchronously, let it settle before driving the handler directly.
+        for (int32_t i = 0; i < BENCHMARK_INIT_WAIT_RETRY && stateMachine->GetCurrentState() == nullptr; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(BENCHMARK_INIT_WAIT_STEP_MS));
+        }
+        return stateMachine;
+    }
+};
+
+class StateMachineBenchmarkTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        handler_ = std::make_shared<StateMachineBenchmarkHandler>();
+        stateMachine_ = handler_->CreateStateMachine(0);
+        ASSERT_NE(stateMachine_, nullptr);
+        ASSERT_NE(stateMachine_->stateMachineEventHandler_, nullptr);
+        auto event = AppExecFwk::InnerEvent::Get(CellularDataEventCode::MSG_SM_CONNECT);
+        stateMachine_->TransitionTo(stateMachine_->activatingState_);
+        stateMachine_->stateMachineEventHandler_->ProcessTransitions(event);
+    }
+
+    void TearDown()
+    {
+        stateMachine_ = nullptr;
+        handler_ = nullptr;
+    }
+
+    static double PerSecond(int32_t count, std::chrono::steady_clock::time_point begin)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return seconds > 0 ? count / seconds : 0;
+    }
+
+    std::shared_ptr<StateMachineBenchmarkHandler> handler_;
+    std::shared_ptr<CellularDataStateMachine> stateMachine_;
+};
+
+/**
+ * @tc.number   StateEventTable_001
+ * @tc.name     test the dispatch table finds handlers and falls through to the parent
+ * @tc.desc     Function test
+ */
+HWTEST_F(StateMachineBenchmarkTest, StateEventTable_001, Function | MediumTest | Level1)
+{
+    auto mDefault = std::static_pointer_cast<Default>(stateMachine_->defaultState_);
+    EXPECT_NE(mDefault->eventTable_.find(CellularDataEventCode::MSG_SM_CONNECT), mDefault->eventTable_.end());
+    EXPECT_EQ(mDefault->eventTable_.find(BENCHMARK_UNHANDLED_EVENT), mDefault->eventTable_.end());
+    EXPECT_EQ(stateMachine_->activatingState_->parentState_, stateMachine_->defaultState_.get());
+    auto event = AppExecFwk::InnerEvent::Get(BENCHMARK_UNHANDLED_EVENT);
+    stateMachine_->stateMachineEventHandler_->ProcessMsg(event);
+    EXPECT_EQ(stateMachine_->GetCurrentState(), stateMachine_->activatingState_);
+}
+
+/**
+ * @tc.number   StateMachineBenchmark_001
+ * @tc.name     measure events dispatched per second through the state hierarchy
+ * @tc.desc     Performance test
+ */
+HWTEST_F(StateMachineBenchmarkTest, StateMachineBenchmark_001, Function | MediumTest | Level2)
+{
+    auto handler = stateMachine_->stateMachineEventHandler_;
+    auto event = AppExecFwk::InnerEvent::Get(BENCHMARK_UNHANDLED_EVENT);
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < BENCHMARK_EVENT_COUNT; i++) {
+        handler->ProcessMsg(event);
+    }
+    double eventsPerSecond = PerSecond(BENCHMARK_EVENT_COUNT, begin);
+    TELEPHONY_LOGI("CellularDataStateMachine events/sec=%{public}" PRId64, static_cast<int64_t>(eventsPerSecond));
+    EXPECT_GT(eventsPerSecond, 0);
+}
+
+/**
+ * @tc.number   HandlerDispatchBenchmark_001
+ * @tc.name     compare the CellularDataHandler sorted table lookup with the former std::map dispatch
+ * @tc.desc     Performance test
+ */
+HWTEST_F(StateMachineBenchmarkTest, HandlerDispatchBenchmark_001, Function | MediumTest | Level2)
+{
+    using Fun = std::function<void(const AppExecFwk::InnerEvent::Pointer &event)>;
+    std::vector<uint32_t> eventIds = { RadioEvent::RADIO_PS_CONNECTION_ATTACHED, RadioEvent::RADIO_PS_ROAMING_OPEN,
+        RadioEvent::RADIO_PS_ROAMING_CLOSE, RadioEvent::RADIO_EMERGENCY_STATE_OPEN,
+        RadioEvent::RADIO_EMERGENCY_STATE_CLOSE, RadioEvent::RADIO_STATE_CHANGED, RadioEvent::RADIO_DSDS_MODE_CHANGED,
+        RadioEvent::RADIO_SIM_STATE_CHANGE, RadioEvent::RADIO_SIM_RECORDS_LOADED, RadioEvent::RADIO_SIM_ACCOUNT_LOADED,
+        RadioEvent::RADIO_PS_RAT_CHANGED, RadioEvent::RADIO_NR_STATE_CHANGED, RadioEvent::RADIO_NR_FREQUENCY_CHANGED,
+        RadioEvent::RADIO_RIL_ADAPTER_HOST_DIED, RadioEvent::RADIO_FACTORY_RESET,
+        RadioEvent::RADIO_CLEAN_ALL_DATA_CONNECTIONS, RadioEvent::RADIO_NV_REFRESH_FINISHED,
+        RadioEvent::RADIO_RESIDENT_NETWORK_CHANGE };
+    for (uint32_t i = 0; i < BENCHMARK_EVENT_CODE_SPAN; i++) {
+        eventIds.push_back(static_cast<uint32_t>(CellularDataEventCode::BASE) + i);
+    }
+    // The former handler kept one std::function per owned id in a per-instance std::map.
+    std::map<uint32_t, Fun> eventIdMap;
+    for (uint32_t eventId : eventIds) {
+        auto fun = CellularDataHandler::FindEventFun(eventId);
+        if (fun != nullptr) {
+            eventIdMap[eventId] = [](const AppExecFwk::InnerEvent::Pointer &event) {};
+        }
+    }
+    ASSERT_FALSE(eventIdMap.empty());
+    for (uint32_t eventId : eventIds) {
+        EXPECT_EQ(CellularDataHandler::FindEventFun(eventId) != nullptr, eventIdMap.count(eventId) != 0);
+    }
+
+    int64_t mapHits = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < BENCHMARK_DISPATCH_ROUNDS; round++) {
+        for (uint32_t eventId : eventIds) {
+            mapHits += (eventIdMap.find(eventId) != eventIdMap.end()) ? 1 : 0;
+        }
+    }
+    int32_t lookups = BENCHMARK_DISPATCH_ROUNDS * static_cast<int32_t>(eventIds.size());
+    double mapLookupsPerSecond = PerSecond(lookups, begin);
+
+    int64_t tableHits = 0;
+    begin = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < BENCHMARK_DISPATCH_ROUNDS; round++) {
+        for (uint32_t eventId : eventIds) {
+            tableHits += (CellularDataHandler::FindEventFun(eventId) != nullptr) ? 1 : 0;
+        }
+    }
+    double tableLookupsPerSecond = PerSecond(lookups, begin);
+    TELEPHONY_LOGI("CellularDataHandler dispatch lookups/sec map=%{public}" PRId64 " table=%{public}" PRId64,
+        static_cast<int64_t>(mapLookupsPerSecond), static_cast<int64_t>(tableLookupsPerSecond));
+    EXPECT_EQ(mapHits, tableHits);
+    EXPECT_GT(mapLookupsPerSecond, 0);
+    EXPECT_GT(tableLookupsPerSecond, 0);
+}
+
+/**
+ * @tc.number   StateMachineBenchmark_002
+ * @tc.name     measure transitions per second between two sibling states
+ * @tc.desc     Performance test
+ */
+HWTEST_F(StateMachineBenchmarkTest, StateMachineBenchmark_002, Function | MediumTest | Level2)
+{
+    auto handler = stateMachine_->stateMachineEventHandler_;
+    auto event = AppExecFwk::InnerEvent::Get(BENCHMARK_UNHANDLED_EVENT);
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < BENCHMARK_TRANSITION_COUNT; i++) {
+        stateMachine_->TransitionTo((i % 2 == 0) ? stateMachine_->disconnectingState_ :
+            stateMachine_->activatingState_);
+        handler->ProcessTransitions(event);
+    }
+    double transitionsPerSecond = PerSecond(BENCHMARK_TRANSITION_COUNT, begin);
+    TELEPHONY_LOGI("CellularDataStateMachine transitions/sec=%{public}" PRId64,
+        static_cast<int64_t>(transitionsPerSecond));
+    EXPECT_EQ(stateMachine_->GetCurrentState(), stateMachine_->activatingState_);
+    EXPECT_GT(transitionsPerSecond, 0);
+}
+} // namespace Telephony
+} // namespace OHOS
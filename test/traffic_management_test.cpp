@@ -16,9 +16,13 @@
 #define private public
 #define protected public
 
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+
 #include "mock/mock_net_conn_service.h"
 #include "mock/mock_sim_manager.h"
 #include "traffic_management.h"
+#include "cellular_data_net_agent.h"
 #include "core_manager_inner.h"
 #include "net_manager_constants.h"
 #include "net_conn_client.h"
@@ -38,6 +42,7 @@ public:
     TrafficManagementTest()
     {
         trafficManagement = new TrafficManagement(0);
+        CellularDataNetAgent::GetInstance().InvalidateCellIface(0);
 
         mockSimManager = new MockSimManager();
         std::shared_ptr<MockSimManager> mockSimManagerPtr(mockSimManager);
@@ -139,24 +144,72 @@ HWTEST_F(TrafficManagementTest, TrafficManagementTest_004, Function | MediumTest
     std::cout << "TrafficManagementTest_003 ifaceName: " << ifaceName << std::endl;
     ASSERT_EQ(ifaceName, "mock_ifaceName");
 
-    // update data
-    EXPECT_CALL(*mockSimManager, GetSimId(_)).WillOnce(Return(0));
-    EXPECT_CALL(*mockNetConnService, GetNetIdByIdentifier(_, _))
-        .WillOnce(DoAll(SetArgReferee<1>(netIdList), Return(0)));
-    EXPECT_CALL(*mockNetConnService, GetAllNets(_)).WillOnce(DoAll(SetArgReferee<0>(netAllIds), Return(0)));
-    EXPECT_CALL(*mockNetConnService, GetConnectionProperties(_, _))
-        .WillOnce([](int32_t netId, NetManagerStandard::NetLinkInfo &info) {
-            info.ifaceName_ = "mock_ifaceName";
-            return 0;
-        });
+    // update data with the cached interface, the missing interface drops the cache
+    EXPECT_CALL(*mockNetConnService, GetConnectionProperties(_, _)).Times(0);
     trafficManagement->sendPackets_ = 100;
     trafficManagement->recvPackets_ = 200;
     trafficManagement->UpdatePacketData();
     EXPECT_LE(trafficManagement->sendPackets_, 0);
     EXPECT_LE(trafficManagement->recvPackets_, 0);
+    int32_t netId = -1;
+    EXPECT_FALSE(CellularDataNetAgent::GetInstance().GetCachedCellIface(0, netId, ifaceName));
 
     Mock::VerifyAndClearExpectations(mockSimManager);
 }
 
+HWTEST_F(TrafficManagementTest, TrafficManagementTest_005, Function | MediumTest | Level1)
+{
+    int64_t value = -1;
+    EXPECT_EQ(TrafficManagement::ReadIfaceCounter("lo", "rx_packets", value), 0);
+    EXPECT_GE(value, 0);
+    EXPECT_EQ(TrafficManagement::ReadIfaceCounter("mock_ifaceName", "rx_packets", value), ENOENT);
+    std::string longName(128, 'a');
+    EXPECT_EQ(TrafficManagement::ReadIfaceCounter(longName, "rx_packets", value), EINVAL);
+}
+
+HWTEST_F(TrafficManagementTest, TrafficManagementTest_006, Function | MediumTest | Level1)
+{
+    const uint32_t seq = 7;
+    const int32_t ifindex = 3;
+    std::vector<uint8_t> buffer(NLMSG_SPACE(sizeof(struct if_stats_msg)) +
+        RTA_SPACE(sizeof(struct rtnl_link_stats64)) + NLMSG_SPACE(sizeof(int32_t)), 0);
+    struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer.data());
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(struct if_stats_msg)) + RTA_SPACE(sizeof(struct rtnl_link_stats64));
+    header->nlmsg_type = RTM_NEWSTATS;
+    header->nlmsg_seq = seq;
+    struct if_stats_msg *body = static_cast<struct if_stats_msg *>(NLMSG_DATA(header));
+    body->ifindex = ifindex;
+    struct rtattr *attr = reinterpret_cast<struct rtattr *>(
+        reinterpret_cast<uint8_t *>(body) + NLMSG_ALIGN(sizeof(struct if_stats_msg)));
+    attr->rta_type = IFLA_STATS_LINK_64;
+    attr->rta_len = RTA_LENGTH(sizeof(struct rtnl_link_stats64));
+    struct rtnl_link_stats64 *linkStats = static_cast<struct rtnl_link_stats64 *>(RTA_DATA(attr));
+    linkStats->tx_packets = 10;
+    linkStats->rx_packets = 20;
+    linkStats->tx_bytes = 1000;
+    linkStats->rx_bytes = 2000;
+    struct nlmsghdr *done = reinterpret_cast<struct nlmsghdr *>(buffer.data() + NLMSG_ALIGN(header->nlmsg_len));
+    done->nlmsg_len = NLMSG_LENGTH(sizeof(int32_t));
+    done->nlmsg_type = NLMSG_DONE;
+    done->nlmsg_seq = seq;
+
+    std::map<int32_t, LinkStats> stats;
+    bool finished = false;
+    EXPECT_EQ(LinkStatsReader::ParseDump(buffer.data(), buffer.size(), seq + 1, stats, finished), 0);
+    EXPECT_TRUE(stats.empty());
+    EXPECT_FALSE(finished);
+    EXPECT_EQ(LinkStatsReader::ParseDump(buffer.data(), buffer.size(), seq, stats, finished), 0);
+    EXPECT_TRUE(finished);
+    ASSERT_EQ(stats.count(ifindex), 1u);
+    EXPECT_EQ(stats[ifindex].txPackets, 10);
+    EXPECT_EQ(stats[ifindex].rxPackets, 20);
+    EXPECT_EQ(stats[ifindex].txBytes, 1000);
+    EXPECT_EQ(stats[ifindex].rxBytes, 2000);
+
+    std::vector<std::shared_ptr<CellularDataStateMachine>> connections = { nullptr };
+    trafficManagement->UpdateConnectionTraffic(connections);
+    EXPECT_TRUE(trafficManagement->GetConnectionTraffic().empty());
+}
+
 }  // namespace Telephony
 }  // namespace OHOS
\ No newline at end of file